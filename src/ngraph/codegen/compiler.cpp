@@ -109,6 +109,7 @@ std::unique_ptr<llvm::Module> codegen::Module::take_module()
 
 codegen::Compiler::Compiler()
     : m_compiler_core{}
+    , m_pch_microseconds{0}
 {
 }
 
@@ -142,6 +143,7 @@ std::unique_ptr<codegen::Module> codegen::Compiler::compile(const std::string& s
         compiler_info.compiler->set_precompiled_header_source(m_precompiled_header_source);
     }
     auto rc = compiler_info.compiler->compile(m_compiler_action, source);
+    m_pch_microseconds = compiler_info.compiler->get_precompiled_header_microseconds();
     return rc;
 }
 
@@ -158,6 +160,7 @@ codegen::CompilerCore::CompilerCore()
     , m_enable_diag_output((std::getenv("NGRAPH_COMPILER_DIAG_ENABLE") != nullptr))
     , m_enable_pass_report((std::getenv("NGRAPH_COMPILER_REPORT_ENABLE") != nullptr))
     , m_source_name("code.cpp")
+    , m_pch_microseconds(0)
 {
     initialize();
 }
@@ -314,9 +317,14 @@ std::unique_ptr<codegen::Module>
     preprocessor_options.RetainRemappedFileBuffers = true;
 
     CompilerInfo& compiler_info = s_compiler_info[m_precompiled_header_source];
+    m_pch_microseconds = 0;
     if (!m_precompiled_header_source.empty() && compiler_info.pch_file.empty())
     {
+        stopwatch pch_timer;
+        pch_timer.start();
         compiler_info.pch_file = generate_pch(m_precompiled_header_source);
+        pch_timer.stop();
+        m_pch_microseconds = pch_timer.get_microseconds();
     }
     if (!compiler_info.pch_file.empty())
     {
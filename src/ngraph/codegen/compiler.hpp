@@ -61,8 +61,12 @@ public:
     void add_header_search_path(const std::string& path);
     std::unique_ptr<ngraph::codegen::Module> compile(const std::string& source);
     std::unique_ptr<clang::CodeGenAction>& get_compiler_action() { return m_compiler_action; }
+    /// \brief Time the last compile spent generating the precompiled header, 0 when it
+    ///        reused one
+    size_t get_precompiled_header_microseconds() const { return m_pch_microseconds; }
 private:
     std::unique_ptr<clang::CodeGenAction> m_compiler_action;
+    size_t m_pch_microseconds;
     std::shared_ptr<CompilerCore> m_compiler_core;
     std::string m_precompiled_header_source;
     std::vector<std::string> m_header_search_paths;
@@ -84,6 +88,7 @@ public:
         compile(std::unique_ptr<clang::CodeGenAction>& compiler_action, const std::string& source);
     std::string generate_pch(const std::string& source);
     void initialize();
+    size_t get_precompiled_header_microseconds() const { return m_pch_microseconds; }
 
 private:
     std::unique_ptr<clang::CompilerInstance> m_compiler;
@@ -93,6 +98,7 @@ private:
     std::string m_source_name;
     std::vector<std::string> m_extra_search_path_list;
     std::string m_precompiled_header_source;
+    size_t m_pch_microseconds;
 
     bool is_version_number(const std::string& path);
     std::string find_header_version(const std::string& path);
@@ -15,13 +15,52 @@
 *******************************************************************************/
 
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
+#include <llvm/ExecutionEngine/SectionMemoryManager.h>
 
 #include "ngraph/codegen/execution_engine.hpp"
 
 using namespace ngraph;
 
+namespace
+{
+    // Adds up the sections allocated for the JIT compiled code
+    class SizingMemoryManager : public llvm::SectionMemoryManager
+    {
+    public:
+        SizingMemoryManager(size_t& size)
+            : m_size(size)
+        {
+        }
+
+        uint8_t* allocateCodeSection(uintptr_t size,
+                                     unsigned alignment,
+                                     unsigned section_id,
+                                     llvm::StringRef section_name) override
+        {
+            m_size += size;
+            return llvm::SectionMemoryManager::allocateCodeSection(
+                size, alignment, section_id, section_name);
+        }
+
+        uint8_t* allocateDataSection(uintptr_t size,
+                                     unsigned alignment,
+                                     unsigned section_id,
+                                     llvm::StringRef section_name,
+                                     bool is_read_only) override
+        {
+            m_size += size;
+            return llvm::SectionMemoryManager::allocateDataSection(
+                size, alignment, section_id, section_name, is_read_only);
+        }
+
+    private:
+        size_t& m_size;
+    };
+}
+
 codegen::ExecutionEngine::ExecutionEngine()
     : m_execution_engine{nullptr}
+    , m_code_size{0}
 {
 }
 
@@ -44,6 +83,9 @@ bool codegen::ExecutionEngine::add_module(std::unique_ptr<ngraph::codegen::Modul
                                          .setOptLevel(llvm::CodeGenOpt::Aggressive)
                                          .setMCPU(llvm::sys::getHostCPUName())
                                          //  .setCodeModel(llvm::CodeModel::Medium)
+                                         .setMCJITMemoryManager(
+                                             std::unique_ptr<llvm::RTDyldMemoryManager>(
+                                                 new SizingMemoryManager(m_code_size)))
                                          .setErrorStr(&m_jit_error)
                                          .create());
 
@@ -43,6 +43,8 @@ public:
 
     bool add_module(std::unique_ptr<ngraph::codegen::Module>& module);
     void finalize();
+    /// \brief Bytes of the code and data sections loaded for the modules
+    size_t get_code_size() const { return m_code_size; }
 
     template <typename ftype>
     std::function<ftype> find_function(const std::string& func_name)
@@ -53,6 +55,7 @@ public:
 private:
     std::unique_ptr<llvm::ExecutionEngine> m_execution_engine;
     std::string m_jit_error;
+    size_t m_code_size;
 
     void* get_pointer_to_named_function(const std::string& func_name);
     template <typename signature>
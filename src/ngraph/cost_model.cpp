@@ -0,0 +1,348 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <mutex>
+#include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "ngraph/cost_model.hpp"
+#include "ngraph/function.hpp"
+#include "ngraph/graph_util.hpp"
+#include "ngraph/node.hpp"
+#include "ngraph/op/allreduce.hpp"
+#include "ngraph/op/avg_pool.hpp"
+#include "ngraph/op/batch_norm.hpp"
+#include "ngraph/op/constant.hpp"
+#include "ngraph/op/convert.hpp"
+#include "ngraph/op/convolution.hpp"
+#include "ngraph/op/dot.hpp"
+#include "ngraph/op/function_call.hpp"
+#include "ngraph/op/get_output_element.hpp"
+#include "ngraph/op/max.hpp"
+#include "ngraph/op/max_pool.hpp"
+#include "ngraph/op/min.hpp"
+#include "ngraph/op/not.hpp"
+#include "ngraph/op/parameter.hpp"
+#include "ngraph/op/product.hpp"
+#include "ngraph/op/reduce.hpp"
+#include "ngraph/op/reduce_window.hpp"
+#include "ngraph/op/relu.hpp"
+#include "ngraph/op/select.hpp"
+#include "ngraph/op/select_and_scatter.hpp"
+#include "ngraph/op/sigmoid.hpp"
+#include "ngraph/op/slice.hpp"
+#include "ngraph/op/softmax.hpp"
+#include "ngraph/op/sum.hpp"
+#include "ngraph/op/util/binary_elementwise.hpp"
+#include "ngraph/op/util/unary_elementwise_arithmetic.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+#define TI(x) type_index(typeid(x))
+
+static size_t output_elements(const Node& node)
+{
+    return shape_size(node.get_output_shape(0));
+}
+
+static size_t input_elements(const Node& node, size_t i)
+{
+    return shape_size(node.get_input_shape(i));
+}
+
+static size_t function_flops(const shared_ptr<Function>& function)
+{
+    return estimate_cost(*function).flops;
+}
+
+// Every output element sums the products of one filter with the input window it covers
+static size_t convolution_flops(size_t output_elements, const Shape& filters)
+{
+    size_t filter_size = shape_size(filters);
+    return filter_size > 0 ? 2 * output_elements * (filter_size / filters.at(0)) : 0;
+}
+
+static void elementwise_cost(const Node& node, Cost& cost)
+{
+    cost.flops = output_elements(node);
+}
+
+static void data_movement_cost(const Node& node, Cost& cost)
+{
+}
+
+// No work is done when the op is executed
+static void no_cost(const Node& node, Cost& cost)
+{
+    cost = Cost();
+}
+
+static void reduction_cost(const Node& node, Cost& cost)
+{
+    cost.flops = input_elements(node, 0);
+}
+
+static void dot_cost(const Node& node, Cost& cost)
+{
+    const op::Dot& dot = static_cast<const op::Dot&>(node);
+    const Shape& shape = node.get_input_shape(0);
+    size_t reduction_size = 1;
+    for (size_t i = shape.size() - dot.get_reduction_axes_count(); i < shape.size(); i++)
+    {
+        reduction_size *= shape[i];
+    }
+    cost.flops = 2 * output_elements(node) * reduction_size;
+}
+
+static void convolution_cost(const Node& node, Cost& cost)
+{
+    cost.flops = convolution_flops(output_elements(node), node.get_input_shape(1));
+}
+
+static void convolution_backprop_data_cost(const Node& node, Cost& cost)
+{
+    // Arguments are the filters and the output delta
+    cost.flops = convolution_flops(input_elements(node, 1), node.get_input_shape(0));
+}
+
+static void convolution_backprop_filters_cost(const Node& node, Cost& cost)
+{
+    // Arguments are the data batch and the output delta
+    const op::ConvolutionBackpropFilters& conv =
+        static_cast<const op::ConvolutionBackpropFilters&>(node);
+    cost.flops = convolution_flops(input_elements(node, 1), conv.get_filters_shape());
+}
+
+static void avg_pool_cost(const Node& node, Cost& cost)
+{
+    const op::AvgPool& pool = static_cast<const op::AvgPool&>(node);
+    cost.flops = output_elements(node) * shape_size(pool.get_window_shape());
+}
+
+static void avg_pool_backprop_cost(const Node& node, Cost& cost)
+{
+    const op::AvgPoolBackprop& pool = static_cast<const op::AvgPoolBackprop&>(node);
+    cost.flops = input_elements(node, 0) * shape_size(pool.get_window_shape());
+}
+
+static void max_pool_cost(const Node& node, Cost& cost)
+{
+    const op::MaxPool& pool = static_cast<const op::MaxPool&>(node);
+    cost.flops = output_elements(node) * shape_size(pool.get_window_shape());
+}
+
+static void max_pool_backprop_cost(const Node& node, Cost& cost)
+{
+    // The maximum of every window is searched again
+    const op::MaxPoolBackprop& pool = static_cast<const op::MaxPoolBackprop&>(node);
+    cost.flops = input_elements(node, 1) * shape_size(pool.get_window_shape());
+}
+
+static void batch_norm_cost(const Node& node, Cost& cost)
+{
+    // Normalizing takes a subtraction, a multiplication by the inverse deviation and the
+    // scale and shift; computing the mean and variance three more per element
+    size_t elements = input_elements(node, 2);
+    cost.flops = (node.get_arguments().size() == 3 ? 7 : 4) * elements;
+}
+
+static void batch_norm_backprop_cost(const Node& node, Cost& cost)
+{
+    cost.flops = 10 * input_elements(node, 2);
+}
+
+static void softmax_cost(const Node& node, Cost& cost)
+{
+    // Exponential, sum and division
+    cost.flops = 3 * output_elements(node);
+}
+
+static void sigmoid_backprop_cost(const Node& node, Cost& cost)
+{
+    // delta * s * (1 - s) with s the sigmoid
+    cost.flops = 4 * output_elements(node);
+}
+
+static void slice_cost(const Node& node, Cost& cost)
+{
+    cost.bytes_read = cost.bytes_written;
+}
+
+static void reduce_cost(const Node& node, Cost& cost)
+{
+    const op::Reduce& reduce = static_cast<const op::Reduce&>(node);
+    cost.flops = input_elements(node, 0) * function_flops(reduce.get_functions().at(0));
+}
+
+static void reduce_window_cost(const Node& node, Cost& cost)
+{
+    const op::ReduceWindow& reduce = static_cast<const op::ReduceWindow&>(node);
+    cost.flops = output_elements(node) * shape_size(reduce.get_window_shape()) *
+                 function_flops(reduce.get_functions().at(0));
+}
+
+static void select_and_scatter_cost(const Node& node, Cost& cost)
+{
+    // Every source element selects within its window and is scattered once
+    const op::SelectAndScatter& op = static_cast<const op::SelectAndScatter&>(node);
+    size_t source_elements = input_elements(node, 1);
+    cost.flops = source_elements * shape_size(op.get_window_shape()) *
+                     function_flops(op.get_functions().at(0)) +
+                 source_elements * function_flops(op.get_functions().at(1));
+}
+
+static void function_call_cost(const Node& node, Cost& cost)
+{
+    cost.flops = function_flops(node.get_functions().at(0));
+}
+
+static mutex s_cost_functions_mutex;
+
+static unordered_map<type_index, CostFunction>& get_cost_functions()
+{
+    static unordered_map<type_index, CostFunction> s_cost_functions{
+        {TI(op::AllReduce), elementwise_cost},
+        {TI(op::AvgPool), avg_pool_cost},
+        {TI(op::AvgPoolBackprop), avg_pool_backprop_cost},
+        {TI(op::BatchNorm), batch_norm_cost},
+        {TI(op::BatchNormBackprop), batch_norm_backprop_cost},
+        {TI(op::Constant), no_cost},
+        {TI(op::Convert), data_movement_cost},
+        {TI(op::Convolution), convolution_cost},
+        {TI(op::ConvolutionBackpropData), convolution_backprop_data_cost},
+        {TI(op::ConvolutionBackpropFilters), convolution_backprop_filters_cost},
+        {TI(op::Dot), dot_cost},
+        {TI(op::FunctionCall), function_call_cost},
+        {TI(op::GetOutputElement), no_cost},
+        {TI(op::Max), reduction_cost},
+        {TI(op::MaxPool), max_pool_cost},
+        {TI(op::MaxPoolBackprop), max_pool_backprop_cost},
+        {TI(op::Min), reduction_cost},
+        {TI(op::Not), elementwise_cost},
+        {TI(op::Parameter), no_cost},
+        {TI(op::Product), reduction_cost},
+        {TI(op::Reduce), reduce_cost},
+        {TI(op::ReduceWindow), reduce_window_cost},
+        {TI(op::ReluBackprop), elementwise_cost},
+        {TI(op::Select), elementwise_cost},
+        {TI(op::SelectAndScatter), select_and_scatter_cost},
+        {TI(op::SigmoidBackprop), sigmoid_backprop_cost},
+        {TI(op::Slice), slice_cost},
+        {TI(op::Softmax), softmax_cost},
+        {TI(op::Sum), reduction_cost}};
+    return s_cost_functions;
+}
+
+double Cost::arithmetic_intensity() const
+{
+    size_t bytes = bytes_read + bytes_written;
+    return bytes > 0 ? static_cast<double>(flops) / bytes : 0;
+}
+
+Cost ngraph::estimate_cost(const Node& node)
+{
+    Cost rc;
+    unordered_set<const descriptor::Tensor*> tensors;
+    for (const descriptor::Input& input : node.get_inputs())
+    {
+        const descriptor::Tensor& tensor = input.get_tensor();
+        rc.bytes_read += tensor.size();
+        if (tensors.insert(&tensor).second)
+        {
+            rc.working_set += tensor.size();
+        }
+    }
+    for (const descriptor::Output& output : node.get_outputs())
+    {
+        rc.bytes_written += output.get_tensor().size();
+        rc.working_set += output.get_tensor().size();
+    }
+
+    CostFunction cost_function;
+    {
+        lock_guard<mutex> lock(s_cost_functions_mutex);
+        auto& cost_functions = get_cost_functions();
+        auto it = cost_functions.find(TI(node));
+        if (it != cost_functions.end())
+        {
+            cost_function = it->second;
+        }
+    }
+    if (cost_function)
+    {
+        cost_function(node, rc);
+    }
+    else if (dynamic_cast<const op::util::UnaryElementwiseArithmetic*>(&node) ||
+             dynamic_cast<const op::util::BinaryElementwise*>(&node))
+    {
+        elementwise_cost(node, rc);
+    }
+    return rc;
+}
+
+Cost ngraph::estimate_cost(const Function& function)
+{
+    Cost rc;
+    // Tensors are live from the op that writes them to their last reader. Parameters,
+    // constants and results stay live throughout.
+    unordered_map<const descriptor::Tensor*, size_t> remaining_reads;
+    size_t live = 0;
+    for (const shared_ptr<Node>& node : topological_sort(function.get_ops()))
+    {
+        Cost cost = estimate_cost(*node);
+        rc.flops += cost.flops;
+        rc.bytes_read += cost.bytes_read;
+        rc.bytes_written += cost.bytes_written;
+
+        for (const descriptor::Output& output : node->get_outputs())
+        {
+            live += output.get_tensor().size();
+            remaining_reads[&output.get_tensor()] = output.get_inputs().size();
+        }
+        rc.working_set = max(rc.working_set, live);
+
+        for (const descriptor::Input& input : node->get_inputs())
+        {
+            const descriptor::Tensor& tensor = input.get_tensor();
+            shared_ptr<Node> source = input.get_output().get_node();
+            if (--remaining_reads[&tensor] == 0 && !source->is_parameter() &&
+                !source->is_constant())
+            {
+                live -= tensor.size();
+            }
+        }
+        if (!node->is_output())
+        {
+            for (const descriptor::Output& output : node->get_outputs())
+            {
+                if (output.get_inputs().empty())
+                {
+                    live -= output.get_tensor().size();
+                }
+            }
+        }
+    }
+    return rc;
+}
+
+void ngraph::register_cost_function(const type_index& op_type, CostFunction function)
+{
+    lock_guard<mutex> lock(s_cost_functions_mutex);
+    get_cost_functions()[op_type] = function;
+}
@@ -0,0 +1,61 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <typeindex>
+
+namespace ngraph
+{
+    class Node;
+    class Function;
+
+    /// \brief Work of one execution of an op or a function, for roofline-style estimates.
+    ///
+    /// Multiply-adds count as two FLOPs, every other arithmetic operation, including
+    /// comparisons and transcendental functions, as one. Bytes are counted as if every
+    /// tensor were read from and written to memory once per use.
+    struct Cost
+    {
+        size_t flops = 0;
+        size_t bytes_read = 0;
+        size_t bytes_written = 0;
+        /// For an op the size of the distinct tensors it touches, for a function the
+        /// largest size of the tensors live at the same time
+        size_t working_set = 0;
+
+        /// \brief FLOPs per byte moved, 0 for pure data movement
+        double arithmetic_intensity() const;
+    };
+
+    /// \brief Fills in the FLOPs of node and corrects the bytes where they differ from the
+    ///        sizes of its inputs and outputs, which cost holds on entry
+    using CostFunction = std::function<void(const Node& node, Cost& cost)>;
+
+    /// \brief Estimates one execution of node from its shapes.
+    ///
+    /// Ops without a cost function are elementwise if derived from one of the elementwise
+    /// base classes and data movement otherwise.
+    Cost estimate_cost(const Node& node);
+
+    /// \brief Sums the costs of the ops of function, including the functions they call
+    Cost estimate_cost(const Function& function);
+
+    /// \brief Sets the cost function for ops of type op_type, such as those a backend adds
+    void register_cost_function(const std::type_index& op_type, CostFunction function);
+}
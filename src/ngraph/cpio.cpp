@@ -14,6 +14,9 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <cstring>
+#include <limits>
+
 #include "ngraph/cpio.hpp"
 #include "ngraph/log.hpp"
 
@@ -111,10 +114,10 @@ cpio::Header cpio::Header::read(istream& stream)
     return rc;
 }
 
-void cpio::Header::write(ostream& stream, const string& name, uint32_t size)
+void cpio::Header::write(ostream& stream, const string& name, uint32_t size, uint16_t name_padding)
 {
     // namesize includes the null string terminator so + 1
-    uint16_t namesize = static_cast<uint16_t>(name.size()) + 1;
+    uint16_t namesize = static_cast<uint16_t>(name.size() + 1 + name_padding);
     write_u16(stream, 0x71C7);   // magic
     write_u16(stream, 0);        // dev
     write_u16(stream, 0);        // ino
@@ -126,11 +129,16 @@ void cpio::Header::write(ostream& stream, const string& name, uint32_t size)
     write_u32(stream, 0);        // mtime
     write_u16(stream, namesize); // namesize
     write_u32(stream, size);     // filesize
-    stream.write(name.c_str(), namesize + (namesize % 2));
+    stream.write(name.c_str(), name.size());
+    for (size_t i = name.size(); i < namesize + (namesize % 2); i++)
+    {
+        stream.put(0);
+    }
 }
 
 cpio::Writer::Writer()
     : m_stream(nullptr)
+    , m_offset(0)
 {
 }
 
@@ -154,11 +162,13 @@ cpio::Writer::~Writer()
 void cpio::Writer::open(ostream& out)
 {
     m_stream = &out;
+    m_offset = 0;
 }
 
 void cpio::Writer::open(const string& filename)
 {
     m_stream = &m_my_stream;
+    m_offset = 0;
     m_my_stream.open(filename, ios_base::binary | ios_base::out);
 }
 
@@ -171,17 +181,36 @@ void cpio::Writer::close()
     }
 }
 
-void cpio::Writer::write(const string& record_name, const void* data, uint32_t size_in_bytes)
+void cpio::Writer::write(const string& record_name,
+                         const void* data,
+                         uint32_t size_in_bytes,
+                         size_t alignment)
 {
     if (m_stream)
     {
-        Header::write(*m_stream, record_name, size_in_bytes);
+        // The header is 26 bytes and the name field is padded to an even size, so every
+        // record starts at an even offset
+        size_t name_field = record_name.size() + 1;
+        name_field += name_field % 2;
+        size_t name_padding = 0;
+        if (alignment > 2)
+        {
+            size_t data_offset = m_offset + 26 + name_field;
+            name_padding = (alignment - data_offset % alignment) % alignment;
+        }
+        if (record_name.size() + 1 + name_padding > numeric_limits<uint16_t>::max())
+        {
+            throw runtime_error("cpio file name too long");
+        }
+        Header::write(
+            *m_stream, record_name, size_in_bytes, static_cast<uint16_t>(name_padding));
         m_stream->write(static_cast<const char*>(data), size_in_bytes);
         if (size_in_bytes % 2)
         {
             char ch = 0;
             m_stream->write(&ch, 1);
         }
+        m_offset += 26 + name_field + name_padding + size_in_bytes + size_in_bytes % 2;
     }
     else
     {
@@ -240,8 +269,8 @@ const vector<cpio::FileInfo>& cpio::Reader::get_file_info()
 
             auto buffer = new char[header.namesize];
             m_stream->read(buffer, header.namesize);
-            // namesize includes the null string terminator so -1
-            string file_name = string(buffer, header.namesize - 1);
+            // namesize includes the null string terminator and any alignment padding
+            string file_name = string(buffer, strnlen(buffer, header.namesize));
             delete[] buffer;
             // skip any pad characters
             if (header.namesize % 2)
@@ -281,6 +310,12 @@ void cpio::Reader::read(const string& file_name, void* data, size_t size_in_byte
     }
 }
 
+void cpio::Reader::read(const FileInfo& info, void* data)
+{
+    m_stream->seekg(info.get_offset(), ios_base::beg);
+    m_stream->read(reinterpret_cast<char*>(data), info.get_size());
+}
+
 bool cpio::is_cpio(const string& path)
 {
     ifstream in(path, ios_base::binary | ios_base::in);
@@ -51,7 +51,12 @@ public:
     uint32_t filesize;
 
     static Header read(std::istream&);
-    static void write(std::ostream&, const std::string& name, uint32_t size);
+    // @param name_padding Extra null characters written after the name, used to align the
+    //    data that follows the header
+    static void write(std::ostream&,
+                      const std::string& name,
+                      uint32_t size,
+                      uint16_t name_padding = 0);
 
 private:
 };
@@ -86,11 +91,18 @@ public:
     void open(std::ostream& out);
     void open(const std::string& filename);
     void close();
-    void write(const std::string& file_name, const void* data, uint32_t size_in_bytes);
+    // @brief Appends a file to the archive
+    // @param alignment The file data starts at a multiple of alignment bytes from the start
+    //    of the archive. Must be a power of two; the name is padded with null characters.
+    void write(const std::string& file_name,
+               const void* data,
+               uint32_t size_in_bytes,
+               size_t alignment = 1);
 
 private:
     std::ostream* m_stream;
     std::ofstream m_my_stream;
+    size_t m_offset;
 };
 
 class ngraph::cpio::Reader
@@ -106,6 +118,7 @@ public:
     void close();
     const std::vector<FileInfo>& get_file_info();
     void read(const std::string& file_name, void* data, size_t size_in_bytes);
+    void read(const FileInfo& info, void* data);
 
 private:
     std::istream* m_stream;
@@ -91,5 +91,25 @@ namespace ngraph
         // @param path The path to test
         // @param true if the path exists, false otherwise
         bool exists(const std::string& path);
+
+        // @brief A read-only memory mapping of a whole file. The pages are shared with other
+        //    processes mapping the same file and are only read from disk when first accessed.
+        class MappedFile
+        {
+        public:
+            // @brief Maps a file
+            // @param path The path of the file to map
+            // Throws std::runtime_error if the file cannot be opened or mapped
+            MappedFile(const std::string& path);
+            ~MappedFile();
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            const char* get_data() const { return m_data; }
+            size_t get_size() const { return m_size; }
+        private:
+            const char* m_data;
+            size_t m_size;
+        };
     }
 }
@@ -20,6 +20,7 @@
 #include <unordered_set>
 #include <vector>
 
+#include "ngraph/cost_model.hpp"
 #include "ngraph/descriptor/input.hpp"
 #include "ngraph/descriptor/output.hpp"
 #include "ngraph/function.hpp"
@@ -105,6 +106,73 @@ void ngraph::traverse_functions(std::shared_ptr<ngraph::Function> p,
     }
 }
 
+// Records on replacement the ops that become dead when it replaces target: target and
+// the ops above it all of whose users are dead, such as the convolution under the add a
+// convolution with bias replaces. Ops that were themselves replacements pass on what
+// they replaced, so fusions of fused ops still lead back to the original graph.
+static void record_replaced_nodes(const shared_ptr<Node>& target,
+                                  const shared_ptr<Node>& replacement)
+{
+    unordered_set<Node*> replaced{target.get()};
+    deque<Node*> pending{target.get()};
+    while (!pending.empty())
+    {
+        Node* node = pending.front();
+        pending.pop_front();
+        for (const shared_ptr<Node>& arg : node->get_arguments())
+        {
+            if (replaced.count(arg.get()) || arg->is_parameter() || arg->is_constant())
+            {
+                continue;
+            }
+            bool dead = true;
+            for (const shared_ptr<Node>& user : arg->get_users())
+            {
+                if (replaced.count(user.get()) == 0)
+                {
+                    dead = false;
+                    break;
+                }
+            }
+            if (dead)
+            {
+                replaced.insert(arg.get());
+                pending.push_back(arg.get());
+            }
+        }
+    }
+
+    for (Node* node : replaced)
+    {
+        if (node->get_replaced_nodes().empty())
+        {
+            replacement->add_replaced_node(node->get_name(), estimate_cost(*node));
+        }
+        for (const auto& replaced_node : node->get_replaced_nodes())
+        {
+            replacement->add_replaced_node(replaced_node.first, replaced_node.second);
+        }
+    }
+}
+
+static thread_local bool s_record_replaced_nodes = false;
+
+ngraph::ReplacedNodeRecording::ReplacedNodeRecording(bool enable)
+    : m_previous(s_record_replaced_nodes)
+{
+    s_record_replaced_nodes = enable;
+}
+
+ngraph::ReplacedNodeRecording::~ReplacedNodeRecording()
+{
+    s_record_replaced_nodes = m_previous;
+}
+
+bool ngraph::ReplacedNodeRecording::is_enabled()
+{
+    return s_record_replaced_nodes;
+}
+
 void ngraph::replace_node(std::shared_ptr<Node> target, std::shared_ptr<Node> replacement)
 {
     if (target->is_output())
@@ -120,6 +188,13 @@ void ngraph::replace_node(std::shared_ptr<Node> target, std::shared_ptr<Node> re
     // Fix input/output descriptors
     assert(target->get_outputs().size() == replacement->get_outputs().size());
 
+    // Only a new node takes over the work of what it replaces; ops that are eliminated in
+    // favor of an existing node simply stop running
+    if (s_record_replaced_nodes && replacement->get_users().empty())
+    {
+        record_replaced_nodes(target, replacement);
+    }
+
     // For each of target's output O with replacement output O_rep:
     //     For each O's connected downstream input I:
     //         Change I's connected upstream output to O_rep
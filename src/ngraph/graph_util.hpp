@@ -49,6 +49,25 @@ namespace ngraph
 
     void replace_node(std::shared_ptr<Node> target, std::shared_ptr<Node> replacement);
 
+    /// \brief While alive, replace_node records on the new replacement nodes of the calling
+    ///        thread the ops they take the place of, see Node::get_replaced_nodes.
+    ///
+    /// Recording estimates the cost of every replaced op, so backends only enable it when
+    /// they collect performance data. Scopes nest; the innermost one applies.
+    class ReplacedNodeRecording
+    {
+    public:
+        ReplacedNodeRecording(bool enable = true);
+        ~ReplacedNodeRecording();
+        ReplacedNodeRecording(const ReplacedNodeRecording&) = delete;
+        ReplacedNodeRecording& operator=(const ReplacedNodeRecording&) = delete;
+
+        static bool is_enabled();
+
+    private:
+        bool m_previous;
+    };
+
     std::list<std::shared_ptr<Node>>
         topological_sort(const std::list<std::shared_ptr<Node>>& nodes);
 
@@ -0,0 +1,439 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include "ngraph/model_container.hpp"
+
+using namespace ngraph;
+using namespace std;
+
+static const char s_magic[8] = {'N', 'G', 'R', 'A', 'P', 'H', 'M', 'C'};
+static const uint32_t s_version = 1;
+static const size_t s_header_size = 64;
+static const size_t s_footer_size = 64;
+static const size_t s_entry_size = 48;
+static const uint32_t s_flag_checksum = 1;
+
+static void write_u32(char* p, uint32_t value)
+{
+    for (size_t i = 0; i < 4; i++)
+    {
+        p[i] = static_cast<char>(value >> (8 * i));
+    }
+}
+
+static void write_u64(char* p, uint64_t value)
+{
+    for (size_t i = 0; i < 8; i++)
+    {
+        p[i] = static_cast<char>(value >> (8 * i));
+    }
+}
+
+static uint32_t read_u32(const char* p)
+{
+    uint32_t rc = 0;
+    for (size_t i = 0; i < 4; i++)
+    {
+        rc |= static_cast<uint32_t>(static_cast<uint8_t>(p[i])) << (8 * i);
+    }
+    return rc;
+}
+
+static uint64_t read_u64(const char* p)
+{
+    uint64_t rc = 0;
+    for (size_t i = 0; i < 8; i++)
+    {
+        rc |= static_cast<uint64_t>(static_cast<uint8_t>(p[i])) << (8 * i);
+    }
+    return rc;
+}
+
+static uint64_t hash_name(const string& name)
+{
+    // FNV-1a, which is the same on every platform
+    uint64_t hash = 14695981039346656037ULL;
+    for (char ch : name)
+    {
+        hash ^= static_cast<uint8_t>(ch);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static uint32_t crc32(const void* data, uint64_t size)
+{
+    static uint32_t table[256] = {};
+    static bool initialized = [] {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t c = i;
+            for (size_t k = 0; k < 8; k++)
+            {
+                c = (c & 1) ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+            }
+            table[i] = c;
+        }
+        return true;
+    }();
+    (void)initialized;
+
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    uint32_t crc = 0xFFFFFFFF;
+    for (uint64_t i = 0; i < size; i++)
+    {
+        crc = table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFF;
+}
+
+static uint64_t get_bucket_count(size_t blob_count)
+{
+    // At most half full so probe sequences stay short
+    uint64_t count = 1;
+    while (count < 2 * blob_count)
+    {
+        count <<= 1;
+    }
+    return count;
+}
+
+bool model_container::verify(const BlobInfo& info, const void* data)
+{
+    return !info.has_checksum() || crc32(data, info.get_size()) == info.get_checksum();
+}
+
+model_container::Writer::Writer()
+    : m_stream(nullptr)
+    , m_offset(0)
+    , m_checksums(false)
+{
+}
+
+model_container::Writer::Writer(ostream& out, bool checksums)
+    : Writer()
+{
+    open(out, checksums);
+}
+
+model_container::Writer::Writer(const string& filename, bool checksums)
+    : Writer()
+{
+    open(filename, checksums);
+}
+
+model_container::Writer::~Writer()
+{
+    close();
+}
+
+void model_container::Writer::open(ostream& out, bool checksums)
+{
+    m_stream = &out;
+    m_offset = 0;
+    m_checksums = checksums;
+    m_blob_info.clear();
+
+    char header[s_header_size] = {};
+    memcpy(header, s_magic, sizeof(s_magic));
+    write_u32(header + 8, s_version);
+    m_stream->write(header, s_header_size);
+    m_offset = s_header_size;
+}
+
+void model_container::Writer::open(const string& filename, bool checksums)
+{
+    m_my_stream.open(filename, ios_base::binary | ios_base::out);
+    open(m_my_stream, checksums);
+}
+
+void model_container::Writer::pad_to(uint64_t offset)
+{
+    static const char zeros[alignment] = {};
+    while (m_offset < offset)
+    {
+        uint64_t count = min<uint64_t>(offset - m_offset, alignment);
+        m_stream->write(zeros, count);
+        m_offset += count;
+    }
+}
+
+void model_container::Writer::write(const string& name, const void* data, uint64_t size_in_bytes)
+{
+    if (!m_stream)
+    {
+        throw runtime_error("model container writer output not set");
+    }
+    if (name.size() > numeric_limits<uint32_t>::max())
+    {
+        throw runtime_error("model container blob name too long");
+    }
+
+    pad_to((m_offset + alignment - 1) / alignment * alignment);
+    uint32_t checksum = m_checksums ? crc32(data, size_in_bytes) : 0;
+    m_blob_info.emplace_back(name, size_in_bytes, m_offset, m_checksums, checksum);
+    m_stream->write(static_cast<const char*>(data), size_in_bytes);
+    m_offset += size_in_bytes;
+}
+
+void model_container::Writer::close()
+{
+    if (!m_stream)
+    {
+        return;
+    }
+
+    uint64_t bucket_count = get_bucket_count(m_blob_info.size());
+    vector<char> entries(m_blob_info.size() * s_entry_size, 0);
+    vector<char> buckets(bucket_count * sizeof(uint32_t), 0);
+    string names;
+    for (size_t i = 0; i < m_blob_info.size(); i++)
+    {
+        const BlobInfo& info = m_blob_info[i];
+        if (names.size() > numeric_limits<uint32_t>::max())
+        {
+            throw runtime_error("model container blob names too long");
+        }
+        uint64_t hash = hash_name(info.get_name());
+        char* entry = &entries[i * s_entry_size];
+        write_u64(entry, info.get_offset());
+        write_u64(entry + 8, info.get_size());
+        write_u64(entry + 16, hash);
+        write_u32(entry + 24, static_cast<uint32_t>(names.size()));
+        write_u32(entry + 28, static_cast<uint32_t>(info.get_name().size()));
+        write_u32(entry + 32, info.get_checksum());
+        write_u32(entry + 36, info.has_checksum() ? s_flag_checksum : 0);
+        names += info.get_name();
+
+        // Buckets hold the entry index + 1 so zero marks an empty bucket
+        uint64_t bucket = hash & (bucket_count - 1);
+        while (read_u32(&buckets[bucket * sizeof(uint32_t)]) != 0)
+        {
+            bucket = (bucket + 1) & (bucket_count - 1);
+        }
+        write_u32(&buckets[bucket * sizeof(uint32_t)], static_cast<uint32_t>(i + 1));
+    }
+
+    pad_to((m_offset + alignment - 1) / alignment * alignment);
+    uint64_t toc_offset = m_offset;
+    m_stream->write(entries.data(), entries.size());
+    m_stream->write(buckets.data(), buckets.size());
+    m_stream->write(names.data(), names.size());
+    m_offset += entries.size() + buckets.size() + names.size();
+
+    char footer[s_footer_size] = {};
+    write_u64(footer, toc_offset);
+    write_u64(footer + 8, m_offset - toc_offset);
+    write_u64(footer + 16, m_blob_info.size());
+    write_u64(footer + 24, bucket_count);
+    memcpy(footer + s_footer_size - sizeof(s_magic), s_magic, sizeof(s_magic));
+    m_stream->write(footer, s_footer_size);
+    m_offset += s_footer_size;
+
+    m_stream->flush();
+    m_stream = nullptr;
+    if (m_my_stream.is_open())
+    {
+        m_my_stream.close();
+    }
+}
+
+model_container::Reader::Reader()
+    : m_stream(nullptr)
+{
+}
+
+model_container::Reader::Reader(istream& in)
+    : Reader()
+{
+    open(in);
+}
+
+model_container::Reader::Reader(const string& filename)
+    : Reader()
+{
+    open(filename);
+}
+
+model_container::Reader::~Reader()
+{
+}
+
+void model_container::Reader::open(istream& in)
+{
+    m_stream = &in;
+    m_blob_info.clear();
+    m_name_hashes.clear();
+    m_buckets.clear();
+
+    if (!is_model_container(in))
+    {
+        throw runtime_error("not a model container");
+    }
+
+    char footer[s_footer_size];
+    m_stream->seekg(0, ios_base::end);
+    uint64_t file_size = static_cast<uint64_t>(m_stream->tellg());
+    if (file_size < s_header_size + s_footer_size)
+    {
+        throw runtime_error("model container truncated");
+    }
+    m_stream->seekg(file_size - s_footer_size, ios_base::beg);
+    m_stream->read(footer, s_footer_size);
+    if (memcmp(footer + s_footer_size - sizeof(s_magic), s_magic, sizeof(s_magic)) != 0)
+    {
+        throw runtime_error("model container truncated");
+    }
+    uint64_t toc_offset = read_u64(footer);
+    uint64_t toc_size = read_u64(footer + 8);
+    uint64_t blob_count = read_u64(footer + 16);
+    uint64_t bucket_count = read_u64(footer + 24);
+    uint64_t toc_end = file_size - s_footer_size;
+    if (toc_offset > toc_end || toc_size > toc_end - toc_offset ||
+        blob_count > toc_size / s_entry_size || bucket_count > toc_size / sizeof(uint32_t) ||
+        blob_count * s_entry_size + bucket_count * sizeof(uint32_t) > toc_size ||
+        bucket_count <= blob_count || (bucket_count & (bucket_count - 1)) != 0)
+    {
+        throw runtime_error("model container table of contents is corrupt");
+    }
+
+    vector<char> toc(toc_size);
+    m_stream->seekg(toc_offset, ios_base::beg);
+    m_stream->read(toc.data(), toc_size);
+    const char* buckets = toc.data() + blob_count * s_entry_size;
+    const char* names = buckets + bucket_count * sizeof(uint32_t);
+    uint64_t names_size = toc_size - (names - toc.data());
+    for (uint64_t i = 0; i < blob_count; i++)
+    {
+        const char* entry = toc.data() + i * s_entry_size;
+        uint64_t offset = read_u64(entry);
+        uint64_t size = read_u64(entry + 8);
+        uint32_t name_offset = read_u32(entry + 24);
+        uint32_t name_size = read_u32(entry + 28);
+        if (offset > toc_offset || size > toc_offset - offset ||
+            static_cast<uint64_t>(name_offset) + name_size > names_size)
+        {
+            throw runtime_error("model container table of contents is corrupt");
+        }
+        bool has_checksum = (read_u32(entry + 36) & s_flag_checksum) != 0;
+        m_blob_info.emplace_back(string(names + name_offset, name_size),
+                                 size,
+                                 offset,
+                                 has_checksum,
+                                 read_u32(entry + 32));
+        m_name_hashes.push_back(read_u64(entry + 16));
+    }
+    m_buckets.resize(bucket_count);
+    for (uint64_t i = 0; i < bucket_count; i++)
+    {
+        m_buckets[i] = read_u32(buckets + i * sizeof(uint32_t));
+        if (m_buckets[i] > blob_count)
+        {
+            throw runtime_error("model container table of contents is corrupt");
+        }
+    }
+}
+
+void model_container::Reader::open(const string& filename)
+{
+    m_my_stream.open(filename, ios_base::binary | ios_base::in);
+    open(m_my_stream);
+}
+
+void model_container::Reader::close()
+{
+    if (m_my_stream.is_open())
+    {
+        m_my_stream.close();
+    }
+    m_stream = nullptr;
+}
+
+const model_container::BlobInfo* model_container::Reader::find(const string& name) const
+{
+    if (m_buckets.empty())
+    {
+        return nullptr;
+    }
+    uint64_t hash = hash_name(name);
+    uint64_t mask = m_buckets.size() - 1;
+    uint64_t bucket = hash & mask;
+    // A corrupt table may have no empty bucket, so visit each bucket at most once
+    for (size_t probes = 0; probes < m_buckets.size() && m_buckets[bucket] != 0; probes++)
+    {
+        size_t index = m_buckets[bucket] - 1;
+        if (m_name_hashes[index] == hash && m_blob_info[index].get_name() == name)
+        {
+            return &m_blob_info[index];
+        }
+        bucket = (bucket + 1) & mask;
+    }
+    return nullptr;
+}
+
+void model_container::Reader::read(const BlobInfo& info, void* data)
+{
+    if (!m_stream)
+    {
+        throw runtime_error("model container reader input not set");
+    }
+    m_stream->seekg(info.get_offset(), ios_base::beg);
+    m_stream->read(static_cast<char*>(data), info.get_size());
+    if (!*m_stream)
+    {
+        throw runtime_error("error reading blob '" + info.get_name() + "'");
+    }
+    if (!verify(info, data))
+    {
+        throw runtime_error("checksum mismatch in blob '" + info.get_name() + "'");
+    }
+}
+
+void model_container::Reader::read(const string& name, void* data, uint64_t size_in_bytes)
+{
+    const BlobInfo* info = find(name);
+    if (!info)
+    {
+        throw runtime_error("blob '" + name + "' not found");
+    }
+    if (size_in_bytes != info->get_size())
+    {
+        throw runtime_error("Buffer size does not match blob size");
+    }
+    read(*info, data);
+}
+
+bool model_container::is_model_container(const string& path)
+{
+    ifstream in(path, ios_base::binary | ios_base::in);
+    return is_model_container(in);
+}
+
+bool model_container::is_model_container(istream& in)
+{
+    auto offset = in.tellg();
+    in.seekg(0, ios_base::beg);
+    char magic[sizeof(s_magic)] = {};
+    in.read(magic, sizeof(magic));
+    bool rc = in && memcmp(magic, s_magic, sizeof(s_magic)) == 0;
+    in.clear();
+    in.seekg(offset, ios_base::beg);
+    return rc;
+}
@@ -0,0 +1,139 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Binary container for serialized models.
+//
+// All integers are little endian. The file starts with a 64 byte header holding the magic
+// and the format version, followed by the blobs, each starting at a multiple of 64 bytes
+// so they can be used in place from a memory mapping. The table of contents follows the
+// last blob and the file ends with a 64 byte footer, at a known offset from the end, that
+// locates the table of contents.
+//
+// The table of contents holds one 48 byte entry per blob in the order they were written
+// (offset, size, name hash, name offset, name size, checksum, flags, reserved), an
+// open addressing hash table of entry indices keyed by the FNV-1a hash of the blob name,
+// and the concatenated blob names.
+namespace ngraph
+{
+    namespace model_container
+    {
+        class BlobInfo;
+        class Writer;
+        class Reader;
+
+        bool is_model_container(const std::string&);
+        bool is_model_container(std::istream&);
+
+        // @brief Checks data against the checksum stored for a blob
+        // @return true if the data matches or the blob has no checksum
+        bool verify(const BlobInfo& info, const void* data);
+
+        // Alignment of blob data from the start of the file
+        constexpr size_t alignment = 64;
+    }
+}
+
+class ngraph::model_container::BlobInfo
+{
+public:
+    BlobInfo(const std::string& name,
+             uint64_t size,
+             uint64_t offset,
+             bool has_checksum = false,
+             uint32_t checksum = 0)
+        : m_name(name)
+        , m_size(size)
+        , m_offset(offset)
+        , m_has_checksum(has_checksum)
+        , m_checksum(checksum)
+    {
+    }
+    const std::string& get_name() const { return m_name; }
+    uint64_t get_size() const { return m_size; }
+    uint64_t get_offset() const { return m_offset; }
+    bool has_checksum() const { return m_has_checksum; }
+    uint32_t get_checksum() const { return m_checksum; }
+private:
+    std::string m_name;
+    uint64_t m_size;
+    uint64_t m_offset;
+    bool m_has_checksum;
+    uint32_t m_checksum;
+};
+
+class ngraph::model_container::Writer
+{
+public:
+    Writer();
+    // @param checksums Store a CRC-32 of every blob
+    Writer(std::ostream& out, bool checksums = false);
+    Writer(const std::string& filename, bool checksums = false);
+    ~Writer();
+
+    void open(std::ostream& out, bool checksums = false);
+    void open(const std::string& filename, bool checksums = false);
+    // @brief Writes the table of contents. Called by the destructor if not called before.
+    void close();
+    void write(const std::string& name, const void* data, uint64_t size_in_bytes);
+
+private:
+    void pad_to(uint64_t offset);
+
+    std::ostream* m_stream;
+    std::ofstream m_my_stream;
+    uint64_t m_offset;
+    bool m_checksums;
+    std::vector<BlobInfo> m_blob_info;
+};
+
+class ngraph::model_container::Reader
+{
+public:
+    Reader();
+    Reader(std::istream& in);
+    Reader(const std::string& filename);
+    ~Reader();
+
+    // @brief Reads the table of contents. Throws std::runtime_error if in is not a valid
+    //    container.
+    void open(std::istream& in);
+    void open(const std::string& filename);
+    void close();
+    // @brief The blobs in the order they were written
+    const std::vector<BlobInfo>& get_blob_info() const { return m_blob_info; }
+    // @brief Finds a blob by name using the hashed table of contents
+    // @return The blob, or nullptr if there is none with that name
+    const BlobInfo* find(const std::string& name) const;
+    // @brief Reads the data of a blob and verifies its checksum
+    // @param data Buffer of at least info.get_size() bytes
+    void read(const BlobInfo& info, void* data);
+    void read(const std::string& name, void* data, uint64_t size_in_bytes);
+
+private:
+    std::istream* m_stream;
+    std::ifstream m_my_stream;
+    std::vector<BlobInfo> m_blob_info;
+    std::vector<uint64_t> m_name_hashes;
+    std::vector<uint32_t> m_buckets;
+};
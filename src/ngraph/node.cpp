@@ -329,3 +329,8 @@ NodeVector Node::get_users() const
 
     return result;
 }
+
+void Node::add_replaced_node(const std::string& name, const Cost& cost)
+{
+    m_replaced_nodes[name] = cost;
+}
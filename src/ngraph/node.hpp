@@ -19,6 +19,7 @@
 #include <atomic>
 #include <deque>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
@@ -28,6 +29,7 @@
 #include <vector>
 
 #include "ngraph/autodiff/adjoints.hpp"
+#include "ngraph/cost_model.hpp"
 #include "ngraph/descriptor/input.hpp"
 #include "ngraph/descriptor/output.hpp"
 #include "ngraph/descriptor/tensor.hpp"
@@ -190,6 +192,13 @@ namespace ngraph
         /// Get all the nodes that uses the current node
         NodeVector get_users() const;
 
+        /// \brief Ops of the original graph this node took the place of when replace_node
+        ///        put it in the graph as a new node, such as the ops a fusion combined, with
+        ///        their estimated work. Only recorded within a ReplacedNodeRecording scope;
+        ///        empty for nodes that replaced nothing.
+        const std::map<std::string, Cost>& get_replaced_nodes() const { return m_replaced_nodes; }
+        void add_replaced_node(const std::string& name, const Cost& cost);
+
         virtual std::shared_ptr<Node> get_default_value() const { return nullptr; }
     protected:
         void add_output(const element::Type& element_type, const Shape& shape);
@@ -203,5 +212,6 @@ namespace ngraph
         std::deque<descriptor::Output> m_outputs;
         std::unordered_map<Node*, autodiff::Adjoints> m_adjoint_map;
         Placement m_placement = Placement::DEFAULT;
+        std::map<std::string, Cost> m_replaced_nodes;
     };
 }
@@ -54,7 +54,7 @@ string to_cpp_string(T value)
 
 op::Constant::~Constant()
 {
-    if (m_data)
+    if (m_data && m_owns_data)
     {
         aligned_free(m_data);
     }
@@ -155,9 +155,42 @@ shared_ptr<Node> op::Constant::copy_with_new_args(const NodeVector& new_args) co
     {
         throw ngraph_error("Incorrect number of new arguments");
     }
+    if (!is_decoded())
+    {
+        // Stay lazy; the copy takes the data from this constant once it is needed
+        auto self = static_pointer_cast<const Constant>(shared_from_this());
+        size_t size = shape_size(m_shape) * m_element_type.size();
+        return make_shared<Constant>(m_element_type, m_shape, [self, size](void* data) {
+            memcpy(data, self->get_data_ptr(), size);
+        });
+    }
+    if (!m_owns_data)
+    {
+        return make_shared<Constant>(m_element_type, m_shape, m_data, m_data_owner);
+    }
     return make_shared<Constant>(m_element_type, m_shape, m_data);
 }
 
+void op::Constant::decode() const
+{
+    call_once(m_decode_once, [this]() {
+        size_t size = shape_size(m_shape) * m_element_type.size();
+        void* data = ngraph::aligned_alloc(m_element_type.size(), size);
+        try
+        {
+            m_decoder(data);
+        }
+        catch (...)
+        {
+            aligned_free(data);
+            throw;
+        }
+        m_data = data;
+        m_decoder = nullptr;
+        m_decoded.store(true, memory_order_release);
+    });
+}
+
 //
 // We have to open up namespace blocks here to work around a problem with gcc:
 //
@@ -16,7 +16,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <sstream>
 
 #include "ngraph/log.hpp"
@@ -104,6 +108,50 @@ namespace ngraph
                 set_value_type_checked(vt);
             }
 
+            /// \brief Constructs a tensor constant that references data owned by someone
+            ///        else, such as a memory mapped model file. The data is not copied.
+            ///
+            /// \param type The element type of the tensor constant.
+            /// \param shape The shape of the tensor constant.
+            /// \param data A pointer to the constant data, aligned to the element size.
+            /// \param data_owner Kept alive for as long as this constant or a copy of it
+            ///        exists, so that data remains valid.
+            Constant(const element::Type& type,
+                     const Shape& shape,
+                     const void* data,
+                     std::shared_ptr<const void> data_owner)
+                : Node("Constant", {})
+                , m_element_type(type)
+                , m_shape(shape)
+                , m_data(const_cast<void*>(data))
+                , m_data_owner(data_owner)
+                , m_owns_data(false)
+            {
+                auto vt = std::make_shared<TensorViewType>(type, shape);
+                set_value_type_checked(vt);
+            }
+
+            /// \brief Constructs a tensor constant whose data is decoded when it is first
+            ///        accessed, e.g. from a serialized model.
+            ///
+            /// \param type The element type of the tensor constant.
+            /// \param shape The shape of the tensor constant.
+            /// \param decoder Fills a buffer of shape_size(shape) * type.size() bytes with the
+            ///        constant data. Called once, possibly from another thread.
+            Constant(const element::Type& type,
+                     const Shape& shape,
+                     std::function<void(void* data)> decoder)
+                : Node("Constant", {})
+                , m_element_type(type)
+                , m_shape(shape)
+                , m_data(nullptr)
+                , m_decoder(decoder)
+                , m_decoded(false)
+            {
+                auto vt = std::make_shared<TensorViewType>(type, shape);
+                set_value_type_checked(vt);
+            }
+
             virtual ~Constant() override;
 
             /// \brief Wrapper around constructing a shared_ptr of a Constant
@@ -145,7 +193,7 @@ namespace ngraph
                 }
 
                 std::vector<T> rc;
-                const T* p = reinterpret_cast<const T*>(m_data);
+                const T* p = get_data_ptr<T>();
                 for (size_t i = 0; i < shape_size(m_shape); i++)
                 {
                     rc.push_back(p[i]);
@@ -153,13 +201,29 @@ namespace ngraph
                 return rc;
             }
 
-            const void* get_data_ptr() const { return m_data; }
+            const void* get_data_ptr() const
+            {
+                if (!m_decoded.load(std::memory_order_acquire))
+                {
+                    decode();
+                }
+                return m_data;
+            }
             template <typename T>
             const T* get_data_ptr() const
             {
-                return reinterpret_cast<T*>(m_data);
+                return reinterpret_cast<const T*>(get_data_ptr());
             }
 
+            /// \return false while the data of a constant constructed with a decoder has not
+            ///         been decoded yet.
+            bool is_decoded() const { return m_decoded.load(std::memory_order_acquire); }
+            /// \brief Decodes the data now rather than on first access. Safe to call from
+            ///        several threads at once.
+            void decode() const;
+
+            /// \return false if the data is referenced rather than owned by this constant.
+            bool owns_data() const { return m_owns_data; }
             bool is_constant() const override { return true; }
         protected:
             template <typename T>
@@ -169,7 +233,7 @@ namespace ngraph
             }
 
             template <typename T, typename U>
-            void write_buffer(void* target, const std::vector<U>& source, size_t count)
+            static void write_buffer(void* target, const std::vector<U>& source, size_t count)
             {
                 T* p = reinterpret_cast<T*>(target);
                 for (size_t i = 0; i < count; i++)
@@ -178,12 +242,14 @@ namespace ngraph
                 }
             }
 
+        public:
+            /// \brief Converts source to target_type and writes it to target.
             template <typename T>
-            void write_to_buffer(const element::Type& target_type,
-                                 const Shape& target_shape,
-                                 const std::vector<T>& source,
-                                 void* target,
-                                 size_t target_element_count)
+            static void write_to_buffer(const element::Type& target_type,
+                                        const Shape& target_shape,
+                                        const std::vector<T>& source,
+                                        void* target,
+                                        size_t target_element_count)
             {
                 if (source.size() != target_element_count)
                 {
@@ -239,9 +305,15 @@ namespace ngraph
                 }
             }
 
+        protected:
             element::Type m_element_type;
             Shape m_shape;
-            void* m_data;
+            mutable void* m_data;
+            std::shared_ptr<const void> m_data_owner;
+            bool m_owns_data = true;
+            mutable std::function<void(void*)> m_decoder;
+            mutable std::atomic<bool> m_decoded{true};
+            mutable std::once_flag m_decode_once;
         };
     }
 }
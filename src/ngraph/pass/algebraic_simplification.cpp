@@ -31,6 +31,8 @@
 #include "ngraph/op/get_output_element.hpp"
 #include "ngraph/op/log.hpp"
 #include "ngraph/op/multiply.hpp"
+#include "ngraph/op/negative.hpp"
+#include "ngraph/op/power.hpp"
 #include "ngraph/op/product.hpp"
 #include "ngraph/op/reshape.hpp"
 #include "ngraph/op/slice.hpp"
@@ -371,43 +373,300 @@ static bool simplify_reduction(std::shared_ptr<Node> n)
     return true;
 }
 
-static std::unordered_map<std::type_index, std::function<bool(std::shared_ptr<Node>)>>
-    initialize_ops_to_simplifiers()
+//`simplify_sum_broadcast` optimizes sum(broadcast(x)) over broadcast axes only into
+//x * (number of elements summed), broadcast over the remaining broadcast axes
+static bool simplify_sum_broadcast(std::shared_ptr<Node> n)
 {
-    return std::unordered_map<std::type_index, std::function<bool(std::shared_ptr<Node>)>>(
-        {{TI(op::Add), simplify_add},
-         {TI(op::Multiply), simplify_multiply},
-         {TI(op::Concat), simplify_concat},
-         {TI(op::Sum),
-          std::function<bool(std::shared_ptr<Node>)>{
-              simplify_reduction<op::Sum, get_sum_constant>}},
-         {TI(op::Product),
-          std::function<bool(std::shared_ptr<Node>)>{
-              simplify_reduction<op::Product, get_prod_constant>}},
-         {TI(op::Log), simplify_log}});
+    auto sum = std::static_pointer_cast<op::Sum>(n);
+    auto broadcast = std::dynamic_pointer_cast<op::Broadcast>(n->get_argument(0));
+    if (!broadcast)
+    {
+        return false;
+    }
+    const AxisSet& reduction_axes = sum->get_reduction_axes();
+    const AxisSet& broadcast_axes = broadcast->get_broadcast_axes();
+    for (auto axis : reduction_axes)
+    {
+        if (broadcast_axes.count(axis) == 0)
+        {
+            NGRAPH_DEBUG << n->get_name() << " reduces axis " << axis << " of the argument";
+            return false;
+        }
+    }
+
+    AxisSet remaining_axes;
+    size_t output_axis = 0;
+    for (size_t i = 0; i < broadcast->get_shape().size(); i++)
+    {
+        if (reduction_axes.count(i) == 0)
+        {
+            if (broadcast_axes.count(i) != 0)
+            {
+                remaining_axes.insert(output_axis);
+            }
+            output_axis++;
+        }
+    }
+
+    std::shared_ptr<Node> replacement = broadcast->get_argument(0);
+    if (!remaining_axes.empty())
+    {
+        replacement =
+            std::make_shared<op::Broadcast>(replacement, sum->get_shape(), remaining_axes);
+    }
+    size_t multiplier = reduction_shape_size(reduction_axes, broadcast->get_shape());
+    if (multiplier != 1)
+    {
+        AxisSet all_axes;
+        for (size_t i = 0; i < sum->get_shape().size(); i++)
+        {
+            all_axes.insert(i);
+        }
+        auto cnst = op::Constant::create(
+            n->get_element_type(), Shape{}, std::vector<double>{static_cast<double>(multiplier)});
+        replacement = std::make_shared<op::Multiply>(
+            replacement, std::make_shared<op::Broadcast>(cnst, sum->get_shape(), all_axes));
+    }
+    ngraph::replace_node(n, replacement);
+    return true;
+}
+
+//`simplify_broadcast_broadcast` merges broadcast(broadcast(x)) into one broadcast
+static bool simplify_broadcast_broadcast(std::shared_ptr<Node> n)
+{
+    auto outer = std::static_pointer_cast<op::Broadcast>(n);
+    auto inner = std::dynamic_pointer_cast<op::Broadcast>(n->get_argument(0));
+    if (!inner)
+    {
+        return false;
+    }
+
+    // The axes of the inner broadcast are the outer's non-broadcast axes, in order
+    AxisSet axes = outer->get_broadcast_axes();
+    size_t inner_axis = 0;
+    for (size_t i = 0; i < outer->get_shape().size(); i++)
+    {
+        if (outer->get_broadcast_axes().count(i) == 0)
+        {
+            if (inner->get_broadcast_axes().count(inner_axis) != 0)
+            {
+                axes.insert(i);
+            }
+            inner_axis++;
+        }
+    }
+    ngraph::replace_node(
+        n, std::make_shared<op::Broadcast>(inner->get_argument(0), outer->get_shape(), axes));
+    return true;
+}
+
+//`simplify_negative` optimizes `-(-x)` into `x`
+static bool simplify_negative(std::shared_ptr<Node> n)
+{
+    if (auto negative = std::dynamic_pointer_cast<op::Negative>(n->get_argument(0)))
+    {
+        ngraph::replace_node(n, negative->get_argument(0));
+        return true;
+    }
+    return false;
+}
+
+//`simplify_exp` optimizes `exp(log(x))` into `x`. This assumes x > 0, where log is defined.
+static bool simplify_exp(std::shared_ptr<Node> n)
+{
+    if (auto log = std::dynamic_pointer_cast<op::Log>(n->get_argument(0)))
+    {
+        ngraph::replace_node(n, log->get_argument(0));
+        return true;
+    }
+    return false;
+}
+
+//`simplify_log_exp` optimizes `log(exp(x))` into `x`
+static bool simplify_log_exp(std::shared_ptr<Node> n)
+{
+    if (auto exp = std::dynamic_pointer_cast<op::Exp>(n->get_argument(0)))
+    {
+        ngraph::replace_node(n, exp->get_argument(0));
+        return true;
+    }
+    return false;
+}
+
+// A constant, possibly broadcast
+static std::shared_ptr<op::Constant> get_constant(std::shared_ptr<Node> n)
+{
+    if (auto broadcast = std::dynamic_pointer_cast<op::Broadcast>(n))
+    {
+        n = broadcast->get_argument(0);
+    }
+    return std::dynamic_pointer_cast<op::Constant>(n);
 }
 
-static std::unordered_map<std::type_index, std::function<bool(std::shared_ptr<Node>)>>
-    ops_to_simplifiers = initialize_ops_to_simplifiers();
+template <typename T>
+static std::shared_ptr<op::Constant> reciprocal(std::shared_ptr<op::Constant> cnst)
+{
+    std::vector<T> values = cnst->get_vector<T>();
+    for (T& value : values)
+    {
+        value = static_cast<T>(1) / value;
+    }
+    return op::Constant::create(cnst->get_element_type(), cnst->get_shape(), values);
+}
+
+//`simplify_divide` optimizes `x / c` into `x * (1 / c)` for floating point constants c,
+//possibly broadcast
+static bool simplify_divide(std::shared_ptr<Node> n)
+{
+    auto divisor = n->get_argument(1);
+    auto cnst = get_constant(divisor);
+    if (!cnst)
+    {
+        return false;
+    }
+
+    std::shared_ptr<Node> inverse;
+    if (cnst->get_element_type() == element::f32)
+    {
+        inverse = reciprocal<float>(cnst);
+    }
+    else if (cnst->get_element_type() == element::f64)
+    {
+        inverse = reciprocal<double>(cnst);
+    }
+    else
+    {
+        NGRAPH_DEBUG << n->get_name() << " isn't a floating point division";
+        return false;
+    }
+    if (auto broadcast = std::dynamic_pointer_cast<op::Broadcast>(divisor))
+    {
+        inverse = std::make_shared<op::Broadcast>(
+            inverse, broadcast->get_shape(), broadcast->get_broadcast_axes());
+    }
+    ngraph::replace_node(n, std::make_shared<op::Multiply>(n->get_argument(0), inverse));
+    return true;
+}
+
+//`simplify_power` optimizes `x ^ 1` into `x` and `x ^ 2` into `x * x`, for constant
+//exponents, possibly broadcast
+static bool simplify_power(std::shared_ptr<Node> n)
+{
+    auto x = n->get_argument(0);
+    auto cnst = get_constant(n->get_argument(1));
+    if (!cnst)
+    {
+        return false;
+    }
+    if (ngraph::is_one(cnst))
+    {
+        ngraph::replace_node(n, x);
+        return true;
+    }
+    if (ngraph::is_equal_to_const_value("2", cnst))
+    {
+        ngraph::replace_node(n, std::make_shared<op::Multiply>(x, x));
+        return true;
+    }
+    return false;
+}
+
+namespace
+{
+    struct SimplificationRule
+    {
+        const char* name;
+        std::type_index op;
+        std::function<bool(std::shared_ptr<Node>)> simplify;
+        // The rewrite can change results, so it is only applied with fast math
+        bool fast_math;
+    };
+}
+
+// Rules are tried in this order on every node of their op type until one applies
+static const std::vector<SimplificationRule> s_rules{
+    {"add_zero", TI(op::Add), simplify_add, false},
+    {"multiply_zero_or_one", TI(op::Multiply), simplify_multiply, false},
+    {"concat_slices", TI(op::Concat), simplify_concat, false},
+    {"sum_broadcast_constant",
+     TI(op::Sum),
+     simplify_reduction<op::Sum, get_sum_constant>,
+     false},
+    {"sum_broadcast", TI(op::Sum), simplify_sum_broadcast, false},
+    {"product_broadcast_constant",
+     TI(op::Product),
+     simplify_reduction<op::Product, get_prod_constant>,
+     false},
+    {"broadcast_broadcast", TI(op::Broadcast), simplify_broadcast_broadcast, false},
+    {"negative_negative", TI(op::Negative), simplify_negative, false},
+    {"divide_constant", TI(op::Divide), simplify_divide, true},
+    {"power_constant", TI(op::Power), simplify_power, false},
+    {"exp_log", TI(op::Exp), simplify_exp, true},
+    {"log_exp", TI(op::Log), simplify_log_exp, true},
+    {"log_exp_divide", TI(op::Log), simplify_log, false}};
+
+static std::unordered_map<std::type_index, std::vector<const SimplificationRule*>>
+    initialize_ops_to_rules()
+{
+    std::unordered_map<std::type_index, std::vector<const SimplificationRule*>> ops_to_rules;
+    for (const SimplificationRule& rule : s_rules)
+    {
+        ops_to_rules[rule.op].push_back(&rule);
+    }
+    return ops_to_rules;
+}
+
+static std::unordered_map<std::type_index, std::vector<const SimplificationRule*>>
+    ops_to_rules = initialize_ops_to_rules();
+
+// Rewrites can expose new matches, e.g. x / 1 becomes x * 1, so sweeps are repeated until
+// nothing changes
+static const size_t s_max_sweeps = 100;
 
 bool ngraph::pass::AlgebraicSimplification::run_on_function(std::shared_ptr<ngraph::Function> f)
 {
     bool replaced = false;
-    for (auto n : f->get_ordered_ops())
+    for (size_t sweep = 0; sweep < s_max_sweeps; sweep++)
     {
-        if (n->is_output() || n->is_parameter())
+        bool replaced_in_sweep = false;
+        for (auto n : f->get_ordered_ops())
         {
-            continue;
-        }
+            if (n->is_output() || n->is_parameter() || n->get_users().empty())
+            {
+                continue;
+            }
+
+            const Node& node = *n;
+            auto rules = ops_to_rules.find(TI(node));
+            if (rules == ops_to_rules.end())
+            {
+                continue;
+            }
 
-        const Node& node = *n;
-        auto eh = ops_to_simplifiers.find(TI(node));
-        if (eh == ops_to_simplifiers.end())
+            for (const SimplificationRule* rule : rules->second)
+            {
+                if (rule->fast_math && !m_fast_math)
+                {
+                    continue;
+                }
+                if (rule->simplify(n))
+                {
+                    NGRAPH_DEBUG << "Rule " << rule->name << " simplified " << n->get_name();
+                    m_rule_hits[rule->name]++;
+                    replaced_in_sweep = true;
+                    break;
+                }
+            }
+        }
+        if (!replaced_in_sweep)
         {
-            continue;
+            break;
         }
-
-        replaced = eh->second(n) || replaced;
+        replaced = true;
+    }
+    for (const auto& hits : m_rule_hits)
+    {
+        NGRAPH_DEBUG << "Algebraic simplification rule " << hits.first << ": " << hits.second;
     }
     return replaced;
 }
@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <map>
+#include <string>
+
 #include "ngraph/pass/pass.hpp"
 
 namespace ngraph
@@ -29,10 +32,21 @@ namespace ngraph
 class ngraph::pass::AlgebraicSimplification : public FunctionPass
 {
 public:
-    AlgebraicSimplification()
+    /// \param fast_math Also apply rewrites that can change results, such as exp(log(x))
+    ///        to x, which is wrong for x <= 0, and x / c to x * (1 / c), which rounds
+    ///        differently
+    AlgebraicSimplification(bool fast_math = false)
         : FunctionPass()
+        , m_fast_math(fast_math)
     {
     }
 
     virtual bool run_on_function(std::shared_ptr<ngraph::Function> f);
+
+    /// \brief Number of times each rule applied, by rule name, over all functions the pass
+    ///        ran on
+    const std::map<std::string, size_t>& get_rule_hits() const { return m_rule_hits; }
+private:
+    bool m_fast_math;
+    std::map<std::string, size_t> m_rule_hits;
 };
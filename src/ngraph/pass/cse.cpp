@@ -14,242 +14,152 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
-#include <set>
-#include <typeinfo>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "cse.hpp"
-#include "ngraph/axis_vector.hpp"
 #include "ngraph/graph_util.hpp"
 #include "ngraph/log.hpp"
-#include "ngraph/op/abs.hpp"
-#include "ngraph/op/abs.hpp"
-#include "ngraph/op/acos.hpp"
-#include "ngraph/op/add.hpp"
-#include "ngraph/op/asin.hpp"
-#include "ngraph/op/atan.hpp"
-#include "ngraph/op/broadcast.hpp"
-#include "ngraph/op/ceiling.hpp"
 #include "ngraph/op/constant.hpp"
-#include "ngraph/op/cos.hpp"
-#include "ngraph/op/cosh.hpp"
-#include "ngraph/op/divide.hpp"
-#include "ngraph/op/exp.hpp"
-#include "ngraph/op/floor.hpp"
-#include "ngraph/op/log.hpp"
-#include "ngraph/op/maximum.hpp"
-#include "ngraph/op/minimum.hpp"
-#include "ngraph/op/multiply.hpp"
-#include "ngraph/op/multiply.hpp"
-#include "ngraph/op/negative.hpp"
-#include "ngraph/op/power.hpp"
-#include "ngraph/op/product.hpp"
-#include "ngraph/op/relu.hpp"
-#include "ngraph/op/remainder.hpp"
-#include "ngraph/op/reshape.hpp"
-#include "ngraph/op/sigmoid.hpp"
-#include "ngraph/op/sign.hpp"
-#include "ngraph/op/sin.hpp"
-#include "ngraph/op/sinh.hpp"
-#include "ngraph/op/softmax.hpp"
-#include "ngraph/op/sqrt.hpp"
-#include "ngraph/op/subtract.hpp"
-#include "ngraph/op/sum.hpp"
-#include "ngraph/op/tan.hpp"
-#include "ngraph/op/tanh.hpp"
-#include "ngraph/pattern/matcher.hpp"
+#include "ngraph/serializer.hpp"
+#include "ngraph/util.hpp"
 
+using namespace std;
 using namespace ngraph;
 
-#define TI(x) std::type_index(typeid(x))
+// Constants up to this size are compared by value. The duplicates created by autodiff and
+// the frontends are scalars and small tensors; comparing weights would dominate the pass.
+static const size_t s_max_constant_bytes = 16 * 1024;
 
-static bool cse_reshape(std::shared_ptr<Node> a, std::shared_ptr<Node> b)
+namespace
 {
-    NGRAPH_DEBUG << "In cse_reshape for " << a->get_name() << " and " << b->get_name();
-
-    auto reshape_a = std::dynamic_pointer_cast<ngraph::op::Reshape>(a);
-    auto reshape_b = std::dynamic_pointer_cast<ngraph::op::Reshape>(b);
-
-    return (a->get_argument(0) == b->get_argument(0)) &&
-           (reshape_a->get_input_order() == reshape_b->get_input_order()) &&
-           (reshape_a->get_output_shape() == reshape_b->get_output_shape());
-}
-static bool cse_broadcast(std::shared_ptr<Node> a, std::shared_ptr<Node> b)
-{
-    NGRAPH_DEBUG << "In cse_broadcast for " << a->get_name() << " and " << b->get_name();
-
-    auto broadcast_a = std::dynamic_pointer_cast<ngraph::op::Broadcast>(a);
-    auto broadcast_b = std::dynamic_pointer_cast<ngraph::op::Broadcast>(b);
-
-    return (a->get_argument(0) == b->get_argument(0)) &&
-           (broadcast_a->get_broadcast_axes() == broadcast_b->get_broadcast_axes()) &&
-           (broadcast_a->get_broadcast_shape() == broadcast_b->get_broadcast_shape());
-}
-static bool cse_unarywise(std::shared_ptr<Node> a, std::shared_ptr<Node> b)
-{
-    NGRAPH_DEBUG << "In cse_unarywise for " << a->get_name() << " and " << b->get_name();
-
-    return a->get_argument(0) == b->get_argument(0);
-}
-
-static bool cse_binarywise(std::shared_ptr<Node> a, std::shared_ptr<Node> b)
-{
-    NGRAPH_DEBUG << "In cse_binary for " << a->get_name() << " and " << b->get_name();
-
-    return (a->get_argument(0) == b->get_argument(0) && a->get_argument(1) == b->get_argument(1)) ||
-           (a->get_argument(1) == b->get_argument(0) && a->get_argument(0) == b->get_argument(1));
-}
-
-static bool cse_reduction(std::shared_ptr<Node> a, std::shared_ptr<Node> b)
-{
-    NGRAPH_DEBUG << "In cse_reduction for " << a->get_name() << " and " << b->get_name();
-
-    auto ar_a = std::dynamic_pointer_cast<op::util::ArithmeticReduction>(a);
-    auto ar_b = std::dynamic_pointer_cast<op::util::ArithmeticReduction>(b);
+    // What a node computes: its op and attributes applied to the outputs of the nodes that
+    // represent its inputs. Nodes with equal keys compute equal values.
+    struct ValueKey
+    {
+        string op;
+        string attributes;
+        vector<pair<const Node*, size_t>> inputs;
+        const op::Constant* constant = nullptr;
+        size_t constant_size = 0;
+        size_t hash = 0;
+
+        bool operator==(const ValueKey& other) const
+        {
+            return hash == other.hash && op == other.op && attributes == other.attributes &&
+                   inputs == other.inputs && constant_size == other.constant_size &&
+                   (constant == nullptr ||
+                    memcmp(constant->get_data_ptr(),
+                           other.constant->get_data_ptr(),
+                           constant_size) == 0);
+        }
+    };
 
-    return ar_a->get_argument(0) == ar_b->get_argument(0) &&
-           ar_a->get_reduction_axes() == ar_b->get_reduction_axes();
+    struct ValueKeyHash
+    {
+        size_t operator()(const ValueKey& key) const { return key.hash; }
+    };
 }
 
-static std::unordered_map<std::type_index,
-                          std::function<bool(std::shared_ptr<Node>, std::shared_ptr<Node>)>>
-    initialize_ops_to_cse_handlers()
+static size_t hash_bytes(const void* data, size_t size)
 {
-    return std::unordered_map<std::type_index,
-                              std::function<bool(std::shared_ptr<Node>, std::shared_ptr<Node>)>>(
-        {{TI(op::Abs), cse_unarywise},
-         {TI(op::Acos), cse_unarywise},
-         {TI(op::Asin), cse_unarywise},
-         {TI(op::Atan), cse_unarywise},
-         {TI(op::Ceiling), cse_unarywise},
-         {TI(op::Cos), cse_unarywise},
-         {TI(op::Cosh), cse_unarywise},
-         {TI(op::Exp), cse_unarywise},
-         {TI(op::Floor), cse_unarywise},
-         {TI(op::Log), cse_unarywise},
-         {TI(op::Negative), cse_unarywise},
-         {TI(op::Relu), cse_unarywise},
-         {TI(op::Sigmoid), cse_unarywise},
-         {TI(op::Sign), cse_unarywise},
-         {TI(op::Sin), cse_unarywise},
-         {TI(op::Sinh), cse_unarywise},
-         //{TI(op::Softmax), cse_unarywise},
-         {TI(op::Sqrt), cse_unarywise},
-         {TI(op::Tan), cse_unarywise},
-         {TI(op::Tanh), cse_unarywise},
-         {TI(op::Add), cse_binarywise},
-         {TI(op::Divide), cse_binarywise},
-         {TI(op::Maximum), cse_binarywise},
-         {TI(op::Minimum), cse_binarywise},
-         {TI(op::Multiply), cse_binarywise},
-         {TI(op::Power), cse_binarywise},
-         //{TI(op::Remainder), cse_binarywise},
-         {TI(op::Subtract), cse_binarywise},
-         {TI(op::Sum), cse_reduction},
-         {TI(op::Product), cse_reduction},
-         {TI(op::Reshape), cse_reshape},
-         {TI(op::Broadcast), cse_broadcast}});
+    // FNV-1a
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash = (hash ^ p[i]) * 1099511628211ULL;
+    }
+    return static_cast<size_t>(hash);
 }
 
-static std::unordered_map<std::type_index,
-                          std::function<bool(std::shared_ptr<Node>, std::shared_ptr<Node>)>>
-    ops_to_cse_handlers = initialize_ops_to_cse_handlers();
-
-class NodeKey
+// Returns false for nodes that must not be merged: parameters, results, ops whose attributes
+// are not known to the serializer, and large constants
+static bool make_key(const shared_ptr<Node>& node, ValueKey& key)
 {
-public:
-    NodeKey(std::shared_ptr<Node> n)
-        : m_node(n)
+    if (node->is_output() || node->is_parameter() ||
+        !serialize_attributes(*node, key.attributes))
     {
+        return false;
     }
+    key.op = node->description();
 
-    std::shared_ptr<Node> get_node() const { return m_node; }
-    bool operator==(const NodeKey& other) const
+    for (const descriptor::Input& input : node->get_inputs())
     {
-        Node& p_this = *m_node.get();
-        Node& p_other = *other.get_node().get();
+        const descriptor::Output& output = input.get_output();
+        key.inputs.emplace_back(output.get_node().get(), output.get_index());
+    }
+    if (node->is_commutative())
+    {
+        sort(key.inputs.begin(), key.inputs.end());
+    }
 
-        if (TI(p_this) != TI(p_other))
-        {
-            return false;
-        }
+    vector<size_t> hashes{hash<string>()(key.op), hash<string>()(key.attributes)};
+    for (const auto& input : key.inputs)
+    {
+        hashes.push_back(hash<const Node*>()(input.first));
+        hashes.push_back(input.second);
+    }
 
-        auto eh = ops_to_cse_handlers.find(TI(p_this));
-        if (eh == ops_to_cse_handlers.end())
+    if (node->is_constant())
+    {
+        auto constant = static_pointer_cast<op::Constant>(node);
+        key.constant_size =
+            shape_size(constant->get_shape()) * constant->get_element_type().size();
+        if (key.constant_size > s_max_constant_bytes)
         {
             return false;
         }
-
-        return eh->second(m_node, other.get_node());
+        key.constant = constant.get();
+        hashes.push_back(hash_bytes(constant->get_data_ptr(), key.constant_size));
     }
 
-private:
-    std::shared_ptr<Node> m_node;
-};
-
-namespace std
-{
-    template <>
-    struct hash<NodeKey>
-    {
-        std::size_t operator()(const NodeKey& k) const
-        {
-            Node& p_this = *k.get_node().get();
-            auto ti = TI(p_this);
-
-            std::hash<std::type_index> type_hash_compute{};
-            auto type_hash = type_hash_compute(ti);
-
-            std::vector<size_t> arg_ids;
-
-            arg_ids.push_back(type_hash);
-
-            auto cargs = k.get_node()->get_arguments();
-
-            //TODO: Do we need another map, so we could
-            //specify how to compute hash for each op?
-            if (p_this.is_commutative())
-            {
-                std::sort(begin(cargs), end(cargs));
-            }
-
-            for (auto arg : cargs)
-            {
-                arg_ids.push_back(arg->get_instance_id());
-            }
-
-            auto hashc = ngraph::hash_combine(arg_ids);
-            return hashc;
-        }
-    };
+    key.hash = hash_combine(hashes);
+    return true;
 }
 
 bool ngraph::pass::CommonSubexpressionElimination::run_on_function(
     std::shared_ptr<ngraph::Function> f)
 {
-    bool replaced = false;
-    std::unordered_map<NodeKey, std::shared_ptr<Node>> expressions{};
-
-    for (auto n : f->get_ordered_ops())
+    // Global value numbering in one topological pass. The inputs of a node have been merged
+    // into their representatives by the time the node is visited, so comparing input nodes
+    // by identity finds equal expressions of any depth.
+    unordered_map<ValueKey, shared_ptr<Node>, ValueKeyHash> values;
+    size_t eliminated_node_count = 0;
+    size_t eliminated_bytes = 0;
+
+    for (shared_ptr<Node> n : f->get_ordered_ops())
     {
-        if (n->is_output() || n->is_parameter() ||
-            n->is_constant() /*we could CSE constants as well*/)
+        ValueKey key;
+        if (!make_key(n, key))
         {
             continue;
         }
 
-        NodeKey n_key{n};
-        if (expressions.count(n_key))
+        auto it = values.find(key);
+        if (it == values.end())
         {
-            ngraph::replace_node(n, expressions.at(n_key));
-            replaced = true;
+            values.insert(make_pair(move(key), n));
+            continue;
         }
-        else
+
+        NGRAPH_DEBUG << "CSE replacing " << n->get_name() << " with " << it->second->get_name();
+        for (size_t i = 0; i < n->get_output_size(); i++)
         {
-            expressions.insert(std::make_pair(n_key, n));
+            eliminated_bytes +=
+                shape_size(n->get_output_shape(i)) * n->get_output_element_type(i).size();
         }
+        eliminated_node_count++;
+        ngraph::replace_node(n, it->second);
     }
 
-    return replaced;
+    NGRAPH_DEBUG << "CSE eliminated " << eliminated_node_count << " nodes, "
+                 << eliminated_bytes << " bytes of intermediates in " << f->get_name();
+    m_eliminated_node_count += eliminated_node_count;
+    m_eliminated_bytes += eliminated_bytes;
+    return eliminated_node_count > 0;
 }
@@ -26,6 +26,12 @@ namespace ngraph
     }
 }
 
+/// \brief Merges nodes that compute the same value.
+///
+/// Nodes are value numbered in one pass over the ops in topological order. Two nodes are
+/// equal when they have the same op type, the same attributes as written by the serializer
+/// and the same inputs, in any order for commutative ops. Small constants are compared by
+/// value. Ops the serializer does not know, such as backend fused ops, are left alone.
 class ngraph::pass::CommonSubexpressionElimination : public FunctionPass
 {
 public:
@@ -35,4 +41,12 @@ public:
     }
 
     virtual bool run_on_function(std::shared_ptr<ngraph::Function> f);
+
+    /// \brief Number of nodes replaced, over all functions the pass ran on
+    size_t get_eliminated_node_count() const { return m_eliminated_node_count; }
+    /// \brief Size in bytes of the outputs of the replaced nodes
+    size_t get_eliminated_bytes() const { return m_eliminated_bytes; }
+private:
+    size_t m_eliminated_node_count = 0;
+    size_t m_eliminated_bytes = 0;
 };
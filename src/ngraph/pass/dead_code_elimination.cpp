@@ -0,0 +1,190 @@
+/*******************************************************************************
+* Copyright 2017-2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <functional>
+#include <set>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "dead_code_elimination.hpp"
+#include "ngraph/graph_util.hpp"
+#include "ngraph/log.hpp"
+#include "ngraph/op/function_call.hpp"
+#include "ngraph/op/get_output_element.hpp"
+#include "ngraph/pass/manager_state.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+#define TI(x) type_index(typeid(x))
+
+// Builds a replacement for a multi-output node that computes only the outputs listed in
+// used, in that order, or returns nullptr if the op has no such variant
+using OutputPruner =
+    function<shared_ptr<Node>(const shared_ptr<Node>& node, const vector<size_t>& used)>;
+
+static shared_ptr<Node> prune_function_call(const shared_ptr<Node>& node,
+                                            const vector<size_t>& used)
+{
+    // The function may be called from elsewhere with all outputs used, so prune a copy
+    shared_ptr<Function> clone = clone_function(*node->get_functions().at(0));
+    ResultVector results;
+    for (size_t i : used)
+    {
+        results.push_back(clone->get_results().at(i));
+    }
+    auto pruned = make_shared<Function>(results, clone->get_parameters());
+    return make_shared<op::FunctionCall>(pruned, node->get_arguments());
+}
+
+static const unordered_map<type_index, OutputPruner> s_output_pruners{
+    {TI(op::FunctionCall), prune_function_call}};
+
+static unordered_set<Node*> get_live_nodes(const vector<shared_ptr<Function>>& functions)
+{
+    unordered_set<Node*> live;
+    for (const shared_ptr<Function>& f : functions)
+    {
+        for (const shared_ptr<Node>& node : f->get_ordered_ops())
+        {
+            live.insert(node.get());
+        }
+    }
+    return live;
+}
+
+// Returns the indices of the outputs of node read by live nodes
+static vector<size_t> get_used_outputs(const shared_ptr<Node>& node,
+                                       const unordered_set<Node*>& live)
+{
+    vector<bool> is_used(node->get_output_size(), false);
+    for (const shared_ptr<Node>& user : node->get_users())
+    {
+        if (live.count(user.get()) == 0)
+        {
+            continue;
+        }
+        if (auto goe = dynamic_pointer_cast<op::GetOutputElement>(user))
+        {
+            is_used.at(goe->get_n()) = true;
+        }
+        else
+        {
+            // Anything but GetOutputElement reads every output
+            fill(is_used.begin(), is_used.end(), true);
+        }
+    }
+    vector<size_t> used;
+    for (size_t i = 0; i < is_used.size(); i++)
+    {
+        if (is_used[i])
+        {
+            used.push_back(i);
+        }
+    }
+    return used;
+}
+
+static bool prune_outputs(const shared_ptr<Node>& node, const unordered_set<Node*>& live)
+{
+    auto handler = s_output_pruners.find(TI(*node));
+    if (handler == s_output_pruners.end())
+    {
+        return false;
+    }
+    vector<size_t> used = get_used_outputs(node, live);
+    if (used.size() == node->get_output_size())
+    {
+        return false;
+    }
+    shared_ptr<Node> replacement = handler->second(node, used);
+    if (!replacement)
+    {
+        return false;
+    }
+
+    NGRAPH_DEBUG << "Replacing " << node->get_name() << " with " << replacement->get_name()
+                 << ", which computes " << used.size() << " of " << node->get_output_size()
+                 << " outputs";
+    // A GetOutputElement reads every output, so it is listed once per output
+    NodeVector users = node->get_users();
+    set<shared_ptr<Node>> unique_users(users.begin(), users.end());
+    for (const shared_ptr<Node>& user : unique_users)
+    {
+        auto goe = dynamic_pointer_cast<op::GetOutputElement>(user);
+        if (!goe || live.count(goe.get()) == 0)
+        {
+            continue;
+        }
+        size_t n = find(used.begin(), used.end(), goe->get_n()) - used.begin();
+        if (replacement->get_output_size() == 1)
+        {
+            replace_node(goe, replacement);
+        }
+        else
+        {
+            replace_node(goe, make_shared<op::GetOutputElement>(replacement, n));
+        }
+    }
+    return true;
+}
+
+bool pass::DeadCodeElimination::run_on_module(vector<shared_ptr<Function>>& functions)
+{
+    if (functions.empty())
+    {
+        return false;
+    }
+    bool modified = false;
+
+    unordered_set<Node*> live = get_live_nodes(functions);
+    for (const shared_ptr<Function>& f : functions)
+    {
+        for (const shared_ptr<Node>& node : f->get_ordered_ops())
+        {
+            if (node->get_output_size() > 1 && prune_outputs(node, live))
+            {
+                m_rewritten_node_count++;
+                modified = true;
+            }
+        }
+    }
+
+    // Pruned calls run copies of their functions, which join the module, and the original
+    // functions may no longer be called
+    vector<shared_ptr<Function>> called;
+    traverse_functions(functions.at(0), [&](shared_ptr<Function> f) { called.push_back(f); });
+    if (called != functions)
+    {
+        unordered_set<shared_ptr<Function>> still_called(called.begin(), called.end());
+        size_t removed = count_if(functions.begin(), functions.end(), [&](shared_ptr<Function> f) {
+            return still_called.count(f) == 0;
+        });
+        NGRAPH_DEBUG << "Removing " << removed << " functions no longer called";
+        m_removed_function_count += removed;
+        functions = called;
+        if (has_state())
+        {
+            get_state().set_functions(functions);
+        }
+        modified = true;
+    }
+
+    return modified;
+}
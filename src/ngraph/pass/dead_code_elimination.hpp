@@ -0,0 +1,50 @@
+/*******************************************************************************
+* Copyright 2017-2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#pragma once
+
+#include "ngraph/pass/pass.hpp"
+
+namespace ngraph
+{
+    namespace pass
+    {
+        class DeadCodeElimination;
+    }
+}
+
+/// \brief Removes computations whose results are not used.
+///
+/// Only outputs read by nodes reachable from the results of a function in the module count
+/// as used. A FunctionCall with unused outputs is replaced by a call to a copy of its
+/// function without the unused results, and the copy is added to the module. Functions that
+/// are no longer called are removed from the module.
+///
+/// Nodes the module does not compute, such as adjoints the caller still holds, stay
+/// connected, so they can still be used to build other functions.
+class ngraph::pass::DeadCodeElimination : public ModulePass
+{
+public:
+    virtual bool run_on_module(std::vector<std::shared_ptr<ngraph::Function>>&) override;
+
+    /// \brief Number of multi-output nodes replaced by variants with fewer outputs
+    size_t get_rewritten_node_count() const { return m_rewritten_node_count; }
+    /// \brief Number of functions removed from the module
+    size_t get_removed_function_count() const { return m_removed_function_count; }
+private:
+    size_t m_rewritten_node_count = 0;
+    size_t m_removed_function_count = 0;
+};
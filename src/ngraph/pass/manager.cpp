@@ -19,6 +19,7 @@
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <sstream>
 
 #include "ngraph/function.hpp"
 #include "ngraph/graph_util.hpp"
@@ -46,6 +47,35 @@ ngraph::pass::Manager::Manager()
     {
         m_serialize = true;
     }
+    static const auto npt = std::getenv("NGRAPH_PASS_TIMING");
+    if (npt)
+    {
+        m_timing = true;
+    }
+}
+
+static string get_pass_name(pass::PassBase& pass)
+{
+    string name = typeid(pass).name();
+    int status;
+    char* demangled = abi::__cxa_demangle(name.c_str(), 0, 0, &status);
+    if (demangled)
+    {
+        name = demangled;
+        free(demangled);
+    }
+    return name;
+}
+
+// Counts the ops of all functions
+static size_t count_ops(const vector<shared_ptr<Function>>& fs)
+{
+    size_t count = 0;
+    for (shared_ptr<Function> f : fs)
+    {
+        traverse_nodes(f, [&](shared_ptr<Node> node) { count++; });
+    }
+    return count;
 }
 
 ngraph::pass::Manager::~Manager()
@@ -77,6 +107,8 @@ void ngraph::pass::Manager::run_passes(shared_ptr<Function> func, bool transitiv
     stopwatch pass_timer;
     stopwatch overall_timer;
     overall_timer.start();
+    m_pass_statistics.clear();
+    size_t ops = m_timing ? count_ops(fs) : 0;
     for (shared_ptr<PassBase> pass : m_pass_list)
     {
         pass_timer.start();
@@ -138,19 +170,42 @@ void ngraph::pass::Manager::run_passes(shared_ptr<Function> func, bool transitiv
         }
         index++;
         pass_timer.stop();
+
+        PassStatistics stats;
+        stats.name = get_pass_name(*pass);
+        stats.time_us = pass_timer.get_microseconds();
+        stats.ops_before = ops;
+        if (m_timing)
+        {
+            // functions may have been added or removed by the pass
+            ops = count_ops(get_state().get_functions());
+        }
+        stats.ops_after = ops;
+        m_pass_statistics.push_back(stats);
         if (profile_enabled)
         {
-            PassBase* p = pass.get();
-            string name = typeid(*p).name();
-            int status;
-            name = abi::__cxa_demangle(name.c_str(), 0, 0, &status);
-            cout << setw(7) << pass_timer.get_milliseconds() << "ms " << name << "\n";
+            cout << setw(7) << pass_timer.get_milliseconds() << "ms " << stats.name << "\n";
         }
     }
     if (profile_enabled)
     {
         cout << "passes done in " << overall_timer.get_milliseconds() << "ms\n";
     }
+    if (m_timing)
+    {
+        stringstream ss;
+        ss << setw(10) << "time(ms)" << setw(12) << "ops before" << setw(12) << "ops after"
+           << "  pass\n";
+        ss << fixed << setprecision(3);
+        for (const PassStatistics& stats : m_pass_statistics)
+        {
+            ss << setw(10) << stats.time_us / 1000.0 << setw(12) << stats.ops_before << setw(12)
+               << stats.ops_after << "  " << stats.name << "\n";
+        }
+        ss << setw(10) << overall_timer.get_microseconds() / 1000.0 << "  total for "
+           << m_pass_statistics.size() << " passes\n";
+        cout << ss.str();
+    }
 }
 
 ngraph::pass::ManagerState& ngraph::pass::Manager::get_state()
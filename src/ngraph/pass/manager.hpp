@@ -18,6 +18,7 @@
 
 #include <list>
 #include <memory>
+#include <string>
 #include <typeinfo>
 #include <vector>
 
@@ -33,9 +34,23 @@ namespace ngraph
     }
 }
 
+/// \brief Runs registered passes over a function and the functions it calls.
+///
+/// With pass timing enabled (set_pass_timing or NGRAPH_PASS_TIMING), the time and the op
+/// count before and after every pass are collected, and a table of all statistics is
+/// printed after the passes.
 class ngraph::pass::Manager
 {
 public:
+    struct PassStatistics
+    {
+        std::string name;
+        size_t time_us;
+        /// Ops in all functions before and after the pass
+        size_t ops_before;
+        size_t ops_after;
+    };
+
     Manager();
     ~Manager();
 
@@ -59,10 +74,15 @@ public:
     ManagerState& get_state();
     void set_pass_visualization(bool new_state) { m_visualize = new_state; }
     void set_pass_serialization(bool new_state) { m_serialize = new_state; }
+    void set_pass_timing(bool new_state) { m_timing = new_state; }
+    /// \brief Statistics of the passes of the last run_passes call, in run order
+    const std::vector<PassStatistics>& get_pass_statistics() const { return m_pass_statistics; }
 private:
     std::vector<std::string> m_pass_names;
     std::vector<std::shared_ptr<PassBase>> m_pass_list;
     ManagerState m_state;
+    std::vector<PassStatistics> m_pass_statistics;
     bool m_visualize = false;
     bool m_serialize = false;
+    bool m_timing = false;
 };
@@ -21,9 +21,11 @@
 
 #include "memory_visualize.hpp"
 #include "ngraph/descriptor/tensor.hpp"
+#include "ngraph/file_util.hpp"
 #include "ngraph/function.hpp"
 #include "ngraph/graph_util.hpp"
 #include "ngraph/node.hpp"
+#include "ngraph/runtime/memory_stats.hpp"
 #include "ngraph/util.hpp"
 
 using namespace std;
@@ -37,6 +39,11 @@ pass::MemoryVisualize::MemoryVisualize(const string& filename)
 bool pass::MemoryVisualize::run_on_module(vector<shared_ptr<ngraph::Function>>& functions)
 {
     ofstream file(m_filename);
+    if (file_util::get_file_ext(m_filename) == ".json")
+    {
+        write_json(file, functions);
+        return false;
+    }
     {
         for (shared_ptr<Function> f : functions)
         {
@@ -95,6 +102,20 @@ bool pass::MemoryVisualize::run_on_module(vector<shared_ptr<ngraph::Function>>&
     return false;
 }
 
+void pass::MemoryVisualize::write_json(ostream& file,
+                                       const vector<shared_ptr<ngraph::Function>>& functions)
+{
+    file << "{";
+    bool first = true;
+    for (shared_ptr<Function> f : functions)
+    {
+        file << (first ? "\n" : ",\n") << "\"" << f->get_name() << "\": ";
+        runtime::MemoryStats::from_function(f).write_json(file);
+        first = false;
+    }
+    file << "\n}\n";
+}
+
 unordered_set<const descriptor::Tensor*>
     pass::MemoryVisualize::find_largest_op(const list<shared_ptr<Node>>& nodes)
 {
@@ -30,6 +30,9 @@ namespace ngraph
     }
 }
 
+/// \brief Draws the memory use of the functions as HTML. With a .json filename the
+///        runtime::MemoryStats of each function are written as JSON instead, keyed by
+///        function name. Run after pass::Liveness.
 class ngraph::pass::MemoryVisualize : public ModulePass
 {
 public:
@@ -39,6 +42,8 @@ public:
 private:
     std::unordered_set<const descriptor::Tensor*>
         find_largest_op(const std::list<std::shared_ptr<Node>>& nodes);
+    void write_json(std::ostream& file,
+                    const std::vector<std::shared_ptr<ngraph::Function>>& functions);
     void draw_tensor_weight(std::ostream& file, const std::list<std::shared_ptr<Node>>& nodes);
     void draw_histogram(std::ostream& file, const std::list<std::shared_ptr<Node>>& nodes);
     void draw_op_influence(std::ostream& file, const std::list<std::shared_ptr<Node>>& nodes);
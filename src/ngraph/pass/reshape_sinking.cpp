@@ -0,0 +1,385 @@
+/*******************************************************************************
+* Copyright 2017-2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <numeric>
+#include <set>
+#include <unordered_map>
+
+#include "ngraph/graph_util.hpp"
+#include "ngraph/log.hpp"
+#include "ngraph/op/broadcast.hpp"
+#include "ngraph/op/max.hpp"
+#include "ngraph/op/min.hpp"
+#include "ngraph/op/product.hpp"
+#include "ngraph/op/reshape.hpp"
+#include "ngraph/op/softmax.hpp"
+#include "ngraph/op/sum.hpp"
+#include "ngraph/op/util/arithmetic_reduction.hpp"
+#include "ngraph/op/util/binary_elementwise.hpp"
+#include "ngraph/op/util/unary_elementwise.hpp"
+#include "reshape_sinking.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+namespace
+{
+    // The value of a node expressed as Reshape(source, order, <shape of the node>)
+    struct Transpose
+    {
+        shared_ptr<Node> source;
+        AxisVector order;
+        // Node computing the value, created when a consumer needs it
+        shared_ptr<Node> value;
+    };
+
+    using TransposeMap = unordered_map<Node*, Transpose>;
+}
+
+static AxisVector identity_order(size_t rank)
+{
+    AxisVector order(rank);
+    iota(order.begin(), order.end(), 0);
+    return order;
+}
+
+static bool is_identity(const AxisVector& order)
+{
+    return order == identity_order(order.size());
+}
+
+// Reshapes that only permute axes
+static bool is_pure_transpose(const shared_ptr<op::Reshape>& reshape)
+{
+    const Shape& in_shape = reshape->get_argument(0)->get_shape();
+    const Shape& out_shape = reshape->get_output_shape();
+    const AxisVector& order = reshape->get_input_order();
+    if (in_shape.size() != out_shape.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        if (out_shape[i] != in_shape[order[i]])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Order of Reshape(Reshape(x, first, ...), second, ...) as a single Reshape of x
+static AxisVector combine(const AxisVector& first, const AxisVector& second)
+{
+    AxisVector order(second.size());
+    for (size_t i = 0; i < second.size(); i++)
+    {
+        order[i] = first.at(second[i]);
+    }
+    return order;
+}
+
+static shared_ptr<Node> materialize(const shared_ptr<Node>& node, TransposeMap& transposes)
+{
+    auto it = transposes.find(node.get());
+    if (it == transposes.end())
+    {
+        return node;
+    }
+    Transpose& t = it->second;
+    if (!t.value)
+    {
+        t.value = is_identity(t.order)
+                      ? t.source
+                      : make_shared<op::Reshape>(t.source, t.order, node->get_shape());
+    }
+    return t.value;
+}
+
+// The argument of user as a Transpose. A transpose is carried past arg only if user is its
+// only consumer; otherwise arg is materialized and returned untransposed.
+static Transpose get_argument(const shared_ptr<Node>& arg,
+                              const shared_ptr<Node>& user,
+                              TransposeMap& transposes)
+{
+    auto it = transposes.find(arg.get());
+    if (it != transposes.end())
+    {
+        NodeVector users = arg->get_users();
+        set<shared_ptr<Node>> unique_users(users.begin(), users.end());
+        if (is_identity(it->second.order) ||
+            (unique_users.size() == 1 && *unique_users.begin() == user))
+        {
+            return it->second;
+        }
+    }
+    shared_ptr<Node> value = materialize(arg, transposes);
+    return Transpose{value, identity_order(value->get_shape().size()), value};
+}
+
+// A Broadcast in the layout given by order, so that Reshape(result, order, ...) equals
+// broadcast, or nullptr if the broadcast axes cannot be permuted that way
+static shared_ptr<Node> permute_broadcast(const shared_ptr<Node>& node,
+                                          const AxisVector& order,
+                                          const Shape& shape)
+{
+    auto broadcast = dynamic_pointer_cast<op::Broadcast>(node);
+    if (!broadcast)
+    {
+        return nullptr;
+    }
+    // The argument axes land on the non-broadcast axes, which must keep their order
+    AxisSet broadcast_axes;
+    for (size_t i = 0; i < shape.size(); i++)
+    {
+        broadcast_axes.insert(i);
+    }
+    size_t previous = 0;
+    bool first = true;
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        if (broadcast->get_broadcast_axes().count(i) == 0)
+        {
+            if (!first && order[i] < previous)
+            {
+                return nullptr;
+            }
+            previous = order[i];
+            first = false;
+            broadcast_axes.erase(order[i]);
+        }
+    }
+    return make_shared<op::Broadcast>(broadcast->get_argument(0), shape, broadcast_axes);
+}
+
+static shared_ptr<Node> make_reduction(const shared_ptr<Node>& node,
+                                       const shared_ptr<Node>& arg,
+                                       const AxisSet& axes)
+{
+    if (dynamic_pointer_cast<op::Sum>(node))
+    {
+        return make_shared<op::Sum>(arg, axes);
+    }
+    if (dynamic_pointer_cast<op::Product>(node))
+    {
+        return make_shared<op::Product>(arg, axes);
+    }
+    if (dynamic_pointer_cast<op::Max>(node))
+    {
+        return make_shared<op::Max>(arg, axes);
+    }
+    if (dynamic_pointer_cast<op::Min>(node))
+    {
+        return make_shared<op::Min>(arg, axes);
+    }
+    return nullptr;
+}
+
+static bool sink_reshape(const shared_ptr<op::Reshape>& reshape, TransposeMap& transposes)
+{
+    shared_ptr<Node> arg = reshape->get_argument(0);
+    if (transposes.count(arg.get()) == 0)
+    {
+        if (reshape->get_is_transpose() && is_pure_transpose(reshape))
+        {
+            transposes[reshape.get()] = Transpose{arg, reshape->get_input_order(), reshape};
+            return true;
+        }
+        return false;
+    }
+
+    Transpose t = get_argument(arg, reshape, transposes);
+    AxisVector order = combine(t.order, reshape->get_input_order());
+    if (is_pure_transpose(reshape))
+    {
+        transposes[reshape.get()] = Transpose{t.source, order, nullptr};
+    }
+    else
+    {
+        auto combined = make_shared<op::Reshape>(t.source, order, reshape->get_output_shape());
+        transposes[reshape.get()] =
+            Transpose{combined, identity_order(combined->get_shape().size()), combined};
+    }
+    return true;
+}
+
+static bool sink_unary(const shared_ptr<Node>& node, TransposeMap& transposes)
+{
+    shared_ptr<Node> arg = node->get_argument(0);
+    if (transposes.count(arg.get()) == 0)
+    {
+        return false;
+    }
+    Transpose t = get_argument(arg, node, transposes);
+    if (t.source == arg)
+    {
+        return false;
+    }
+    shared_ptr<Node> new_node;
+    if (auto softmax = dynamic_pointer_cast<op::Softmax>(node))
+    {
+        // Softmax normalizes over axes of its output, which are other axes of the source
+        AxisSet axes;
+        for (size_t axis : softmax->get_axes())
+        {
+            axes.insert(t.order.at(axis));
+        }
+        new_node = make_shared<op::Softmax>(t.source, axes);
+    }
+    else
+    {
+        new_node = node->copy_with_new_args({t.source});
+    }
+    transposes[node.get()] = Transpose{new_node, t.order, nullptr};
+    return true;
+}
+
+static bool sink_binary(const shared_ptr<Node>& node, TransposeMap& transposes)
+{
+    shared_ptr<Node> arg0 = node->get_argument(0);
+    shared_ptr<Node> arg1 = node->get_argument(1);
+    if (transposes.count(arg0.get()) == 0 && transposes.count(arg1.get()) == 0)
+    {
+        return false;
+    }
+    Transpose t0 = get_argument(arg0, node, transposes);
+    Transpose t1 = get_argument(arg1, node, transposes);
+    shared_ptr<Node> source0 = t0.source;
+    shared_ptr<Node> source1 = t1.source;
+    AxisVector order = t0.order;
+    if (t0.order != t1.order)
+    {
+        if (is_identity(t1.order))
+        {
+            source1 = permute_broadcast(t1.source, t0.order, t0.source->get_shape());
+        }
+        else if (is_identity(t0.order))
+        {
+            source0 = permute_broadcast(t0.source, t1.order, t1.source->get_shape());
+            order = t1.order;
+        }
+        else
+        {
+            source0 = nullptr;
+        }
+        if (!source0 || !source1)
+        {
+            return false;
+        }
+    }
+    if (source0 == arg0 && source1 == arg1)
+    {
+        return false;
+    }
+    transposes[node.get()] =
+        Transpose{node->copy_with_new_args({source0, source1}), order, nullptr};
+    return true;
+}
+
+static bool sink_reduction(const shared_ptr<op::util::ArithmeticReduction>& reduction,
+                           TransposeMap& transposes)
+{
+    shared_ptr<Node> arg = reduction->get_argument(0);
+    if (transposes.count(arg.get()) == 0)
+    {
+        return false;
+    }
+    Transpose t = get_argument(arg, reduction, transposes);
+    if (t.source == arg)
+    {
+        return false;
+    }
+
+    // Reduce the source over the axes the transpose maps the reduction axes to. The
+    // remaining source axes are then in source order and still need to be permuted.
+    AxisSet axes;
+    for (size_t axis : reduction->get_reduction_axes())
+    {
+        axes.insert(t.order.at(axis));
+    }
+    shared_ptr<Node> new_reduction = make_reduction(reduction, t.source, axes);
+    if (!new_reduction)
+    {
+        return false;
+    }
+    AxisVector remaining;
+    for (size_t i = 0; i < t.order.size(); i++)
+    {
+        if (reduction->get_reduction_axes().count(i) == 0)
+        {
+            remaining.push_back(t.order[i]);
+        }
+    }
+    AxisVector sorted = remaining;
+    sort(sorted.begin(), sorted.end());
+    AxisVector order;
+    for (size_t axis : remaining)
+    {
+        order.push_back(find(sorted.begin(), sorted.end(), axis) - sorted.begin());
+    }
+    transposes[reduction.get()] = Transpose{new_reduction, order, nullptr};
+    return true;
+}
+
+bool ngraph::pass::ReshapeSinking::run_on_function(shared_ptr<Function> f)
+{
+    TransposeMap transposes;
+    bool modified = false;
+
+    for (shared_ptr<Node> n : f->get_ordered_ops())
+    {
+        bool sunk = false;
+        if (auto reshape = dynamic_pointer_cast<op::Reshape>(n))
+        {
+            sunk = sink_reshape(reshape, transposes);
+        }
+        else if (dynamic_pointer_cast<op::util::UnaryElementwise>(n))
+        {
+            sunk = sink_unary(n, transposes);
+        }
+        else if (dynamic_pointer_cast<op::util::BinaryElementwise>(n))
+        {
+            sunk = sink_binary(n, transposes);
+        }
+        else if (auto reduction = dynamic_pointer_cast<op::util::ArithmeticReduction>(n))
+        {
+            sunk = sink_reduction(reduction, transposes);
+        }
+        if (sunk)
+        {
+            continue;
+        }
+
+        // Apply pending transposes to the arguments of consumers that cannot take them
+        for (descriptor::Input& input : n->get_inputs())
+        {
+            shared_ptr<Node> arg = input.get_output().get_node();
+            if (transposes.count(arg.get()) != 0)
+            {
+                shared_ptr<Node> value = materialize(arg, transposes);
+                if (value != arg)
+                {
+                    NGRAPH_DEBUG << "Reshape sinking: " << n->get_name() << " now reads "
+                                 << value->get_name() << " instead of " << arg->get_name();
+                    input.replace_output(value, 0);
+                    modified = true;
+                }
+            }
+        }
+    }
+    return modified;
+}
@@ -0,0 +1,49 @@
+/*******************************************************************************
+* Copyright 2017-2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#pragma once
+
+#include "ngraph/pass/pass.hpp"
+
+namespace ngraph
+{
+    namespace pass
+    {
+        class ReshapeSinking;
+    }
+}
+
+/// \brief Moves transposing Reshapes down the graph so they cancel or merge.
+///
+/// A transpose is carried through elementwise ops and reductions, which then compute on the
+/// untransposed data. Transposes meeting another Reshape are combined into one Reshape, and
+/// inverse pairs disappear. Elementwise ops with one transposed argument absorb the transpose
+/// when the other argument is a Broadcast that can be built in the untransposed layout.
+/// Transposes that cannot be carried further are applied right before the consumer, where
+/// backend passes can fold them, for example into the transpose flags of a matrix multiply.
+///
+/// A transpose is only carried past a value that has no other users, so the pass never adds
+/// copies.
+class ngraph::pass::ReshapeSinking : public FunctionPass
+{
+public:
+    ReshapeSinking()
+        : FunctionPass()
+    {
+    }
+
+    virtual bool run_on_function(std::shared_ptr<ngraph::Function> f) override;
+};
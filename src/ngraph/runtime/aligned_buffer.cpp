@@ -17,28 +17,94 @@
 #include <cstdlib> // llvm 8.1 gets confused about `malloc` otherwise
 #include <memory>
 
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "ngraph/log.hpp"
 #include "ngraph/runtime/aligned_buffer.hpp"
 
 using namespace ngraph;
 
+#ifdef __linux__
+// Maps size bytes whose pages are placed on numa_node when first touched. Uses the raw
+// syscall so there is no dependency on libnuma. Returns nullptr on failure. bound is set
+// if the kernel applied the placement.
+static char* map_numa_memory(size_t size, int numa_node, bool& bound)
+{
+    const int mpol_preferred = 1;
+    const unsigned long mpol_f_addr = 2;
+    const size_t bits_per_word = 8 * sizeof(unsigned long);
+    if (numa_node < 0 || numa_node >= 1024)
+    {
+        return nullptr;
+    }
+    void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED)
+    {
+        return nullptr;
+    }
+    unsigned long node_mask[1024 / bits_per_word] = {};
+    node_mask[numa_node / bits_per_word] = 1UL << (numa_node % bits_per_word);
+    if (syscall(SYS_mbind, memory, size, mpol_preferred, node_mask, 1024, 0) == 0)
+    {
+        // A node the process may not use turns the policy into local allocation without an
+        // error, so read back what the kernel applied
+        int mode = -1;
+        unsigned long applied_mask[1024 / bits_per_word] = {};
+        bound = syscall(SYS_get_mempolicy, &mode, applied_mask, 1024, memory, mpol_f_addr) == 0 &&
+                mode == mpol_preferred &&
+                (applied_mask[numa_node / bits_per_word] & node_mask[numa_node / bits_per_word]);
+    }
+    if (!bound)
+    {
+        NGRAPH_WARN << "Unable to bind memory to NUMA node " << numa_node;
+    }
+    return static_cast<char*>(memory);
+}
+#endif
+
 runtime::AlignedBuffer::AlignedBuffer()
     : m_allocated_buffer(nullptr)
     , m_aligned_buffer(nullptr)
+    , m_byte_size(0)
+    , m_mapped_size(0)
+    , m_numa_node(-1)
 {
 }
 
-runtime::AlignedBuffer::AlignedBuffer(size_t byte_size, size_t alignment)
+runtime::AlignedBuffer::AlignedBuffer(size_t byte_size, size_t alignment, int numa_node)
+    : AlignedBuffer()
 {
-    initialize(byte_size, alignment);
+    initialize(byte_size, alignment, numa_node);
 }
 
-void runtime::AlignedBuffer::initialize(size_t byte_size, size_t alignment)
+void runtime::AlignedBuffer::initialize(size_t byte_size, size_t alignment, int numa_node)
 {
     m_byte_size = byte_size;
     if (m_byte_size > 0)
     {
         size_t allocation_size = m_byte_size + alignment;
-        m_allocated_buffer = static_cast<char*>(malloc(allocation_size));
+#ifdef __linux__
+        if (numa_node >= 0)
+        {
+            size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            size_t mapped_size = ((allocation_size + page_size - 1) / page_size) * page_size;
+            bool bound = false;
+            m_allocated_buffer = map_numa_memory(mapped_size, numa_node, bound);
+            if (m_allocated_buffer)
+            {
+                m_mapped_size = mapped_size;
+                m_numa_node = bound ? numa_node : -1;
+            }
+        }
+#endif
+        if (m_allocated_buffer == nullptr)
+        {
+            m_allocated_buffer = static_cast<char*>(malloc(allocation_size));
+        }
         m_aligned_buffer = m_allocated_buffer;
         size_t mod = size_t(m_aligned_buffer) % alignment;
 
@@ -51,6 +117,13 @@ void runtime::AlignedBuffer::initialize(size_t byte_size, size_t alignment)
 
 runtime::AlignedBuffer::~AlignedBuffer()
 {
+#ifdef __linux__
+    if (m_mapped_size > 0)
+    {
+        munmap(m_allocated_buffer, m_mapped_size);
+        return;
+    }
+#endif
     if (m_allocated_buffer != nullptr)
     {
         free(m_allocated_buffer);
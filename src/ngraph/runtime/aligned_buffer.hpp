@@ -29,19 +29,26 @@ namespace ngraph
 /// @brief Allocates a block of memory on the specified alignment. The actual size of the
 /// allocated memory is larger than the requested size by the alignment, so allocating 1 byte
 /// on 64 byte alignment will allocate 65 bytes.
+///
+/// When numa_node is not -1 the pages are mapped directly and their placement is bound to
+/// that node, so they are local to it whichever thread touches them first.
 class ngraph::runtime::AlignedBuffer
 {
 public:
-    AlignedBuffer(size_t byte_size, size_t alignment);
+    AlignedBuffer(size_t byte_size, size_t alignment, int numa_node = -1);
     AlignedBuffer();
-    void initialize(size_t byte_size, size_t alignment);
+    void initialize(size_t byte_size, size_t alignment, int numa_node = -1);
     ~AlignedBuffer();
 
     size_t size() const { return m_byte_size; }
     void* get_ptr(size_t offset) const { return m_aligned_buffer + offset; }
     void* get_ptr() const { return m_aligned_buffer; }
+    /// @brief The node the memory is bound to, or -1 if it was not bound.
+    int get_numa_node() const { return m_numa_node; }
 private:
     char* m_allocated_buffer;
     char* m_aligned_buffer;
     size_t m_byte_size;
+    size_t m_mapped_size;
+    int m_numa_node;
 };
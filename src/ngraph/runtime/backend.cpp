@@ -17,6 +17,7 @@
 #include <dlfcn.h>
 #include <sstream>
 
+#include "ngraph/except.hpp"
 #include "ngraph/file_util.hpp"
 #include "ngraph/runtime/backend.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view.hpp"
@@ -29,6 +30,14 @@ runtime::Backend::~Backend()
 {
 }
 
+void runtime::Backend::set_config(const map<string, string>& config)
+{
+    if (!config.empty())
+    {
+        throw ngraph_error("Backend does not support option '" + config.begin()->first + "'");
+    }
+}
+
 // This doodad finds the full path of the containing shared library
 static string find_my_file()
 {
@@ -157,6 +166,17 @@ vector<ngraph::runtime::PerformanceCounter>
     return vector<PerformanceCounter>();
 }
 
+runtime::MemoryStats runtime::Backend::get_memory_stats(shared_ptr<Function> func) const
+{
+    return MemoryStats::from_function(func);
+}
+
+vector<runtime::CompilePhase>
+    runtime::Backend::get_compile_profile(shared_ptr<Function> func) const
+{
+    return vector<CompilePhase>();
+}
+
 void runtime::Backend::validate_call(shared_ptr<const Function> function,
                                      const vector<shared_ptr<runtime::TensorView>>& outputs,
                                      const vector<shared_ptr<runtime::TensorView>>& inputs)
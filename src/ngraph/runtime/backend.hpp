@@ -16,9 +16,13 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
+#include <string>
 
 #include "ngraph/function.hpp"
+#include "ngraph/runtime/compile_profile.hpp"
+#include "ngraph/runtime/memory_stats.hpp"
 #include "ngraph/runtime/performance_counter.hpp"
 #include "ngraph/shape.hpp"
 #include "ngraph/type/element_type.hpp"
@@ -72,9 +76,28 @@ namespace ngraph
             virtual void remove_compiled_function(std::shared_ptr<Function> func);
 
             virtual void enable_performance_data(std::shared_ptr<Function> func, bool enable) {}
+            /// @brief Also collect cycles, instructions and last level cache misses per op
+            ///   with the performance data, where the backend and the system support it
+            virtual void enable_hardware_counters(std::shared_ptr<Function> func, bool enable)
+            {
+            }
             virtual std::vector<PerformanceCounter>
                 get_performance_data(std::shared_ptr<Function> func) const;
 
+            /// @brief Memory taken by a compiled function. The default covers what follows
+            ///   from the compiled graph, see MemoryStats::from_function.
+            virtual MemoryStats get_memory_stats(std::shared_ptr<Function> func) const;
+
+            /// @brief Time spent in each phase of compiling a function, in the order they
+            ///   ran. Empty if the backend does not profile compilation.
+            virtual std::vector<CompilePhase>
+                get_compile_profile(std::shared_ptr<Function> func) const;
+
+            /// @brief Set backend specific options, such as {{"tracing", "1"}} for the CPU
+            ///   backend. Options must be set before any function is compiled.
+            /// @throws ngraph_error if the backend does not support an option
+            virtual void set_config(const std::map<std::string, std::string>& config);
+
             static bool register_backend(const std::string& name, std::shared_ptr<Backend>);
 
         protected:
@@ -0,0 +1,32 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "ngraph/runtime/compile_profile.hpp"
+#include "ngraph/pass/manager.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+void runtime::add_pass_phases(vector<CompilePhase>& profile, const pass::Manager& manager)
+{
+    size_t passes = profile.size();
+    profile.push_back({"passes", 0, 0});
+    for (const pass::Manager::PassStatistics& stats : manager.get_pass_statistics())
+    {
+        profile.push_back({stats.name, stats.time_us, 1});
+        profile[passes].microseconds += stats.time_us;
+    }
+}
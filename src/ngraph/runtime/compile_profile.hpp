@@ -0,0 +1,46 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ngraph
+{
+    namespace pass
+    {
+        class Manager;
+    }
+
+    namespace runtime
+    {
+        /// \brief Time a backend spent in one phase of compiling a function
+        struct CompilePhase
+        {
+            std::string name;
+            size_t microseconds;
+            /// 0 for the phases of the compilation and 1 for their parts, such as the
+            /// single passes, which follow the phase they belong to
+            size_t depth;
+        };
+
+        /// \brief Appends a "passes" phase with the passes of the last run_passes call of
+        ///        manager as its parts
+        void add_pass_phases(std::vector<CompilePhase>& profile, const pass::Manager& manager);
+    }
+}
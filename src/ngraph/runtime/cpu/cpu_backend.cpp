@@ -14,13 +14,18 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <mutex>
 #include <tbb/tbb_stddef.h>
 
+#include "ngraph/codegen/execution_engine.hpp"
 #include "ngraph/graph_util.hpp"
 #include "ngraph/runtime/cpu/cpu_backend.hpp"
 #include "ngraph/runtime/cpu/cpu_call_frame.hpp"
+#include "ngraph/runtime/cpu/cpu_cost_model.hpp"
+#include "ngraph/runtime/cpu/cpu_executor.hpp"
 #include "ngraph/runtime/cpu/cpu_external_function.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view.hpp"
+#include "ngraph/runtime/cpu/mkldnn_emitter.hpp"
 #include "ngraph/util.hpp"
 
 using namespace ngraph;
@@ -35,7 +40,17 @@ extern "C" runtime::Backend* new_backend(const char* configuration_string)
 {
     // Force TBB to link to the backend
     tbb::TBB_runtime_interface_version();
-    return new runtime::cpu::CPU_Backend();
+
+    // Attributes follow the backend name, as in "CPU:threads=8,numa=0"
+    string configuration = configuration_string ? configuration_string : "";
+    auto colon = configuration.find(':');
+    if (colon == string::npos)
+    {
+        return new runtime::cpu::CPU_Backend();
+    }
+    auto config = runtime::cpu::CPUBackendConfig::from_environment();
+    config.parse(configuration.substr(colon + 1));
+    return new runtime::cpu::CPU_Backend(config);
 }
 
 extern "C" void delete_backend(runtime::Backend* backend)
@@ -43,6 +58,41 @@ extern "C" void delete_backend(runtime::Backend* backend)
     delete backend;
 }
 
+runtime::cpu::CPU_Backend::CPU_Backend()
+    : CPU_Backend(CPUBackendConfig::from_environment())
+{
+}
+
+static once_flag s_cost_functions_registered;
+
+runtime::cpu::CPU_Backend::CPU_Backend(const CPUBackendConfig& config)
+{
+    call_once(s_cost_functions_registered, register_cost_functions);
+    set_config(config);
+}
+
+void runtime::cpu::CPU_Backend::set_config(const map<string, string>& config)
+{
+    CPUBackendConfig updated = m_config;
+    updated.set(config);
+    set_config(updated);
+}
+
+void runtime::cpu::CPU_Backend::set_config(const CPUBackendConfig& config)
+{
+    for (const auto& p : m_function_map)
+    {
+        if (p.second.m_external_function != nullptr)
+        {
+            throw runtime_error("Backend configuration must be set prior to compiling.");
+        }
+    }
+    m_config = config;
+    m_executor = m_config.executor.is_default()
+                     ? executor::CPUExecutor::get_default()
+                     : make_shared<executor::CPUExecutor>(m_config.executor);
+}
+
 shared_ptr<runtime::cpu::CPU_CallFrame> runtime::cpu::CPU_Backend::make_call_frame(
     const shared_ptr<runtime::cpu::CPU_ExternalFunction>& external_function)
 {
@@ -66,14 +116,24 @@ bool runtime::cpu::CPU_Backend::compile(shared_ptr<Function> func)
     FunctionInstance& instance = m_function_map[func];
     if (instance.m_external_function == nullptr)
     {
-        instance.m_external_function = make_shared<CPU_ExternalFunction>(func);
+        instance.m_external_function = make_shared<CPU_ExternalFunction>(func, true, m_config);
         instance.m_external_function->m_emit_timing = instance.m_performance_counters_enabled;
+        instance.m_external_function->m_emit_hardware_counters =
+            instance.m_hardware_counters_enabled;
+        instance.m_external_function->m_cpu_executor = m_executor;
         auto cf = instance.m_external_function->make_call_frame();
         instance.m_call_frame = dynamic_pointer_cast<CPU_CallFrame>(cf);
     }
     return true;
 }
 
+shared_ptr<runtime::cpu::CPU_ExternalFunction>
+    runtime::cpu::CPU_Backend::get_external_function(shared_ptr<Function> func) const
+{
+    auto it = m_function_map.find(func);
+    return it == m_function_map.end() ? nullptr : it->second.m_external_function;
+}
+
 bool runtime::cpu::CPU_Backend::call(shared_ptr<Function> func,
                                      const vector<shared_ptr<runtime::TensorView>>& outputs,
                                      const vector<shared_ptr<runtime::TensorView>>& inputs)
@@ -108,6 +168,16 @@ void runtime::cpu::CPU_Backend::enable_performance_data(shared_ptr<Function> fun
     instance.m_performance_counters_enabled = enable;
 }
 
+void runtime::cpu::CPU_Backend::enable_hardware_counters(shared_ptr<Function> func, bool enable)
+{
+    FunctionInstance& instance = m_function_map[func];
+    if (instance.m_external_function != nullptr)
+    {
+        throw runtime_error("Hardware counters must be enabled prior to compiling.");
+    }
+    instance.m_hardware_counters_enabled = enable;
+}
+
 vector<runtime::PerformanceCounter>
     runtime::cpu::CPU_Backend::get_performance_data(shared_ptr<Function> func) const
 {
@@ -119,6 +189,7 @@ vector<runtime::PerformanceCounter>
         if (instance.m_external_function != nullptr)
         {
             auto* engine = instance.m_external_function->m_execution_engine.get();
+            const vector<PerformanceCounter>& work = instance.m_external_function->m_timer_work;
             if (engine)
             {
                 auto get_count = engine->find_function<size_t()>("get_debug_timer_count");
@@ -127,6 +198,9 @@ vector<runtime::PerformanceCounter>
                     engine->find_function<size_t(size_t)>("get_debug_timer_microseconds");
                 auto get_call_count =
                     engine->find_function<size_t(size_t)>("get_debug_timer_call_count");
+                auto get_hardware_counts =
+                    engine->find_function<bool(size_t, runtime::HardwareCounts*)>(
+                        "get_debug_timer_hardware_counts");
 
                 if (get_count && get_name && get_microseconds && get_call_count)
                 {
@@ -134,10 +208,74 @@ vector<runtime::PerformanceCounter>
                     for (size_t i = 0; i < count; i++)
                     {
                         rc.push_back({get_name(i), get_microseconds(i), get_call_count(i)});
+                        if (i < work.size())
+                        {
+                            rc.back().set_work(work[i].flops(),
+                                               work[i].bytes_read(),
+                                               work[i].bytes_written());
+                            rc.back().set_replaced_nodes(work[i].replaced_nodes());
+                        }
+                        runtime::HardwareCounts counts;
+                        if (get_hardware_counts && get_hardware_counts(i, &counts))
+                        {
+                            rc.back().set_hardware_counts(counts);
+                        }
                     }
                 }
             }
+            else
+            {
+                // DEX times each op with the same names and in the same order as the
+                // timers of generated code
+                const vector<stopwatch>& timers = instance.m_external_function->m_op_timers;
+                for (size_t i = 0; i < timers.size() && i < work.size(); i++)
+                {
+                    rc.emplace_back(work[i].name().c_str(),
+                                    timers[i].get_total_microseconds(),
+                                    timers[i].get_call_count());
+                    rc.back().set_work(
+                        work[i].flops(), work[i].bytes_read(), work[i].bytes_written());
+                    rc.back().set_replaced_nodes(work[i].replaced_nodes());
+                }
+            }
         }
     }
     return rc;
 }
+
+runtime::MemoryStats
+    runtime::cpu::CPU_Backend::get_memory_stats(shared_ptr<Function> func) const
+{
+    MemoryStats stats = Backend::get_memory_stats(func);
+    auto it = m_function_map.find(func);
+    if (it != m_function_map.end() && it->second.m_external_function != nullptr)
+    {
+        const CPU_ExternalFunction& external_function = *it->second.m_external_function;
+        stats.workspace_bytes =
+            external_function.get_mkldnn_emitter()->get_mkldnn_workspace_size();
+        if (external_function.m_execution_engine)
+        {
+            stats.code_bytes = external_function.m_execution_engine->get_code_size();
+        }
+        // What CPU_CallFrame::setup_runtime_context allocates
+        stats.call_frame_bytes =
+            sizeof(CPURuntimeContext) +
+            external_function.parameter_layout_descriptors.size() * sizeof(bool);
+        for (size_t size : external_function.get_memory_buffer_sizes())
+        {
+            stats.call_frame_bytes += size;
+        }
+    }
+    return stats;
+}
+
+vector<runtime::CompilePhase>
+    runtime::cpu::CPU_Backend::get_compile_profile(shared_ptr<Function> func) const
+{
+    auto it = m_function_map.find(func);
+    if (it == m_function_map.end() || it->second.m_external_function == nullptr)
+    {
+        return vector<CompilePhase>();
+    }
+    return it->second.m_external_function->get_compile_profile();
+}
@@ -20,6 +20,7 @@
 #include <memory>
 
 #include "ngraph/runtime/backend.hpp"
+#include "ngraph/runtime/cpu/cpu_backend_config.hpp"
 
 namespace ngraph
 {
@@ -30,9 +31,23 @@ namespace ngraph
             class CPU_ExternalFunction;
             class CPU_CallFrame;
 
+            namespace executor
+            {
+                class CPUExecutor;
+            }
+
             class CPU_Backend : public runtime::Backend
             {
             public:
+                /// \brief Backend configured from the environment.
+                CPU_Backend();
+                /// \brief Backend configured explicitly.
+                ///
+                /// Backend::create("CPU:dex=1,threads=8,cores=0-7") constructs this from the
+                /// environment overridden by the attributes following the colon. Backends
+                /// with their own thread options run on dedicated thread pools.
+                CPU_Backend(const CPUBackendConfig& config);
+
                 std::shared_ptr<CPU_CallFrame>
                     make_call_frame(const std::shared_ptr<CPU_ExternalFunction>& external_function);
 
@@ -53,8 +68,27 @@ namespace ngraph
 
                 void remove_compiled_function(std::shared_ptr<Function> func) override;
                 void enable_performance_data(std::shared_ptr<Function> func, bool enable) override;
+                void enable_hardware_counters(std::shared_ptr<Function> func,
+                                              bool enable) override;
                 std::vector<PerformanceCounter>
                     get_performance_data(std::shared_ptr<Function> func) const override;
+                /// \brief Adds the MKLDNN workspaces, the JIT code and the call frame to the
+                ///        statistics of the compiled graph
+                MemoryStats get_memory_stats(std::shared_ptr<Function> func) const override;
+                std::vector<CompilePhase>
+                    get_compile_profile(std::shared_ptr<Function> func) const override;
+
+                /// \brief Applies CPUBackendConfig options by name, e.g. {{"dex", "1"}}.
+                void set_config(const std::map<std::string, std::string>& config) override;
+                void set_config(const CPUBackendConfig& config);
+                const CPUBackendConfig& get_config() const { return m_config; }
+                const std::shared_ptr<executor::CPUExecutor>& get_cpu_executor() const
+                {
+                    return m_executor;
+                }
+                /// \brief The compiled form of func, or nullptr if it was not compiled
+                std::shared_ptr<CPU_ExternalFunction>
+                    get_external_function(std::shared_ptr<Function> func) const;
 
             private:
                 class FunctionInstance
@@ -63,9 +97,12 @@ namespace ngraph
                     std::shared_ptr<CPU_ExternalFunction> m_external_function;
                     std::shared_ptr<CPU_CallFrame> m_call_frame;
                     bool m_performance_counters_enabled = false;
+                    bool m_hardware_counters_enabled = false;
                 };
 
                 std::map<std::shared_ptr<Function>, FunctionInstance> m_function_map;
+                CPUBackendConfig m_config;
+                std::shared_ptr<executor::CPUExecutor> m_executor;
             };
         }
     }
@@ -0,0 +1,219 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+#include "ngraph/except.hpp"
+#include "ngraph/runtime/cpu/cpu_backend_config.hpp"
+#include "ngraph/runtime/cpu/cpu_executor.hpp"
+#include "ngraph/runtime/thread_affinity.hpp"
+#include "ngraph/util.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+static bool parse_bool(const string& key, const string& value)
+{
+    string v = to_lower(trim(value));
+    if (v == "1" || v == "true" || v == "on")
+    {
+        return true;
+    }
+    if (v == "0" || v == "false" || v == "off")
+    {
+        return false;
+    }
+    throw ngraph_error("Invalid value '" + value + "' for CPU backend option '" + key + "'");
+}
+
+vector<pair<string, string>> runtime::cpu::split_options(const string& attributes)
+{
+    vector<pair<string, string>> options;
+    for (const string& token : split(attributes, ',', true))
+    {
+        auto equals = token.find('=');
+        if (equals != string::npos)
+        {
+            options.emplace_back(trim(token.substr(0, equals)), trim(token.substr(equals + 1)));
+        }
+        else if (!options.empty())
+        {
+            options.back().second += "," + token;
+        }
+        else if (!token.empty())
+        {
+            throw ngraph_error("Invalid CPU backend option '" + token + "'");
+        }
+    }
+    return options;
+}
+
+runtime::cpu::executor::ExecutorConfig
+    runtime::cpu::executor::ExecutorConfig::parse(const string& config)
+{
+    ExecutorConfig rc;
+    for (const auto& option : split_options(config))
+    {
+        if (!rc.set(option.first, option.second))
+        {
+            throw ngraph_error("Unknown CPU backend option '" + option.first + "'");
+        }
+    }
+    return rc;
+}
+
+bool runtime::cpu::executor::ExecutorConfig::set(const string& key, const string& value)
+{
+    try
+    {
+        if (key == "threads")
+        {
+            num_threads = stoi(value);
+        }
+        else if (key == "inter_op")
+        {
+            inter_op_parallelism = stoi(value);
+        }
+        else if (key == "cores")
+        {
+            cores = parse_cpu_list(value);
+        }
+        else if (key == "numa")
+        {
+            numa_node = stoi(value);
+        }
+        else
+        {
+            return false;
+        }
+    }
+    catch (const logic_error&)
+    {
+        throw ngraph_error("Invalid value for CPU backend option '" + key + "'");
+    }
+    return true;
+}
+
+bool runtime::cpu::executor::ExecutorConfig::is_default() const
+{
+    return num_threads == 0 && inter_op_parallelism == 0 && cores.empty() && numa_node == -1;
+}
+
+runtime::cpu::CPUBackendConfig runtime::cpu::CPUBackendConfig::from_environment()
+{
+    CPUBackendConfig rc;
+    rc.direct_execution = std::getenv("NGRAPH_DEX") != nullptr;
+    rc.use_tbb = std::getenv("NGRAPH_CPU_USE_TBB") != nullptr;
+    rc.tracing = std::getenv("NGRAPH_CPU_TRACING") != nullptr;
+    rc.nan_check = std::getenv("NGRAPH_CPU_NAN_CHECK") != nullptr;
+    rc.inf_check = std::getenv("NGRAPH_CPU_INF_CHECK") != nullptr;
+    rc.check_parms_and_consts = std::getenv("NGRAPH_CPU_CHECK_PARMS_AND_CONSTS") != nullptr;
+    rc.memory_sharing = std::getenv("NGRAPH_CPU_MEMORY_SHARING") != nullptr;
+    rc.fast_math = std::getenv("NGRAPH_CPU_FAST_MATH") != nullptr;
+    if (const char* threshold = std::getenv("NGRAPH_DEX_INTER_OP_THRESHOLD"))
+    {
+        rc.inter_op_threshold = std::strtoul(threshold, nullptr, 10);
+    }
+    if (const char* sampling = std::getenv("NGRAPH_CPU_TRACE_SAMPLING"))
+    {
+        rc.trace_sampling = std::max<size_t>(std::strtoul(sampling, nullptr, 10), 1);
+    }
+    return rc;
+}
+
+void runtime::cpu::CPUBackendConfig::set(const string& key, const string& value)
+{
+    if (key == "dex")
+    {
+        direct_execution = parse_bool(key, value);
+    }
+    else if (key == "tbb")
+    {
+        use_tbb = parse_bool(key, value);
+    }
+    else if (key == "tracing")
+    {
+        tracing = parse_bool(key, value);
+    }
+    else if (key == "nan_check")
+    {
+        nan_check = parse_bool(key, value);
+    }
+    else if (key == "inf_check")
+    {
+        inf_check = parse_bool(key, value);
+    }
+    else if (key == "check_parms_and_consts")
+    {
+        check_parms_and_consts = parse_bool(key, value);
+    }
+    else if (key == "memory_sharing")
+    {
+        memory_sharing = parse_bool(key, value);
+    }
+    else if (key == "fast_math")
+    {
+        fast_math = parse_bool(key, value);
+    }
+    else if (key == "inter_op_threshold")
+    {
+        try
+        {
+            inter_op_threshold = stoul(value);
+        }
+        catch (const logic_error&)
+        {
+            throw ngraph_error("Invalid value for CPU backend option '" + key + "'");
+        }
+    }
+    else if (key == "trace_sampling")
+    {
+        try
+        {
+            trace_sampling = stoul(value);
+        }
+        catch (const logic_error&)
+        {
+            throw ngraph_error("Invalid value for CPU backend option '" + key + "'");
+        }
+        if (trace_sampling == 0)
+        {
+            throw ngraph_error("Invalid value for CPU backend option '" + key + "'");
+        }
+    }
+    else if (!executor.set(key, value))
+    {
+        throw ngraph_error("Unknown CPU backend option '" + key + "'");
+    }
+}
+
+void runtime::cpu::CPUBackendConfig::set(const map<string, string>& options)
+{
+    for (const auto& option : options)
+    {
+        set(option.first, option.second);
+    }
+}
+
+void runtime::cpu::CPUBackendConfig::parse(const string& attributes)
+{
+    for (const auto& option : split_options(attributes))
+    {
+        set(option.first, option.second);
+    }
+}
@@ -0,0 +1,114 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            namespace executor
+            {
+                /// \brief Thread resources requested for one CPU backend instance.
+                struct ExecutorConfig
+                {
+                    /// Intra-op threads for Eigen kernels and MKLDNN. 0 selects
+                    /// OMP_NUM_THREADS, or half the hardware threads when that is unset.
+                    int num_threads = 0;
+                    /// Concurrency of the TBB arena running inter-op flow graphs. 0 selects
+                    /// NGRAPH_INTER_OP_PARALLELISM, or 1 when that is unset.
+                    int inter_op_parallelism = 0;
+                    /// Cores all worker threads are restricted to; empty means no restriction.
+                    std::vector<int> cores;
+                    /// Restrict workers to the cores of this NUMA node; -1 means any node.
+                    int numa_node = -1;
+
+                    /// \brief Parses a backend attribute string such as
+                    ///        "threads=16,inter_op=2,cores=0-7,16-23,numa=0".
+                    ///
+                    /// This is the part following the colon in Backend::create("CPU:...").
+                    static ExecutorConfig parse(const std::string& config);
+                    /// \brief Applies one option; returns false if key is not an executor
+                    ///        option.
+                    bool set(const std::string& key, const std::string& value);
+                    bool is_default() const;
+                };
+            }
+
+            /// \brief Options of a CPU backend instance.
+            ///
+            /// The defaults come from the NGRAPH_* environment variables, which are read once
+            /// when the backend is created. Attributes given to Backend::create, such as
+            /// "CPU:dex=1,threads=8", and Backend::set_config override them.
+            struct CPUBackendConfig
+            {
+                /// Build DEX functors instead of generated code (dex, NGRAPH_DEX)
+                bool direct_execution = false;
+                /// Run generated code as a TBB flow graph (tbb, NGRAPH_CPU_USE_TBB)
+                bool use_tbb = false;
+                /// Record the ops of generated code in the runtime::Tracer (tracing,
+                /// NGRAPH_CPU_TRACING)
+                bool tracing = false;
+                /// Trace one of every this many calls of a function (trace_sampling,
+                /// NGRAPH_CPU_TRACE_SAMPLING)
+                size_t trace_sampling = 1;
+                /// Check floating point results for NaN (nan_check, NGRAPH_CPU_NAN_CHECK)
+                bool nan_check = false;
+                /// Check floating point results for infinity (inf_check, NGRAPH_CPU_INF_CHECK)
+                bool inf_check = false;
+                /// Apply the checks to parameters and constants as well
+                /// (check_parms_and_consts, NGRAPH_CPU_CHECK_PARMS_AND_CONSTS)
+                bool check_parms_and_consts = false;
+                /// Let intermediates with disjoint lifetimes share pool memory. This disables
+                /// skipping ops whose inputs did not change since the previous call.
+                /// (memory_sharing, NGRAPH_CPU_MEMORY_SHARING)
+                bool memory_sharing = false;
+                /// Let graph rewrites change floating point results, e.g. exp(log(x)) to x
+                /// (fast_math, NGRAPH_CPU_FAST_MATH)
+                bool fast_math = false;
+                /// Minimum output element count for a DEX op to run as a separate inter-op
+                /// task (inter_op_threshold, NGRAPH_DEX_INTER_OP_THRESHOLD)
+                size_t inter_op_threshold = 16384;
+                /// Thread resources (threads, inter_op, cores, numa)
+                executor::ExecutorConfig executor;
+
+                static CPUBackendConfig from_environment();
+
+                /// \brief Applies one option. Boolean options accept 1/0, true/false and
+                ///        on/off.
+                /// \throws ngraph_error for unknown options or invalid values
+                void set(const std::string& key, const std::string& value);
+                void set(const std::map<std::string, std::string>& options);
+                /// \brief Applies a comma separated attribute string such as
+                ///        "dex=1,tracing=0,threads=8".
+                void parse(const std::string& attributes);
+            };
+
+            /// \brief Splits "key=value,key=value" into options. Values may contain commas
+            ///        (cores=0-3,8-11); a token without '=' continues the previous value.
+            std::vector<std::pair<std::string, std::string>>
+                split_options(const std::string& attributes);
+        }
+    }
+}
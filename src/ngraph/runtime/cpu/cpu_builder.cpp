@@ -90,6 +90,7 @@
 #include "ngraph/op/sum.hpp"
 #include "ngraph/op/tan.hpp"
 #include "ngraph/op/tanh.hpp"
+#include "ngraph/runtime/cpu/cpu_kernel_registry.hpp"
 #include "ngraph/runtime/cpu/cpu_kernels.hpp"
 #include "ngraph/runtime/cpu/cpu_op_annotations.hpp"
 #include "ngraph/runtime/cpu/kernel/abs.hpp"
@@ -119,12 +120,24 @@
 using namespace std;
 using namespace ngraph;
 
+// Select the best ISA variant registered for an elementwise kernel, falling back to the
+// variant compiled with the default flags
+#define SELECT_ISA_KERNEL(KV, ET, NAME, FIND)                                                      \
+    runtime::cpu::ISA selected_isa = runtime::cpu::ISA::generic;                                   \
+    KV = runtime::cpu::KernelRegistry::get().FIND(                                                 \
+        #NAME, ET, external_function->get_isa(), &selected_isa);                                   \
+    if (!KV)                                                                                       \
+    {                                                                                              \
+        SELECT_KERNEL(KV, ET, runtime::cpu::kernel::NAME);                                         \
+    }                                                                                              \
+    external_function->set_kernel_isa(node->get_name(), selected_isa);
+
 #define BUILD_UNARY_ELEMWISE_FUNCTOR(OP)                                                           \
     auto& functors = external_function->get_functors();                                            \
     auto& tensor_data = external_function->get_tensor_data();                                      \
     std::function<void(void*, void*, size_t)> kernel;                                              \
                                                                                                    \
-    SELECT_KERNEL(kernel, out[0].get_element_type(), OP);                                          \
+    SELECT_ISA_KERNEL(kernel, out[0].get_element_type(), OP, find_unary);                          \
                                                                                                    \
     auto element_count = out[0].get_size();                                                        \
     auto& arg0_tensor = tensor_data[args[0].get_name()];                                           \
@@ -140,7 +153,7 @@ using namespace ngraph;
     auto& tensor_data = external_function->get_tensor_data();                                      \
     std::function<void(void*, void*, void*, size_t)> kernel;                                       \
                                                                                                    \
-    SELECT_KERNEL(kernel, out[0].get_element_type(), OP);                                          \
+    SELECT_ISA_KERNEL(kernel, out[0].get_element_type(), OP, find_binary);                         \
                                                                                                    \
     auto element_count = out[0].get_size();                                                        \
     auto& arg0_tensor = tensor_data[args[0].get_name()];                                           \
@@ -161,19 +174,19 @@ namespace ngraph
             template <>
             void Builder::BUILDER_DECL(ngraph::op::Add)
             {
-                BUILD_BINARY_ELEMWISE_FUNCTOR(runtime::cpu::kernel::add);
+                BUILD_BINARY_ELEMWISE_FUNCTOR(add);
             }
 
             template <>
             void Builder::BUILDER_DECL(ngraph::op::Multiply)
             {
-                BUILD_BINARY_ELEMWISE_FUNCTOR(runtime::cpu::kernel::multiply);
+                BUILD_BINARY_ELEMWISE_FUNCTOR(multiply);
             }
 
             template <>
             void Builder::BUILDER_DECL(ngraph::op::Abs)
             {
-                BUILD_UNARY_ELEMWISE_FUNCTOR(runtime::cpu::kernel::abs);
+                BUILD_UNARY_ELEMWISE_FUNCTOR(abs);
             }
 
             template <>
@@ -206,19 +219,19 @@ namespace ngraph
             template <>
             void Builder::BUILDER_DECL(ngraph::op::Ceiling)
             {
-                BUILD_UNARY_ELEMWISE_FUNCTOR(runtime::cpu::kernel::ceil);
+                BUILD_UNARY_ELEMWISE_FUNCTOR(ceil);
             }
 
             template <>
             void Builder::BUILDER_DECL(ngraph::op::Relu)
             {
-                BUILD_UNARY_ELEMWISE_FUNCTOR(runtime::cpu::kernel::relu);
+                BUILD_UNARY_ELEMWISE_FUNCTOR(relu);
             }
 
             template <>
             void Builder::BUILDER_DECL(ngraph::op::Result)
             {
-                BUILD_UNARY_ELEMWISE_FUNCTOR(runtime::cpu::kernel::result);
+                BUILD_UNARY_ELEMWISE_FUNCTOR(result);
             }
 
             template <>
@@ -18,9 +18,10 @@
 
 #include "ngraph/runtime/aligned_buffer.hpp"
 #include "ngraph/runtime/cpu/cpu_call_frame.hpp"
+#include "ngraph/runtime/cpu/cpu_executor.hpp"
 #include "ngraph/runtime/cpu/cpu_external_function.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view.hpp"
-#include "ngraph/runtime/cpu/cpu_tracing.hpp"
+#include "ngraph/runtime/tracer.hpp"
 
 using namespace std;
 using namespace ngraph;
@@ -29,6 +30,7 @@ runtime::cpu::CPU_CallFrame::CPU_CallFrame(std::shared_ptr<CPU_ExternalFunction>
                                            EntryPoint compiled_function)
     : m_external_function(external_function)
     , m_compiled_function(compiled_function)
+    , m_call_count(0)
 {
     setup_runtime_context();
 }
@@ -62,22 +64,24 @@ void runtime::cpu::CPU_CallFrame::call(
         outputs.push_back(tv->get_data_ptr());
     }
 
-    // Invoke compiled computation
-    if (!m_external_function->is_direct_execution())
+    const CPUBackendConfig& config = m_external_function->get_config();
+    ctx->trace_call_id = 0;
+    if (config.tracing && m_call_count++ % config.trace_sampling == 0)
     {
-        m_compiled_function(inputs.data(), outputs.data(), ctx);
-    }
-    else
-    {
-        m_external_function->get_executor()(ctx, inputs, outputs);
+        ctx->trace_call_id = Tracer::get().next_call_id();
     }
 
-    if (runtime::cpu::IsTracingEnabled())
-    {
-        GenerateTimeline(m_external_function->get_op_attrs(),
-                         ctx->op_durations,
-                         m_external_function->get_function_name() + ".timeline.json");
-    }
+    // Invoke compiled computation on the backend's thread pools
+    m_external_function->get_cpu_executor()->execute([&]() {
+        if (!m_external_function->is_direct_execution())
+        {
+            m_compiled_function(inputs.data(), outputs.data(), ctx);
+        }
+        else
+        {
+            m_external_function->get_executor()(ctx, inputs, outputs);
+        }
+    });
 }
 
 void runtime::cpu::CPU_CallFrame::propagate_layouts(
@@ -104,42 +108,42 @@ void runtime::cpu::CPU_CallFrame::setup_runtime_context()
 {
     ctx = new CPURuntimeContext;
 
-    ctx->op_durations = nullptr;
-    if (runtime::cpu::IsTracingEnabled())
-    {
-        ctx->op_durations = new int64_t[m_external_function->get_op_attrs().size()];
-    }
+    ctx->trace_call_id = 0;
+    ctx->trace_function_id = m_external_function->get_trace_function_id();
     ctx->p_en = new bool[m_external_function->get_parameter_layout_descriptors().size()];
-    // Create temporary buffer pools
+    // Create temporary buffer pools on the executor's NUMA node, if it is bound to one
     size_t alignment = runtime::cpu::CPU_ExternalFunction::s_memory_pool_alignment;
+    int numa_node = m_external_function->get_cpu_executor()->get_numa_node();
     for (auto buffer_size : m_external_function->get_memory_buffer_sizes())
     {
-        auto buffer = new AlignedBuffer(buffer_size, alignment);
+        auto buffer = new AlignedBuffer(buffer_size, alignment, numa_node);
         ctx->memory_buffers.push_back(buffer);
     }
     const auto& mkldnn_emitter = m_external_function->get_mkldnn_emitter();
     ctx->mkldnn_primitives = mkldnn_emitter->get_mkldnn_primitives().data();
     ctx->mkldnn_workspaces = mkldnn_emitter->get_mkldnn_workspaces().data();
 
-    if (std::getenv("NGRAPH_CPU_USE_TBB") != nullptr)
+    ctx->G = nullptr;
+    ctx->inputs = nullptr;
+    ctx->outputs = nullptr;
+    if (m_external_function->get_config().use_tbb)
     {
-        ctx->G = new tbb::flow::graph;
-        const auto envParallelism = std::getenv("NGRAPH_INTER_OP_PARALLELISM");
-        const auto parallelism = envParallelism == nullptr ? 1 : std::atoi(envParallelism);
-        ctx->c = new tbb::global_control(tbb::global_control::max_allowed_parallelism, parallelism);
-        ctx->init = new tbb::task_scheduler_init(parallelism);
+        // The graph is bound to the arena it is constructed in, so its tasks run on the
+        // executor's workers with its inter-op parallelism. The generated code adds its
+        // nodes on the first call and reuses them afterwards.
+        m_external_function->get_cpu_executor()->get_tbb_arena().execute(
+            [this]() { ctx->G = new tbb::flow::graph; });
     }
 }
 
 void runtime::cpu::CPU_CallFrame::cleanup_runtime_context()
 {
-    delete[] ctx->op_durations;
     delete[] ctx->p_en;
     for (auto buffer : ctx->memory_buffers)
     {
         delete buffer;
     }
-    if (std::getenv("NGRAPH_CPU_USE_TBB") != nullptr)
+    if (ctx->G != nullptr)
     {
         // delete graph G and nodes in G
         ctx->G->wait_for_all();
@@ -153,8 +157,6 @@ void runtime::cpu::CPU_CallFrame::cleanup_runtime_context()
         {
             delete node;
         }
-        delete ctx->c;
-        delete ctx->init;
     }
     delete ctx;
 }
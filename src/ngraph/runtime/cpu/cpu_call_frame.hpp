@@ -62,6 +62,7 @@ namespace ngraph
                 std::shared_ptr<CPU_ExternalFunction> m_external_function;
                 EntryPoint m_compiled_function;
                 CPURuntimeContext* ctx;
+                size_t m_call_count;
             };
         }
     }
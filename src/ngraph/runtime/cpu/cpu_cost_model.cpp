@@ -0,0 +1,219 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <typeindex>
+#include <typeinfo>
+
+#include "ngraph/cost_model.hpp"
+#include "ngraph/runtime/cpu/cpu_cost_model.hpp"
+#include "ngraph/runtime/cpu/op/batch_dot.hpp"
+#include "ngraph/runtime/cpu/op/batch_norm_relu.hpp"
+#include "ngraph/runtime/cpu/op/bounded_relu.hpp"
+#include "ngraph/runtime/cpu/op/conv_bias.hpp"
+#include "ngraph/runtime/cpu/op/conv_relu.hpp"
+#include "ngraph/runtime/cpu/op/group_conv.hpp"
+#include "ngraph/runtime/cpu/op/loop_kernel.hpp"
+#include "ngraph/runtime/cpu/op/lstm.hpp"
+#include "ngraph/runtime/cpu/op/matmul_bias.hpp"
+#include "ngraph/runtime/cpu/op/max_pool_with_indices.hpp"
+#include "ngraph/runtime/cpu/op/rnn.hpp"
+#include "ngraph/runtime/cpu/op/sigmoid_mul.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+#define TI(x) type_index(typeid(x))
+
+static size_t output_elements(const Node& node)
+{
+    return shape_size(node.get_output_shape(0));
+}
+
+// Convolution with the filters argument at index 1, plus extra operations per output
+static size_t convolution_flops(const Node& node, size_t flops_per_output)
+{
+    const Shape& filters = node.get_input_shape(1);
+    size_t filter_size = shape_size(filters);
+    size_t per_output = filter_size > 0 ? 2 * (filter_size / filters.at(0)) : 0;
+    return output_elements(node) * (per_output + flops_per_output);
+}
+
+// Each layer, direction and time step computes the gates from the input and the hidden
+// state with two matrix products. Adding the biases and applying the activations costs
+// two operations per gate element and updating each state three per element.
+static size_t recurrent_flops(size_t timesteps,
+                              size_t gates,
+                              size_t batch_size,
+                              size_t input_features,
+                              size_t hidden_features,
+                              size_t cell_states,
+                              size_t layers,
+                              size_t directions)
+{
+    size_t flops = 0;
+    for (size_t layer = 0; layer < layers; layer++)
+    {
+        // Layers after the first take the hidden state of the one below as input
+        size_t features = (layer == 0 ? input_features : hidden_features);
+        size_t gate_elements = batch_size * gates * hidden_features;
+        flops += 2 * gate_elements * (features + hidden_features) + 2 * gate_elements +
+                 3 * cell_states * batch_size * hidden_features;
+    }
+    return flops * timesteps * directions;
+}
+
+static void convolution_bias_cost(const Node& node, Cost& cost)
+{
+    cost.flops = convolution_flops(node, 1);
+}
+
+static void convolution_bias_add_cost(const Node& node, Cost& cost)
+{
+    cost.flops = convolution_flops(node, 2);
+}
+
+static void convolution_relu_cost(const Node& node, Cost& cost)
+{
+    cost.flops = convolution_flops(node, 1);
+}
+
+static void convolution_bias_backprop_cost(const Node& node, Cost& cost)
+{
+    // Arguments are the data batch and the output delta, which is also summed for the bias
+    const op::ConvolutionBiasBackpropFiltersBias& conv =
+        static_cast<const op::ConvolutionBiasBackpropFiltersBias&>(node);
+    const Shape& filters = conv.get_filters_shape();
+    size_t delta_elements = shape_size(node.get_input_shape(1));
+    size_t filter_size = shape_size(filters);
+    size_t per_delta = filter_size > 0 ? 2 * (filter_size / filters.at(0)) : 0;
+    cost.flops = delta_elements * (per_delta + 1);
+}
+
+static void group_convolution_cost(const Node& node, Cost& cost)
+{
+    // Weights are {groups, output channels, input channels, spatial...} per group
+    const op::GroupConvolution& conv = static_cast<const op::GroupConvolution&>(node);
+    Shape weights = conv.get_weights_dimensions();
+    size_t weights_size = shape_size(weights);
+    size_t per_output = weights_size > 0 ? 2 * (weights_size / (weights.at(0) * weights.at(1)))
+                                         : 0;
+    cost.flops = output_elements(node) * per_output;
+}
+
+static void matmul_bias_cost(const Node& node, Cost& cost)
+{
+    const op::MatmulBias& matmul = static_cast<const op::MatmulBias&>(node);
+    Shape shape_w = matmul.get_arg0_shape();
+    size_t k = shape_w.at(matmul.get_is_arg0_transposed() ? 0 : 1);
+    size_t bias = (node.get_arguments().size() > 2 ? 1 : 0);
+    cost.flops = output_elements(node) * (2 * k + bias);
+}
+
+static void batch_dot_cost(const Node& node, Cost& cost)
+{
+    const op::BatchDot& dot = static_cast<const op::BatchDot&>(node);
+    const Shape& shape_a = node.get_input_shape(0);
+    size_t k = shape_a.at(dot.get_is_a_transposed() ? 1 : 2);
+    cost.flops = 2 * output_elements(node) * k;
+}
+
+static void batch_norm_relu_cost(const Node& node, Cost& cost)
+{
+    // Batch normalization as in the core cost model, then the Relu
+    const op::BatchNormRelu& bn = static_cast<const op::BatchNormRelu&>(node);
+    cost.flops = ((bn.get_training_flag() ? 7 : 4) + 1) * shape_size(node.get_input_shape(2));
+}
+
+static void elementwise_cost(const Node& node, Cost& cost)
+{
+    cost.flops = output_elements(node);
+}
+
+static void sigmoid_multiply_cost(const Node& node, Cost& cost)
+{
+    // Two activations and the product
+    cost.flops = 3 * output_elements(node);
+}
+
+static void sigmoid_multiply_backprop_cost(const Node& node, Cost& cost)
+{
+    // Activations, their derivatives and the products with the delta for both inputs
+    cost.flops = 8 * shape_size(node.get_input_shape(0));
+}
+
+static void max_pool_with_indices_cost(const Node& node, Cost& cost)
+{
+    const op::MaxPoolWithIndices& pool = static_cast<const op::MaxPoolWithIndices&>(node);
+    cost.flops = output_elements(node) * shape_size(pool.get_window_shape());
+}
+
+static void loop_kernel_cost(const Node& node, Cost& cost)
+{
+    // Intermediate values stay in registers, so only the flops of the fused ops add up
+    const runtime::cpu::op::LoopKernel& kernel =
+        static_cast<const runtime::cpu::op::LoopKernel&>(node);
+    cost.flops = 0;
+    for (const shared_ptr<Node>& op : kernel.get_node_list())
+    {
+        cost.flops += estimate_cost(*op).flops;
+    }
+}
+
+static void lstm_cost(const Node& node, Cost& cost)
+{
+    const op::Lstm& lstm = static_cast<const op::Lstm&>(node);
+    cost.flops = recurrent_flops(lstm.get_num_timesteps(),
+                                 lstm.get_gates_per_cell(),
+                                 lstm.get_batch_size(),
+                                 lstm.get_src_layer_feature_size(),
+                                 lstm.get_src_iter_feature_size(),
+                                 lstm.get_num_cell_states(),
+                                 lstm.get_num_fused_layers(),
+                                 lstm.get_direction());
+}
+
+static void rnn_cost(const Node& node, Cost& cost)
+{
+    const op::Rnn& rnn = static_cast<const op::Rnn&>(node);
+    cost.flops = recurrent_flops(rnn.get_num_timesteps(),
+                                 rnn.get_gates_per_cell(),
+                                 rnn.get_batch_size(),
+                                 rnn.get_src_layer_feature_size(),
+                                 rnn.get_src_iter_feature_size(),
+                                 rnn.get_num_cell_states(),
+                                 rnn.get_num_fused_layers(),
+                                 rnn.get_direction());
+}
+
+void runtime::cpu::register_cost_functions()
+{
+    register_cost_function(TI(ngraph::op::BatchDot), batch_dot_cost);
+    register_cost_function(TI(ngraph::op::BatchNormRelu), batch_norm_relu_cost);
+    register_cost_function(TI(ngraph::op::BoundedRelu), elementwise_cost);
+    register_cost_function(TI(ngraph::op::ConvolutionBias), convolution_bias_cost);
+    register_cost_function(TI(ngraph::op::ConvolutionBiasAdd), convolution_bias_add_cost);
+    register_cost_function(TI(ngraph::op::ConvolutionBiasBackpropFiltersBias),
+                           convolution_bias_backprop_cost);
+    register_cost_function(TI(ngraph::op::ConvolutionRelu), convolution_relu_cost);
+    register_cost_function(TI(ngraph::op::GroupConvolution), group_convolution_cost);
+    register_cost_function(TI(ngraph::op::Lstm), lstm_cost);
+    register_cost_function(TI(ngraph::op::MatmulBias), matmul_bias_cost);
+    register_cost_function(TI(ngraph::op::MaxPoolWithIndices), max_pool_with_indices_cost);
+    register_cost_function(TI(ngraph::op::Rnn), rnn_cost);
+    register_cost_function(TI(ngraph::op::SigmoidMultiply), sigmoid_multiply_cost);
+    register_cost_function(TI(ngraph::op::SigmoidMultiplyBackprop), sigmoid_multiply_backprop_cost);
+    register_cost_function(TI(runtime::cpu::op::LoopKernel), loop_kernel_cost);
+}
@@ -0,0 +1,243 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "ngraph/runtime/cpu/cpu_executor.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <sched.h>
+#include <thread>
+
+#include "ngraph/except.hpp"
+#include "ngraph/log.hpp"
+#include "ngraph/runtime/thread_affinity.hpp"
+#include "ngraph/util.hpp"
+
+// MKLDNN and the generated code use the OpenMP runtime that comes with MKLML. Bind to it
+// weakly so the executor still works when no OpenMP runtime is loaded.
+extern "C" {
+void omp_set_num_threads(int num_threads) __attribute__((weak));
+int omp_get_max_threads(void) __attribute__((weak));
+}
+
+using namespace std;
+using namespace ngraph;
+
+static int get_default_num_threads()
+{
+    const auto omp_num_threads = std::getenv("OMP_NUM_THREADS");
+    int count;
+
+    if (omp_num_threads && (count = std::atoi(omp_num_threads)))
+    {
+        return count;
+    }
+    else
+    {
+        count = std::thread::hardware_concurrency() >> 1;
+    }
+    return count ? count : 1;
+}
+
+static int get_default_inter_op_parallelism()
+{
+    const auto env_parallelism = std::getenv("NGRAPH_INTER_OP_PARALLELISM");
+    int count = env_parallelism == nullptr ? 1 : std::atoi(env_parallelism);
+    return count > 0 ? count : 1;
+}
+
+vector<int> runtime::cpu::executor::get_numa_node_cores(int numa_node)
+{
+    ifstream in("/sys/devices/system/node/node" + to_string(numa_node) + "/cpulist");
+    string list;
+    if (!in || !getline(in, list))
+    {
+        return vector<int>();
+    }
+    return parse_cpu_list(list);
+}
+
+namespace
+{
+    // What a TBB worker had before it entered the arena of an executor
+    struct WorkerState
+    {
+        Eigen::ThreadPoolDevice* device;
+        bool restricted;
+        cpu_set_t mask;
+    };
+}
+
+// Workers may enter arenas while inside another, so their states are stacked
+static thread_local vector<WorkerState> s_worker_states;
+
+class runtime::cpu::executor::CPUExecutor::ArenaObserver : public tbb::task_scheduler_observer
+{
+public:
+    ArenaObserver(CPUExecutor& executor)
+        : tbb::task_scheduler_observer(executor.get_tbb_arena())
+        , m_executor(executor)
+    {
+        observe(true);
+    }
+    ~ArenaObserver() { observe(false); }
+    void on_scheduler_entry(bool is_worker) override
+    {
+        if (!is_worker)
+        {
+            return;
+        }
+        WorkerState state;
+        state.device = eigen::set_thread_pool_device(&m_executor.get_eigen_device());
+        state.restricted = false;
+        const vector<int>& cores = m_executor.get_cores();
+        if (!cores.empty() && sched_getaffinity(0, sizeof(state.mask), &state.mask) == 0)
+        {
+            state.restricted = set_thread_affinity(cores);
+            if (!state.restricted)
+            {
+                NGRAPH_WARN << "Unable to restrict thread to cores " << join(cores);
+            }
+        }
+        s_worker_states.push_back(state);
+    }
+    // Workers go back to other arenas as they were
+    void on_scheduler_exit(bool is_worker) override
+    {
+        if (!is_worker || s_worker_states.empty())
+        {
+            return;
+        }
+        const WorkerState& state = s_worker_states.back();
+        if (state.restricted)
+        {
+            sched_setaffinity(0, sizeof(state.mask), &state.mask);
+        }
+        eigen::set_thread_pool_device(state.device);
+        s_worker_states.pop_back();
+    }
+
+private:
+    CPUExecutor& m_executor;
+};
+
+runtime::cpu::executor::CPUExecutor::CPUExecutor(const ExecutorConfig& config)
+    : m_num_threads(config.num_threads > 0 ? config.num_threads : get_default_num_threads())
+    , m_inter_op_parallelism(config.inter_op_parallelism > 0
+                                 ? config.inter_op_parallelism
+                                 : get_default_inter_op_parallelism())
+    , m_numa_node(config.numa_node)
+    , m_cores(config.cores)
+    , m_tbb_arena(m_inter_op_parallelism)
+{
+    if (m_numa_node >= 0)
+    {
+        vector<int> node_cores = get_numa_node_cores(m_numa_node);
+        if (node_cores.empty())
+        {
+            throw ngraph_error("NUMA node " + to_string(m_numa_node) + " not found");
+        }
+        if (m_cores.empty())
+        {
+            m_cores = node_cores;
+        }
+        else
+        {
+            vector<int> cores;
+            for (int core : m_cores)
+            {
+                if (contains(node_cores, core))
+                {
+                    cores.push_back(core);
+                }
+            }
+            if (cores.empty())
+            {
+                throw ngraph_error("None of the requested cores belong to NUMA node " +
+                                   to_string(m_numa_node));
+            }
+            m_cores = cores;
+        }
+    }
+
+    {
+        // Eigen worker threads inherit the restriction from the creating thread
+        ScopedAffinity affinity(m_cores);
+        if (!affinity.is_applied())
+        {
+            NGRAPH_WARN << "Unable to restrict thread to cores " << join(m_cores);
+        }
+        m_eigen_pool.reset(new Eigen::ThreadPool(m_num_threads));
+    }
+    m_eigen_device.reset(new Eigen::ThreadPoolDevice(m_eigen_pool.get(), m_num_threads));
+    m_arena_observer.reset(new ArenaObserver(*this));
+
+    NGRAPH_DEBUG << "CPU executor: " << m_num_threads << " threads, inter-op parallelism "
+                 << m_inter_op_parallelism << ", cores {" << join(m_cores) << "}";
+}
+
+runtime::cpu::executor::CPUExecutor::~CPUExecutor()
+{
+    // Workers leaving the arena still restore their state through the observer
+    m_tbb_arena.terminate();
+    m_arena_observer.reset();
+    m_eigen_device.reset();
+    m_eigen_pool.reset();
+}
+
+void runtime::cpu::executor::CPUExecutor::execute(const function<void()>& f)
+{
+    // Restore the caller's state on the way out, including when f throws
+    class ExecutionScope
+    {
+    public:
+        ExecutionScope(CPUExecutor& executor)
+            : m_affinity(executor.get_cores())
+            , m_saved_device(eigen::set_thread_pool_device(&executor.get_eigen_device()))
+            , m_saved_omp_threads(0)
+        {
+            if (omp_set_num_threads && omp_get_max_threads)
+            {
+                m_saved_omp_threads = omp_get_max_threads();
+                omp_set_num_threads(executor.get_num_threads());
+            }
+        }
+        ~ExecutionScope()
+        {
+            if (m_saved_omp_threads > 0)
+            {
+                omp_set_num_threads(m_saved_omp_threads);
+            }
+            eigen::set_thread_pool_device(m_saved_device);
+        }
+
+    private:
+        ScopedAffinity m_affinity;
+        Eigen::ThreadPoolDevice* m_saved_device;
+        int m_saved_omp_threads;
+    };
+
+    ExecutionScope scope(*this);
+    m_tbb_arena.execute(f);
+}
+
+const shared_ptr<runtime::cpu::executor::CPUExecutor>&
+    runtime::cpu::executor::CPUExecutor::get_default()
+{
+    static shared_ptr<CPUExecutor> s_default_executor =
+        make_shared<CPUExecutor>(ExecutorConfig());
+    return s_default_executor;
+}
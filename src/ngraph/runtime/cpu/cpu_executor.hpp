@@ -0,0 +1,86 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define TBB_PREVIEW_LOCAL_OBSERVER 1
+#include <tbb/task_arena.h>
+#include <tbb/task_scheduler_observer.h>
+
+#include "ngraph/runtime/cpu/cpu_backend_config.hpp"
+#include "ngraph/runtime/cpu/kernel/eigen_thread_pool.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            namespace executor
+            {
+                /// \brief Returns the cores belonging to a NUMA node, or an empty vector if the
+                ///        node is unknown.
+                std::vector<int> get_numa_node_cores(int numa_node);
+
+                /// \brief Owns the thread pools used to run compiled functions.
+                ///
+                /// A single executor backs the Eigen kernels, the TBB flow graph used for
+                /// inter-op parallelism and the OpenMP regions of MKLDNN, so several backend
+                /// instances can partition a host without oversubscribing it.
+                class CPUExecutor
+                {
+                public:
+                    CPUExecutor(const ExecutorConfig& config);
+                    ~CPUExecutor();
+
+                    int get_num_threads() const { return m_num_threads; }
+                    int get_inter_op_parallelism() const { return m_inter_op_parallelism; }
+                    const std::vector<int>& get_cores() const { return m_cores; }
+                    int get_numa_node() const { return m_numa_node; }
+                    Eigen::ThreadPoolDevice& get_eigen_device() { return *m_eigen_device; }
+                    tbb::task_arena& get_tbb_arena() { return m_tbb_arena; }
+                    /// \brief Runs f on the calling thread with this executor's resources
+                    ///        active for Eigen kernels, TBB flow graphs and OpenMP regions.
+                    ///
+                    /// With cores configured, the calling thread is restricted to them for
+                    /// the call and gets its own affinity back afterwards.
+                    void execute(const std::function<void()>& f);
+
+                    /// \brief Executor shared by backends created without a thread
+                    ///        configuration; created on first use.
+                    static const std::shared_ptr<CPUExecutor>& get_default();
+
+                private:
+                    class ArenaObserver;
+
+                    int m_num_threads;
+                    int m_inter_op_parallelism;
+                    int m_numa_node;
+                    std::vector<int> m_cores;
+                    std::unique_ptr<Eigen::ThreadPool> m_eigen_pool;
+                    std::unique_ptr<Eigen::ThreadPoolDevice> m_eigen_device;
+                    tbb::task_arena m_tbb_arena;
+                    std::unique_ptr<ArenaObserver> m_arena_observer;
+                };
+            }
+        }
+    }
+}
@@ -15,8 +15,11 @@
 *******************************************************************************/
 
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <limits>
 #include <memory>
+#include <set>
 #include <string>
 #include <tuple>
 #include <typeindex>
@@ -109,12 +112,14 @@
 #include "ngraph/pass/manager.hpp"
 #include "ngraph/pass/memory_layout.hpp"
 #include "ngraph/pass/nop_elimination.hpp"
+#include "ngraph/pass/reshape_sinking.hpp"
 #include "ngraph/pass/result_copy_elimination.hpp"
 #include "ngraph/runtime/aligned_buffer.hpp"
 #include "ngraph/runtime/cpu/cpu_backend.hpp"
 #include "ngraph/runtime/cpu/cpu_builder.hpp"
 #include "ngraph/runtime/cpu/cpu_call_frame.hpp"
 #include "ngraph/runtime/cpu/cpu_emitter.hpp"
+#include "ngraph/runtime/cpu/cpu_executor.hpp"
 #include "ngraph/runtime/cpu/cpu_external_function.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view.hpp"
 #include "ngraph/runtime/cpu/cpu_tracing.hpp"
@@ -315,16 +320,23 @@ const size_t runtime::cpu::CPU_ExternalFunction::CPU_ExternalFunction::s_memory_
     4096;
 
 runtime::cpu::CPU_ExternalFunction::CPU_ExternalFunction(
-    const shared_ptr<ngraph::Function>& function, bool release_function)
+    const shared_ptr<ngraph::Function>& function,
+    bool release_function,
+    const CPUBackendConfig& config)
     : m_function(function)
+    , m_config(config)
     , m_release_function(release_function)
     , m_is_compiled(false)
     , m_compiled_function(nullptr)
     , m_emit_timing(false)
-    , m_use_tbb(std::getenv("NGRAPH_CPU_USE_TBB") != nullptr)
+    , m_emit_hardware_counters(false)
+    , m_trace_function_id(0)
+    , m_use_tbb(config.use_tbb)
     , m_function_name(function->get_name())
     , m_is_built(false)
-    , m_direct_execution(std::getenv("NGRAPH_DEX") != nullptr)
+    , m_direct_execution(config.direct_execution)
+    , m_inter_op_threshold(config.inter_op_threshold)
+    , m_isa(runtime::cpu::get_isa())
 {
 }
 
@@ -332,6 +344,130 @@ runtime::cpu::CPU_ExternalFunction::~CPU_ExternalFunction()
 {
 }
 
+void* runtime::cpu::CPU_ExternalFunction::get_constant_data(const ngraph::op::Constant* constant)
+{
+    int numa_node = get_cpu_executor()->get_numa_node();
+    size_t size = shape_size(constant->get_shape()) * constant->get_element_type().size();
+    if (numa_node < 0 || size == 0)
+    {
+        return const_cast<void*>(constant->get_data_ptr());
+    }
+    // Constants are read on every call, so keep them on the node the workers run on
+    auto buffer = new AlignedBuffer(size, s_memory_pool_alignment, numa_node);
+    m_numa_constants.emplace_back(buffer);
+    memcpy(buffer->get_ptr(), constant->get_data_ptr(), size);
+    return buffer->get_ptr();
+}
+
+vector<vector<size_t>> runtime::cpu::CPU_ExternalFunction::get_step_dependencies(
+    const vector<vector<string>>& reads,
+    const vector<vector<string>>& writes,
+    const unordered_map<string, size_t>& sizes)
+{
+    // Accesses to an extent of a buffer since it was last written
+    struct Extent
+    {
+        size_t begin;
+        size_t end;
+        size_t last_writer;
+        vector<size_t> readers;
+    };
+    const size_t none = numeric_limits<size_t>::max();
+    unordered_map<string, vector<Extent>> buffers;
+
+    // Intermediates share the memory pool, so they are identified by their pool range.
+    // Everything else lives in its own buffer.
+    auto locate = [&](const string& name) -> pair<vector<Extent>*, pair<size_t, size_t>> {
+        auto offset = intermediates_offsets.find(name);
+        if (offset != intermediates_offsets.end())
+        {
+            size_t size = std::max(sizes.at(name), size_t(1));
+            return make_pair(&buffers[""], make_pair(offset->second, offset->second + size));
+        }
+        string buffer = name;
+        if (function_input_index.count(name))
+        {
+            buffer = "input " + to_string(function_input_index.at(name));
+        }
+        else if (function_output_index.count(name))
+        {
+            buffer = "output " + to_string(function_output_index.at(name));
+        }
+        return make_pair(&buffers[buffer], make_pair(size_t(0), size_t(1)));
+    };
+    auto record = [&](const string& name) -> Extent& {
+        auto location = locate(name);
+        for (Extent& extent : *location.first)
+        {
+            if (extent.begin == location.second.first && extent.end == location.second.second)
+            {
+                return extent;
+            }
+        }
+        location.first->push_back(
+            Extent{location.second.first, location.second.second, none, vector<size_t>()});
+        return location.first->back();
+    };
+
+    vector<vector<size_t>> dependencies(reads.size());
+    for (size_t step = 0; step < reads.size(); step++)
+    {
+        set<size_t> predecessors;
+        auto add_conflicts = [&](const string& name, bool write) {
+            auto location = locate(name);
+            for (const Extent& extent : *location.first)
+            {
+                if (extent.begin < location.second.second && location.second.first < extent.end)
+                {
+                    if (extent.last_writer != none)
+                    {
+                        predecessors.insert(extent.last_writer);
+                    }
+                    if (write)
+                    {
+                        predecessors.insert(extent.readers.begin(), extent.readers.end());
+                    }
+                }
+            }
+        };
+        for (const string& name : reads[step])
+        {
+            add_conflicts(name, false);
+        }
+        for (const string& name : writes[step])
+        {
+            add_conflicts(name, true);
+        }
+        predecessors.erase(step);
+        dependencies[step].assign(predecessors.begin(), predecessors.end());
+
+        for (const string& name : reads[step])
+        {
+            record(name).readers.push_back(step);
+        }
+        for (const string& name : writes[step])
+        {
+            Extent& extent = record(name);
+            extent.last_writer = step;
+            extent.readers.clear();
+        }
+    }
+    return dependencies;
+}
+
+const shared_ptr<runtime::cpu::executor::CPUExecutor>&
+    runtime::cpu::CPU_ExternalFunction::get_cpu_executor() const
+{
+    return m_cpu_executor ? m_cpu_executor : executor::CPUExecutor::get_default();
+}
+
+runtime::cpu::ISA
+    runtime::cpu::CPU_ExternalFunction::get_kernel_isa(const string& node_name) const
+{
+    auto it = m_kernel_isa.find(node_name);
+    return it == m_kernel_isa.end() ? ISA::generic : it->second;
+}
+
 void runtime::cpu::CPU_ExternalFunction::compile()
 {
     if (m_is_compiled)
@@ -351,7 +487,8 @@ void runtime::cpu::CPU_ExternalFunction::compile()
     // failing mxnet unit tests.
     // pass_manager.register_pass<runtime::cpu::pass::LSTMFusion>();
     // pass_manager.register_pass<runtime::cpu::pass::RNNFusion>();
-    pass_manager.register_pass<ngraph::pass::AlgebraicSimplification>();
+    pass_manager.register_pass<ngraph::pass::AlgebraicSimplification>(m_config.fast_math);
+    pass_manager.register_pass<ngraph::pass::ReshapeSinking>();
     // pass_manager.register_pass<runtime::cpu::pass::MultiLayerRNNFusion>();
     // pass_manager.register_pass<runtime::cpu::pass::ConcatInputs>();
     pass_manager.register_pass<runtime::cpu::pass::CPUBatchFusion>();
@@ -374,8 +511,19 @@ void runtime::cpu::CPU_ExternalFunction::compile()
     pass_manager.register_pass<ngraph::pass::CommonFunctionCollection>(
         femitter, node_function_map, common_function_string);
     pass_manager.register_pass<ngraph::pass::Liveness>();
-    pass_manager.register_pass<ngraph::pass::MemoryLayout>(s_memory_pool_alignment, true);
-    pass_manager.run_passes(m_function);
+    pass_manager.register_pass<ngraph::pass::MemoryLayout>(s_memory_pool_alignment,
+                                                           !m_config.memory_sharing);
+    {
+        // Timed ops report the ops they replaced
+        ReplacedNodeRecording recording(m_emit_timing);
+        pass_manager.run_passes(m_function);
+    }
+    add_pass_phases(m_compile_profile, pass_manager);
+
+    // MKLDNN primitives are created while their ops are emitted
+    stopwatch emit_timer;
+    stopwatch mkldnn_timer;
+    emit_timer.start();
 
     unordered_map<shared_ptr<Function>, list<shared_ptr<Node>>> function_ordered_ops;
     for (shared_ptr<Function> current_function : pass_manager.get_state().get_functions())
@@ -401,6 +549,7 @@ void runtime::cpu::CPU_ExternalFunction::compile()
 #include "ngraph/runtime/cpu/cpu_kernels.hpp"
 #include "ngraph/runtime/cpu/cpu_runtime_context.hpp"
 #include "ngraph/runtime/cpu/mkldnn_invoke.hpp"
+#include "ngraph/runtime/hardware_counters.hpp"
 #include "ngraph/runtime/reference/and.hpp"
 #include "ngraph/runtime/reference/avg_pool.hpp"
 #include "ngraph/runtime/reference/batch_norm.hpp"
@@ -427,6 +576,7 @@ void runtime::cpu::CPU_ExternalFunction::compile()
 #include "ngraph/runtime/reference/select_and_scatter.hpp"
 #include "ngraph/runtime/reference/slice.hpp"
 #include "ngraph/runtime/reference/sum.hpp"
+#include "ngraph/runtime/tracer.hpp"
 #include "ngraph/shape.hpp"
 #include "ngraph/strides.hpp"
 #include "ngraph/util.hpp"
@@ -462,6 +612,9 @@ using namespace ngraph::runtime;
                 {
                     names.push_back(node->get_name());
                     m_name_index_map.insert({node->get_name(), index++});
+                    m_timer_work.emplace_back(node->get_name().c_str(), 0, 0);
+                    m_timer_work.back().set_work(*node);
+                    m_timer_work.back().set_replaced_nodes(node->get_replaced_nodes());
                 }
             }
         }
@@ -500,6 +653,30 @@ using namespace ngraph::runtime;
         writer << "return (index < " << names.size() << " ? timers[index].get_call_count() : 0);\n";
         writer.indent--;
         writer << "}\n";
+
+        m_emit_hardware_counters = m_emit_hardware_counters && !m_use_tbb;
+        if (m_emit_hardware_counters)
+        {
+            writer << "ngraph::runtime::HardwareCounters hardware_counters;\n";
+            writer << "ngraph::runtime::HardwareCounts hardware_counts[" << names.size()
+                   << "];\n";
+            writer << "ngraph::runtime::HardwareCounts hardware_start_counts;\n";
+            writer << "extern \"C\" bool get_debug_timer_hardware_counts(size_t index,\n";
+            writer << "    ngraph::runtime::HardwareCounts* counts)\n";
+            writer << "{\n";
+            writer.indent++;
+            writer << "if (index >= " << names.size()
+                   << " || !hardware_counters.is_available())\n";
+            writer << "{\n";
+            writer.indent++;
+            writer << "return false;\n";
+            writer.indent--;
+            writer << "}\n";
+            writer << "*counts = hardware_counts[index];\n";
+            writer << "return true;\n";
+            writer.indent--;
+            writer << "}\n";
+        }
         writer << "\n";
     }
 
@@ -515,7 +692,7 @@ using namespace ngraph::runtime;
                 shared_ptr<descriptor::TensorView> tv = node->get_outputs()[0].get_tensor_view();
                 string type = tv->get_tensor().get_element_type().c_type_string();
                 writer << "static " << type << "* " << tv->get_tensor().get_name() << " = (("
-                       << type << "*)(" << c->get_data_ptr() << "));\n";
+                       << type << "*)(" << get_constant_data(c) << "));\n";
                 m_variable_name_map[tv->get_tensor().get_name()] = tv->get_tensor().get_name();
             }
         }
@@ -593,11 +770,16 @@ using namespace ngraph::runtime;
         writer << "{\n";
         writer.indent++;
 
+        // The flow graph is only built for the outermost function; functions it calls run
+        // sequentially inside their caller's node
+        bool use_tbb = m_use_tbb && current_function->get_name() == m_function_name;
+
         // Execution tracing support
-        if (runtime::cpu::IsTracingEnabled() && current_function->get_name() == m_function_name)
+        bool tracing = m_config.tracing && current_function->get_name() == m_function_name;
+        size_t profiler_index = 0;
+        if (tracing && !use_tbb)
         {
-            writer << "cpu::Timestamp start_ts;\n"
-                   << "int profiler_count = 0;\n\n";
+            writer << "int64_t start_ts = 0;\n\n";
         }
 
         if (temporaries_used)
@@ -621,16 +803,23 @@ using namespace ngraph::runtime;
 
         writer << "bool* t_en = (bool*)" << current_function->get_name() << "_t_en;\n";
 
-        if (m_use_tbb)
+        // The flow graph persists in the call frame's context and is reused by every call,
+        // so its nodes must not refer to this call's stack; the arguments go through ctx
+        string flowgraph_captures;
+        if (use_tbb)
         {
+            flowgraph_captures =
+                temporaries_used ? "[&, ctx, t_en, pool_base_ptr]" : "[&, ctx, t_en]";
+            writer << "ctx->inputs = inputs;\n";
+            writer << "ctx->outputs = outputs;\n";
             writer << "\n";
-            writer << "if (" << current_function->get_name() << "_init) {\n";
+            writer << "if (ctx->G->begin() == ctx->G->end()) {\n";
             writer.indent++;
             writer << "tbb::flow::continue_node<tbb::flow::continue_msg, tbb::flow::lightweight>* "
                       "flowgraph_node_start"
                    << " = new tbb::flow::continue_node<tbb::flow::continue_msg, "
                       "tbb::flow::lightweight>"
-                      "(*(ctx->G), [&](const tbb::flow::continue_msg &msg)\n{});\n";
+                      "(*(ctx->G), [](const tbb::flow::continue_msg &msg)\n{});\n";
         }
 
         // Add inputs to the variable name map
@@ -711,7 +900,7 @@ using namespace ngraph::runtime;
                     m_op_attrs.emplace_back(
                         node->description(), node_output_names, node_input_names);
                 }
-                if (m_use_tbb)
+                if (use_tbb)
                 {
                     writer << "tbb::flow::continue_node<tbb::flow::continue_msg, "
                               "tbb::flow::lightweight>* "
@@ -719,13 +908,17 @@ using namespace ngraph::runtime;
                            << node->get_name()
                            << " = new tbb::flow::continue_node<tbb::flow::continue_msg, "
                               "tbb::flow::lightweight>"
-                              "(*(ctx->G), [&](const tbb::flow::continue_msg &msg)\n{\n";
+                              "(*(ctx->G), "
+                           << flowgraph_captures << "(const tbb::flow::continue_msg &msg)\n{\n";
                     writer.indent++;
+                    writer << "void** inputs = ctx->inputs;\n";
+                    writer << "void** outputs = ctx->outputs;\n";
                 }
-                if (runtime::cpu::IsTracingEnabled() &&
-                    current_function->get_name() == m_function_name)
+                if (tracing)
                 {
-                    writer << "start_ts = cpu::Clock::now();\n";
+                    // Only sampled calls have a call id
+                    writer << (use_tbb ? "int64_t " : "")
+                           << "start_ts = ctx->trace_call_id ? Tracer::now() : 0;\n";
                 }
             }
 
@@ -767,7 +960,8 @@ using namespace ngraph::runtime;
 
                 // Always enable nodes computing output tensors or nodes whose outputs might get
                 // overwritten due to inplace kernels
-                if (computes_result(node.get()) || possibly_overwritten(node.get()))
+                if (computes_result(node.get()) || possibly_overwritten(node.get()) ||
+                    m_config.memory_sharing)
                 {
                     writer << " || 1";
                 }
@@ -778,7 +972,16 @@ using namespace ngraph::runtime;
             auto it = node_function_map.find(node.get());
             if (it == node_function_map.end())
             {
+                bool uses_mkldnn = runtime::cpu::mkldnn_utils::use_mkldnn_kernel(node.get());
+                if (uses_mkldnn)
+                {
+                    mkldnn_timer.start();
+                }
                 handler->second(this, writer, node.get(), in, out);
+                if (uses_mkldnn)
+                {
+                    mkldnn_timer.stop();
+                }
             }
             else
             {
@@ -804,14 +1007,14 @@ using namespace ngraph::runtime;
             {
                 //check inputs and constants?
                 if ((!node->is_parameter() && !node->is_constant()) ||
-                    std::getenv("NGRAPH_CPU_CHECK_PARMS_AND_CONSTS"))
+                    m_config.check_parms_and_consts)
                 {
-                    if (std::getenv("NGRAPH_CPU_NAN_CHECK"))
+                    if (m_config.nan_check)
                     {
                         generate_isnan_isinf_check(writer, node, out, "std::isnan");
                     }
 
-                    if (std::getenv("NGRAPH_CPU_INF_CHECK"))
+                    if (m_config.inf_check)
                     {
                         generate_isnan_isinf_check(writer, node, out, "std::isinf");
                     }
@@ -835,14 +1038,17 @@ using namespace ngraph::runtime;
                 writer.indent--;
                 writer << "}\n";
                 emit_debug_function_exit(writer, node.get(), in, out);
-                if (runtime::cpu::IsTracingEnabled() &&
-                    current_function->get_name() == m_function_name)
+                if (tracing)
                 {
-                    writer << "ctx->op_durations[profiler_count++] = "
-                           << "(std::chrono::duration_cast<cpu::Timescale>(cpu::Clock::now() - "
-                              "start_ts)).count();\n";
+                    writer << "if (ctx->trace_call_id)\n";
+                    writer << "{\n";
+                    writer.indent++;
+                    writer << "Tracer::get().record(ctx->trace_function_id, " << profiler_index++
+                           << ", ctx->trace_call_id, start_ts);\n";
+                    writer.indent--;
+                    writer << "}\n";
                 }
-                if (m_use_tbb)
+                if (use_tbb)
                 {
                     writer.indent--;
                     writer << "});\n";
@@ -850,7 +1056,7 @@ using namespace ngraph::runtime;
             }
         }
 
-        if (m_use_tbb)
+        if (use_tbb)
         {
             writer << "\n";
             // Build the flow graph
@@ -911,21 +1117,36 @@ using namespace ngraph::runtime;
     string code = writer.get_code();
     out << code;
     out.close();
+    emit_timer.stop();
+    m_compile_profile.push_back(
+        {"emit source", emit_timer.get_microseconds() - mkldnn_timer.get_total_microseconds(), 0});
+    m_compile_profile.push_back({"MKLDNN primitives", mkldnn_timer.get_total_microseconds(), 0});
 
     m_compiler.reset(new codegen::Compiler());
     m_execution_engine.reset(new codegen::ExecutionEngine());
 
     m_compiler->set_precompiled_header_source(pch_header_source);
 
+    // The clang phase includes the optimization of the LLVM IR
+    stopwatch clang_timer;
+    clang_timer.start();
     auto codegen_module = m_compiler->compile(code);
+    clang_timer.stop();
+    size_t pch_time = m_compiler->get_precompiled_header_microseconds();
+    m_compile_profile.push_back({"precompiled header", pch_time, 0});
+    m_compile_profile.push_back({"clang", clang_timer.get_microseconds() - pch_time, 0});
 
     if (codegen_module == nullptr)
     {
         throw runtime_error("function failed to compile");
     }
+    stopwatch llvm_timer;
+    llvm_timer.start();
     m_execution_engine->add_module(codegen_module);
     m_execution_engine->finalize();
     m_compiled_function = m_execution_engine->find_function<EntryPoint_t>(m_function_name);
+    llvm_timer.stop();
+    m_compile_profile.push_back({"LLVM code generation", llvm_timer.get_microseconds(), 0});
 
     if (m_compiled_function == nullptr)
     {
@@ -968,6 +1189,11 @@ using namespace ngraph::runtime;
         }
     }
 
+    if (m_config.tracing)
+    {
+        m_trace_function_id = register_trace_function(m_function_name, m_op_attrs);
+    }
+
     m_is_compiled = true;
     if (m_release_function)
     {
@@ -1020,6 +1246,8 @@ void runtime::cpu::CPU_ExternalFunction::build()
     }
 
     m_mkldnn_emitter.reset(new MKLDNNEmitter());
+    NGRAPH_DEBUG << "Building " << m_function_name << " with " << isa_name(m_isa)
+                 << " kernels (host supports " << isa_name(get_host_isa()) << ")";
 
     ngraph::pass::Manager pass_manager;
 
@@ -1030,7 +1258,8 @@ void runtime::cpu::CPU_ExternalFunction::build()
     pass_manager.register_pass<runtime::cpu::pass::LSTMFusion>();
     pass_manager.register_pass<runtime::cpu::pass::RNNFusion>();
     pass_manager.register_pass<runtime::cpu::pass::ConcatInputs>();
-    pass_manager.register_pass<ngraph::pass::AlgebraicSimplification>();
+    pass_manager.register_pass<ngraph::pass::AlgebraicSimplification>(m_config.fast_math);
+    pass_manager.register_pass<ngraph::pass::ReshapeSinking>();
     pass_manager.register_pass<ngraph::pass::CommonSubexpressionElimination>();
     pass_manager.register_pass<ngraph::pass::CoreFusion>();
     pass_manager.register_pass<runtime::cpu::pass::CPUFusion>();
@@ -1042,8 +1271,19 @@ void runtime::cpu::CPU_ExternalFunction::build()
     pass_manager.register_pass<ngraph::pass::ResultCopyElimination>();
     pass_manager.register_pass<ngraph::pass::GetOutputElementElimination>();
     pass_manager.register_pass<ngraph::pass::Liveness>();
-    pass_manager.register_pass<ngraph::pass::MemoryLayout>(s_memory_pool_alignment, true);
-    pass_manager.run_passes(m_function);
+    pass_manager.register_pass<ngraph::pass::MemoryLayout>(s_memory_pool_alignment,
+                                                           !m_config.memory_sharing);
+    {
+        // Timed ops report the ops they replaced
+        ReplacedNodeRecording recording(m_emit_timing);
+        pass_manager.run_passes(m_function);
+    }
+    add_pass_phases(m_compile_profile, pass_manager);
+
+    // MKLDNN primitives are created while their functors are built
+    stopwatch build_timer;
+    stopwatch mkldnn_timer;
+    build_timer.start();
 
     // Store layouts assigned for arguments
     for (const auto& parameter : m_function->get_parameters())
@@ -1131,10 +1371,16 @@ void runtime::cpu::CPU_ExternalFunction::build()
         if (c)
         {
             auto tv = node->get_outputs()[0].get_tensor_view();
-            tensor_data[tv->get_tensor().get_name()] = const_cast<void*>(c->get_data_ptr());
+            tensor_data[tv->get_tensor().get_name()] = get_constant_data(c);
         }
     }
 
+    // Buffers touched by every step, to derive inter-op dependencies
+    vector<vector<string>> step_reads;
+    vector<vector<string>> step_writes;
+    vector<size_t> step_costs;
+    unordered_map<string, size_t> tensor_sizes;
+
     for (shared_ptr<Node> node : m_function->get_ordered_ops())
     {
         if (node->is_parameter() || node->is_constant())
@@ -1167,29 +1413,102 @@ void runtime::cpu::CPU_ExternalFunction::build()
         }
 
         size_t functor_count = functors.size();
+        bool uses_mkldnn = runtime::cpu::mkldnn_utils::use_mkldnn_kernel(node.get());
+        if (uses_mkldnn)
+        {
+            mkldnn_timer.start();
+        }
         handler->second(this, node.get(), in, out);
+        if (uses_mkldnn)
+        {
+            mkldnn_timer.stop();
+        }
 
-        bool disable_caching = computes_result(node.get()) || possibly_overwritten(node.get());
-        auto enable = [&, in_names, out_names, disable_caching](CPURuntimeContext* ctx) -> bool {
-            bool en = false;
-            for (const auto& name : in_names)
+        // Ops can only be skipped if their outputs survive until the next call
+        bool disable_caching = computes_result(node.get()) || possibly_overwritten(node.get()) ||
+                               m_config.memory_sharing;
+        // Staleness entries are looked up now, so steps running concurrently never access
+        // the map. References to its elements stay valid when it grows.
+        vector<bool*> in_stale;
+        for (const auto& name : in_names)
+        {
+            in_stale.push_back(&tensor_stale[name]);
+        }
+        vector<bool*> out_stale;
+        for (const auto& name : out_names)
+        {
+            out_stale.push_back(&tensor_stale[name]);
+        }
+        auto enable = [in_stale, out_stale, disable_caching](CPURuntimeContext* ctx) -> bool {
+            bool en = disable_caching;
+            for (bool* stale : in_stale)
             {
-                if (tensor_stale[name] || disable_caching)
+                if (*stale)
                 {
                     en = true;
                 }
             }
-            for (const auto& name : out_names)
+            for (bool* stale : out_stale)
             {
-                tensor_stale[name] = en;
+                *stale = en;
             }
             return en;
         };
 
         enables.emplace_back(make_pair(enable, functors.size() - functor_count));
+        if (m_emit_timing)
+        {
+            m_timer_work.emplace_back(node->get_name().c_str(), 0, 0);
+            m_timer_work.back().set_work(*node);
+            m_timer_work.back().set_replaced_nodes(node->get_replaced_nodes());
+        }
+
+        size_t cost = 0;
+        for (const descriptor::Output& output : node->get_outputs())
+        {
+            auto& tensor = output.get_tensor_view()->get_tensor();
+            tensor_sizes[tensor.get_name()] = tensor.size();
+            cost += shape_size(output.get_shape());
+        }
+        for (const descriptor::Input& input : node->get_inputs())
+        {
+            auto& tensor = input.get_output().get_tensor_view()->get_tensor();
+            tensor_sizes[tensor.get_name()] = tensor.size();
+        }
+        step_reads.push_back(in_names);
+        step_writes.push_back(out_names);
+        step_costs.push_back(cost);
     }
 
-    executor = [&](CPURuntimeContext* ctx, vector<void*>& inputs, vector<void*>& outputs) {
+    // Run independent ops concurrently when the executor allows inter-op parallelism and
+    // the graph has branches large enough to be worth a task
+    vector<decltype(enables)::iterator> step_enables;
+    vector<decltype(functors)::iterator> step_functors;
+    m_inter_op_scheduler.reset();
+    if (get_cpu_executor()->get_inter_op_parallelism() > 1)
+    {
+        unique_ptr<InterOpScheduler> scheduler(
+            new InterOpScheduler(get_step_dependencies(step_reads, step_writes, tensor_sizes),
+                                 step_costs,
+                                 m_inter_op_threshold));
+        if (scheduler->has_parallelism())
+        {
+            m_inter_op_scheduler = move(scheduler);
+            auto functor = functors.begin();
+            for (auto it = enables.begin(); it != enables.end(); it++)
+            {
+                step_enables.push_back(it);
+                step_functors.push_back(functor);
+                std::advance(functor, it->second);
+            }
+        }
+        NGRAPH_DEBUG << "DEX inter-op scheduling "
+                     << (m_inter_op_scheduler ? "enabled" : "disabled") << " for "
+                     << m_function_name;
+    }
+
+    executor = [&, step_enables, step_functors](
+        CPURuntimeContext* ctx, vector<void*>& inputs, vector<void*>& outputs) {
         static bool first_iteration = true;
         for (auto& p : intermediates_offsets)
         {
@@ -1208,24 +1527,72 @@ void runtime::cpu::CPU_ExternalFunction::build()
             tensor_data[p.first] = outputs[p.second];
         }
 
+        if (m_inter_op_scheduler)
+        {
+            m_inter_op_scheduler->run([&](size_t step) {
+                const auto& p = *step_enables[step];
+                if (p.first(ctx) || first_iteration)
+                {
+                    // Steps run on one thread at a time, so each timer has one user
+                    if (m_emit_timing)
+                    {
+                        m_op_timers[step].start();
+                    }
+                    auto functor = step_functors[step];
+                    for (size_t j = 0; j < p.second; j++)
+                    {
+                        (*functor)(ctx);
+                        std::advance(functor, 1);
+                    }
+                    if (m_emit_timing)
+                    {
+                        m_op_timers[step].stop();
+                    }
+                }
+            });
+            first_iteration = false;
+            return;
+        }
+
         auto functor = functors.begin();
+        size_t step = 0;
         for (const auto& p : enables)
         {
             if (p.first(ctx) || first_iteration)
             {
+                if (m_emit_timing)
+                {
+                    m_op_timers[step].start();
+                }
                 for (size_t j = 0; j < p.second; j++)
                 {
                     (*functor)(ctx);
                     std::advance(functor, 1);
                 }
+                if (m_emit_timing)
+                {
+                    m_op_timers[step].stop();
+                }
             }
             else
             {
                 std::advance(functor, p.second);
             }
+            step++;
         }
         first_iteration = false;
     };
+    if (m_emit_timing)
+    {
+        m_op_timers.resize(enables.size());
+    }
+
+    build_timer.stop();
+    m_compile_profile.push_back({"build functors",
+                                 build_timer.get_microseconds() -
+                                     mkldnn_timer.get_total_microseconds(),
+                                 0});
+    m_compile_profile.push_back({"MKLDNN primitives", mkldnn_timer.get_total_microseconds(), 0});
 
     m_is_built = true;
 
@@ -1272,6 +1639,10 @@ void runtime::cpu::CPU_ExternalFunction::emit_debug_function_entry(
 {
     if (m_emit_timing)
     {
+        if (m_emit_hardware_counters)
+        {
+            writer << "hardware_start_counts = hardware_counters.read();\n";
+        }
         writer << "timers[" << m_name_index_map[node->get_name()] << "].start();\n";
     }
 }
@@ -1284,7 +1655,13 @@ void runtime::cpu::CPU_ExternalFunction::emit_debug_function_exit(
 {
     if (m_emit_timing)
     {
-        writer << "timers[" << m_name_index_map[node->get_name()] << "].stop();\n";
+        size_t index = m_name_index_map[node->get_name()];
+        writer << "timers[" << index << "].stop();\n";
+        if (m_emit_hardware_counters)
+        {
+            writer << "hardware_counts[" << index
+                   << "] += hardware_counters.read() - hardware_start_counts;\n";
+        }
     }
 }
 
@@ -30,10 +30,18 @@
 #include "ngraph/codegen/compiler.hpp"
 #include "ngraph/codegen/execution_engine.hpp"
 #include "ngraph/function.hpp"
+#include "ngraph/op/constant.hpp"
+#include "ngraph/runtime/aligned_buffer.hpp"
+#include "ngraph/runtime/compile_profile.hpp"
+#include "ngraph/runtime/cpu/cpu_backend_config.hpp"
 #include "ngraph/runtime/cpu/cpu_call_frame.hpp"
+#include "ngraph/runtime/cpu/cpu_inter_op_scheduler.hpp"
+#include "ngraph/runtime/cpu/cpu_isa.hpp"
 #include "ngraph/runtime/cpu/cpu_layout_descriptor.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view_wrapper.hpp"
 #include "ngraph/runtime/cpu/mkldnn_emitter.hpp"
+#include "ngraph/runtime/performance_counter.hpp"
+#include "ngraph/util.hpp"
 
 namespace ngraph
 {
@@ -68,13 +76,20 @@ namespace ngraph
                 }
             };
 
+            namespace executor
+            {
+                class CPUExecutor;
+            }
+
             class CPU_ExternalFunction : public std::enable_shared_from_this<CPU_ExternalFunction>
             {
                 friend class CPU_Backend;
 
             public:
-                CPU_ExternalFunction(const std::shared_ptr<ngraph::Function>& function,
-                                     bool release_function = true);
+                CPU_ExternalFunction(
+                    const std::shared_ptr<ngraph::Function>& function,
+                    bool release_function = true,
+                    const CPUBackendConfig& config = CPUBackendConfig::from_environment());
                 ~CPU_ExternalFunction();
                 std::shared_ptr<ngraph::runtime::cpu::CPU_CallFrame> make_call_frame();
 
@@ -85,10 +100,19 @@ namespace ngraph
                     return m_memory_buffer_sizes;
                 }
                 const std::vector<OpAttributes>& get_op_attrs() const { return m_op_attrs; }
+                /// \brief Function id of the ops in the Tracer, with tracing enabled
+                uint32_t get_trace_function_id() const { return m_trace_function_id; }
                 const std::unique_ptr<MKLDNNEmitter>& get_mkldnn_emitter() const
                 {
                     return m_mkldnn_emitter;
                 }
+                /// \brief Time spent in the passes, source emission, MKLDNN primitive
+                ///        creation, clang and LLVM code generation, or in building the
+                ///        functors with direct execution
+                const std::vector<runtime::CompilePhase>& get_compile_profile() const
+                {
+                    return m_compile_profile;
+                }
 
                 const std::string& get_function_name() const { return m_function_name; }
                 const std::shared_ptr<ngraph::Function> get_function() { return m_function; }
@@ -106,6 +130,23 @@ namespace ngraph
                     return executor;
                 }
                 bool is_direct_execution() const { return m_direct_execution; }
+                const CPUBackendConfig& get_config() const { return m_config; }
+                /// ISA level used to select DEX kernel variants
+                ISA get_isa() const { return m_isa; }
+                /// True if the DEX steps of the built function run concurrently on the
+                /// inter-op scheduler rather than in order
+                bool is_inter_op_scheduled() const { return m_inter_op_scheduler != nullptr; }
+                /// ISA level of the kernel variant selected for a node; generic if the node
+                /// did not use a kernel from the registry
+                ISA get_kernel_isa(const std::string& node_name) const;
+                void set_kernel_isa(const std::string& node_name, ISA isa)
+                {
+                    m_kernel_isa[node_name] = isa;
+                }
+                /// Thread pools the compiled function runs on; the default executor unless
+                /// the owning backend was configured with its own
+                const std::shared_ptr<executor::CPUExecutor>& get_cpu_executor() const;
+
             protected:
                 void build();
                 void compile();
@@ -132,28 +173,50 @@ namespace ngraph
                     const std::unordered_map<const Node*, std::string>& node_cache);
                 std::string emit_op_as_function(const Node&, const std::string& function_name);
                 std::string strip_comments(const std::string&);
+                // Constant data as seen by the compiled function; a copy on the executor's
+                // NUMA node when it is bound to one
+                void* get_constant_data(const ngraph::op::Constant* constant);
+                // For every DEX step, the earlier steps it must wait for: producers of its
+                // inputs and every earlier user of the buffers (or pool ranges) it overwrites
+                std::vector<std::vector<size_t>>
+                    get_step_dependencies(const std::vector<std::vector<std::string>>& reads,
+                                          const std::vector<std::vector<std::string>>& writes,
+                                          const std::unordered_map<std::string, size_t>& sizes);
                 void release_function() { m_function = nullptr; }
                 std::shared_ptr<ngraph::Function> m_function;
+                CPUBackendConfig m_config;
                 bool m_release_function;
                 bool m_is_compiled;
                 EntryPoint m_compiled_function;
                 std::unique_ptr<codegen::Compiler> m_compiler;
                 std::unique_ptr<codegen::ExecutionEngine> m_execution_engine;
                 bool m_emit_timing;
+                // Counts the hardware events of each op along with the timers; not emitted
+                // with TBB, which runs ops on other threads
+                bool m_emit_hardware_counters;
                 bool m_use_tbb;
 
                 std::unordered_map<std::string, std::string> m_variable_name_map;
                 std::map<std::string, size_t> m_name_index_map;
+                // Work estimated from the shapes of each timed op, by timer index
+                std::vector<PerformanceCounter> m_timer_work;
+                // Timers of the ops run by DEX, by timer index, which is the step index.
+                // DEX only runs m_function, which can't contain a FunctionCall, so unlike
+                // codegen there are no timers for the ops of called functions.
+                std::vector<stopwatch> m_op_timers;
 
                 // Because we are directly accessing the constant data stored in the
                 // Constant ops we need to keep a list of shared_ptr to each Constant
                 // so they don't get freed before we are done with them
                 std::vector<std::shared_ptr<Node>> m_active_constants;
+                std::vector<std::unique_ptr<AlignedBuffer>> m_numa_constants;
 
                 LayoutDescriptorPtrs parameter_layout_descriptors;
                 LayoutDescriptorPtrs result_layout_descriptors;
                 std::vector<size_t> m_memory_buffer_sizes;
                 std::vector<OpAttributes> m_op_attrs;
+                uint32_t m_trace_function_id;
+                std::vector<runtime::CompilePhase> m_compile_profile;
 
                 std::unique_ptr<MKLDNNEmitter> m_mkldnn_emitter;
 
@@ -169,6 +232,12 @@ namespace ngraph
                 std::unordered_map<std::string, size_t> function_input_index, function_output_index;
                 bool m_is_built;
                 bool m_direct_execution;
+                // Minimum output element count for a DEX op to be run as a separate task
+                size_t m_inter_op_threshold;
+                std::unique_ptr<InterOpScheduler> m_inter_op_scheduler;
+                ISA m_isa;
+                std::unordered_map<std::string, ISA> m_kernel_isa;
+                std::shared_ptr<executor::CPUExecutor> m_cpu_executor;
             };
         }
     }
@@ -0,0 +1,125 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#include <tbb/task_group.h>
+
+#include "ngraph/runtime/cpu/cpu_inter_op_scheduler.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+runtime::cpu::InterOpScheduler::InterOpScheduler(const vector<vector<size_t>>& predecessors,
+                                                 const vector<size_t>& costs,
+                                                 size_t threshold)
+    : m_successors(predecessors.size())
+    , m_predecessor_counts(predecessors.size())
+    , m_costs(costs)
+    , m_threshold(threshold)
+    , m_has_parallelism(false)
+{
+    // Steps with the same longest-path depth are never ordered with respect to each other,
+    // so two large steps at one depth can run concurrently
+    vector<size_t> depth(predecessors.size(), 0);
+    vector<size_t> large_steps_at_depth(predecessors.size(), 0);
+    for (size_t step = 0; step < predecessors.size(); step++)
+    {
+        m_predecessor_counts[step] = predecessors[step].size();
+        if (predecessors[step].empty())
+        {
+            m_roots.push_back(step);
+        }
+        for (size_t predecessor : predecessors[step])
+        {
+            m_successors[predecessor].push_back(step);
+            depth[step] = max(depth[step], depth[predecessor] + 1);
+        }
+        if (is_large(step) && ++large_steps_at_depth[depth[step]] > 1)
+        {
+            m_has_parallelism = true;
+        }
+    }
+}
+
+void runtime::cpu::InterOpScheduler::run(const Task& task)
+{
+    unique_ptr<atomic<size_t>[]> pending(new atomic<size_t>[m_successors.size()]);
+    for (size_t step = 0; step < m_successors.size(); step++)
+    {
+        pending[step].store(m_predecessor_counts[step], memory_order_relaxed);
+    }
+
+    tbb::task_group group;
+    function<void(vector<size_t>&)> execute;
+
+    // Queues ready steps: small ones and the first large one stay on this thread, the
+    // other large ones become tasks for idle workers to steal
+    auto dispatch = [&](const vector<size_t>& ready, vector<size_t>& local) {
+        bool kept_large = false;
+        for (size_t step : ready)
+        {
+            if (is_large(step) && kept_large)
+            {
+                group.run([&execute, step]() {
+                    vector<size_t> steps{step};
+                    execute(steps);
+                });
+            }
+            else
+            {
+                kept_large |= is_large(step);
+                local.push_back(step);
+            }
+        }
+    };
+
+    execute = [&](vector<size_t>& local) {
+        vector<size_t> ready;
+        while (!local.empty())
+        {
+            size_t step = local.back();
+            local.pop_back();
+            task(step);
+
+            ready.clear();
+            for (size_t successor : m_successors[step])
+            {
+                if (pending[successor].fetch_sub(1, memory_order_acq_rel) == 1)
+                {
+                    ready.push_back(successor);
+                }
+            }
+            dispatch(ready, local);
+        }
+    };
+
+    try
+    {
+        vector<size_t> local;
+        dispatch(m_roots, local);
+        execute(local);
+    }
+    catch (...)
+    {
+        group.cancel();
+        group.wait();
+        throw;
+    }
+    group.wait();
+}
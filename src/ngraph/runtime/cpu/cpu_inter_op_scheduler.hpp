@@ -0,0 +1,67 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            /// \brief Runs the steps of a DEX function concurrently as their dependencies
+            ///        complete.
+            ///
+            /// Each step keeps a count of unfinished predecessors. The thread finishing a
+            /// step runs one newly ready successor itself and hands the remaining ones to the
+            /// TBB scheduler of the calling arena, whose workers steal them. Steps cheaper than
+            /// the threshold are never handed off; they run on the thread that readied them.
+            class InterOpScheduler
+            {
+            public:
+                using Task = std::function<void(size_t step)>;
+
+                /// \param predecessors For every step, the steps that must finish before it
+                ///        may start. Steps are numbered in a valid sequential order.
+                /// \param costs Estimated work of every step, in output elements.
+                /// \param threshold Minimum cost for a step to be run as a separate task.
+                InterOpScheduler(const std::vector<std::vector<size_t>>& predecessors,
+                                 const std::vector<size_t>& costs,
+                                 size_t threshold);
+
+                /// \brief True if at least two steps above the threshold may run at the same
+                ///        time, i.e. scheduling can beat running the steps in order.
+                bool has_parallelism() const { return m_has_parallelism; }
+                /// \brief Runs task for every step and returns when all have finished.
+                ///        Rethrows the first exception thrown by a task.
+                void run(const Task& task);
+
+            private:
+                bool is_large(size_t step) const { return m_costs[step] >= m_threshold; }
+                std::vector<std::vector<size_t>> m_successors;
+                std::vector<size_t> m_predecessor_counts;
+                std::vector<size_t> m_roots;
+                std::vector<size_t> m_costs;
+                size_t m_threshold;
+                bool m_has_parallelism;
+            };
+        }
+    }
+}
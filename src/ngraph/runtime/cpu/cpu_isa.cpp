@@ -0,0 +1,141 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cstdint>
+#include <cstdlib>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+#include "ngraph/except.hpp"
+#include "ngraph/log.hpp"
+#include "ngraph/runtime/cpu/cpu_isa.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+#if defined(__x86_64__) || defined(__i386__)
+static uint64_t read_xcr0()
+{
+    uint32_t eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<uint64_t>(edx) << 32) | eax;
+}
+
+static runtime::cpu::ISA detect_host_isa()
+{
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+    {
+        return runtime::cpu::ISA::generic;
+    }
+
+    // The OS must save the extended register state for AVX code to be usable
+    bool osxsave = (ecx & (1u << 27)) != 0;
+    if (!osxsave)
+    {
+        return runtime::cpu::ISA::generic;
+    }
+    uint64_t xcr0 = read_xcr0();
+    bool os_avx = (xcr0 & 0x6) == 0x6;
+    bool os_avx512 = (xcr0 & 0xe6) == 0xe6;
+    bool fma = (ecx & (1u << 12)) != 0;
+
+    if (__get_cpuid_max(0, nullptr) < 7)
+    {
+        return runtime::cpu::ISA::generic;
+    }
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    bool avx2 = (ebx & (1u << 5)) != 0;
+    bool avx512f = (ebx & (1u << 16)) != 0;
+    bool avx512dq = (ebx & (1u << 17)) != 0;
+    bool avx512bw = (ebx & (1u << 30)) != 0;
+    bool avx512vl = (ebx & (1u << 31)) != 0;
+    bool avx512vnni = (ecx & (1u << 11)) != 0;
+
+    runtime::cpu::ISA isa = runtime::cpu::ISA::generic;
+    if (os_avx && avx2 && fma)
+    {
+        isa = runtime::cpu::ISA::avx2;
+        if (os_avx512 && avx512f && avx512dq && avx512bw && avx512vl)
+        {
+            isa = runtime::cpu::ISA::avx512;
+            if (avx512vnni)
+            {
+                isa = runtime::cpu::ISA::avx512_vnni;
+            }
+        }
+    }
+    return isa;
+}
+#else
+static runtime::cpu::ISA detect_host_isa()
+{
+    return runtime::cpu::ISA::generic;
+}
+#endif
+
+runtime::cpu::ISA runtime::cpu::get_host_isa()
+{
+    static const ISA s_host_isa = detect_host_isa();
+    return s_host_isa;
+}
+
+runtime::cpu::ISA runtime::cpu::get_isa()
+{
+    ISA isa = get_host_isa();
+    const char* env_isa = std::getenv("NGRAPH_CPU_ISA");
+    if (env_isa != nullptr)
+    {
+        ISA requested = isa_from_string(env_isa);
+        if (requested > isa)
+        {
+            NGRAPH_WARN << "NGRAPH_CPU_ISA=" << env_isa << " is not supported by this host, using "
+                        << isa_name(isa);
+        }
+        else
+        {
+            isa = requested;
+        }
+    }
+    return isa;
+}
+
+const char* runtime::cpu::isa_name(ISA isa)
+{
+    switch (isa)
+    {
+    case ISA::generic: return "generic";
+    case ISA::avx2: return "avx2";
+    case ISA::avx512: return "avx512";
+    case ISA::avx512_vnni: return "avx512_vnni";
+    }
+    return "unknown";
+}
+
+runtime::cpu::ISA runtime::cpu::isa_from_string(const string& name)
+{
+    for (size_t i = 0; i < ISA_COUNT; i++)
+    {
+        ISA isa = static_cast<ISA>(i);
+        if (name == isa_name(isa))
+        {
+            return isa;
+        }
+    }
+    throw ngraph_error("Unknown CPU ISA level '" + name + "'");
+}
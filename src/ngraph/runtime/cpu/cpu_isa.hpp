@@ -0,0 +1,62 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#pragma once
+
+#include <string>
+
+// Kernels that are compiled once per ISA level live in an inline namespace named
+// after the level. Translation units built with the default flags get the generic
+// variant; the per-ISA builds of kernel/isa_kernels.cpp override this definition.
+#ifndef NGRAPH_CPU_ISA_NAMESPACE
+#define NGRAPH_CPU_ISA_NAMESPACE generic
+#endif
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            /// \brief Instruction set levels for which DEX kernels may be compiled.
+            ///
+            /// Levels are ordered; a host supporting a level supports all lower levels.
+            enum class ISA
+            {
+                generic = 0,
+                avx2,
+                avx512,
+                avx512_vnni
+            };
+
+            constexpr size_t ISA_COUNT = static_cast<size_t>(ISA::avx512_vnni) + 1;
+
+            /// \brief Returns the highest ISA level supported by the host CPU and OS.
+            ///        Detected once through CPUID and cached.
+            ISA get_host_isa();
+
+            /// \brief Returns the ISA level kernels should be selected for.
+            ///
+            /// This is the host level, capped by the NGRAPH_CPU_ISA environment variable
+            /// (generic, avx2, avx512 or avx512_vnni) so that each variant can be exercised
+            /// on a single machine.
+            ISA get_isa();
+
+            const char* isa_name(ISA isa);
+            ISA isa_from_string(const std::string& name);
+        }
+    }
+}
@@ -0,0 +1,180 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <dlfcn.h>
+
+#include "ngraph/file_util.hpp"
+#include "ngraph/log.hpp"
+#include "ngraph/runtime/cpu/cpu_kernel_registry.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+// The per-ISA kernel libraries that were built next to the CPU backend. generic only ends
+// the list; its kernels are part of the backend.
+static const runtime::cpu::ISA s_built_variants[] = {
+#ifdef NGRAPH_CPU_ISA_AVX2_ENABLE
+    runtime::cpu::ISA::avx2,
+#endif
+#ifdef NGRAPH_CPU_ISA_AVX512_ENABLE
+    runtime::cpu::ISA::avx512,
+#endif
+#ifdef NGRAPH_CPU_ISA_AVX512_VNNI_ENABLE
+    runtime::cpu::ISA::avx512_vnni,
+#endif
+    runtime::cpu::ISA::generic};
+
+// Finds the full path of the CPU backend library, which the kernel libraries live next to
+static string find_my_file()
+{
+    Dl_info dl_info;
+    dladdr(reinterpret_cast<void*>(find_my_file), &dl_info);
+    return dl_info.dli_fname;
+}
+
+runtime::cpu::KernelRegistry& runtime::cpu::KernelRegistry::get()
+{
+    static KernelRegistry s_registry;
+    return s_registry;
+}
+
+runtime::cpu::KernelRegistry::KernelRegistry()
+{
+    m_variants.fill(false);
+    register_table(kernel::generic_kernel_table);
+
+    // Only the levels the host supports are loaded, so no code built for a higher level is
+    // ever mapped. The libraries stay loaded for the life of the process.
+    ISA host_isa = get_host_isa();
+    string my_directory = file_util::get_directory(find_my_file());
+    for (ISA isa : s_built_variants)
+    {
+        if (isa == ISA::generic || isa > host_isa)
+        {
+            continue;
+        }
+        string library_name = string("libcpu_kernels_") + isa_name(isa) + SHARED_LIB_EXT;
+        string library_path = file_util::path_join(my_directory, library_name);
+        void* handle = dlopen(library_path.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (!handle)
+        {
+            NGRAPH_WARN << "Failed to load DEX kernels for " << isa_name(isa) << ": "
+                        << dlerror();
+            continue;
+        }
+        auto table = reinterpret_cast<const KernelTable*>(
+            dlsym(handle, NGRAPH_CPU_KERNEL_TABLE_SYMBOL));
+        if (!table || table->isa != isa)
+        {
+            NGRAPH_WARN << "No DEX kernel table for " << isa_name(isa) << " in "
+                        << library_path;
+            dlclose(handle);
+            continue;
+        }
+        register_table(*table);
+    }
+}
+
+void runtime::cpu::KernelRegistry::register_table(const KernelTable& table)
+{
+    // In the order of KernelElementType
+    static const element::Type* element_types[] = {&element::boolean,
+                                                   &element::f32,
+                                                   &element::f64,
+                                                   &element::i8,
+                                                   &element::i16,
+                                                   &element::i32,
+                                                   &element::i64,
+                                                   &element::u8,
+                                                   &element::u16,
+                                                   &element::u32,
+                                                   &element::u64};
+    for (size_t i = 0; i < table.size; i++)
+    {
+        const KernelTableEntry& entry = table.entries[i];
+        const element::Type& et = *element_types[static_cast<size_t>(entry.element_type)];
+        if (entry.unary)
+        {
+            register_kernel(entry.name, et, table.isa, entry.unary);
+        }
+        if (entry.binary)
+        {
+            register_kernel(entry.name, et, table.isa, entry.binary);
+        }
+    }
+    m_variants[static_cast<size_t>(table.isa)] = true;
+}
+
+bool runtime::cpu::KernelRegistry::has_variant(ISA isa) const
+{
+    return m_variants[static_cast<size_t>(isa)];
+}
+
+void runtime::cpu::KernelRegistry::register_kernel(const string& name,
+                                                   const element::Type& et,
+                                                   ISA isa,
+                                                   UnaryElementwiseKernel kernel)
+{
+    auto& variants = m_unary_kernels[make_pair(name, et)];
+    variants[static_cast<size_t>(isa)] = kernel;
+}
+
+void runtime::cpu::KernelRegistry::register_kernel(const string& name,
+                                                   const element::Type& et,
+                                                   ISA isa,
+                                                   BinaryElementwiseKernel kernel)
+{
+    auto& variants = m_binary_kernels[make_pair(name, et)];
+    variants[static_cast<size_t>(isa)] = kernel;
+}
+
+template <typename KERNEL>
+KERNEL runtime::cpu::KernelRegistry::find(const VariantTable<KERNEL>& table,
+                                          const string& name,
+                                          const element::Type& et,
+                                          ISA isa,
+                                          ISA* selected)
+{
+    auto it = table.find(make_pair(name, et));
+    if (it == table.end())
+    {
+        return nullptr;
+    }
+    for (size_t level = static_cast<size_t>(isa) + 1; level > 0; level--)
+    {
+        if (it->second[level - 1] != nullptr)
+        {
+            if (selected)
+            {
+                *selected = static_cast<ISA>(level - 1);
+            }
+            return it->second[level - 1];
+        }
+    }
+    return nullptr;
+}
+
+runtime::cpu::UnaryElementwiseKernel runtime::cpu::KernelRegistry::find_unary(
+    const string& name, const element::Type& et, ISA isa, ISA* selected) const
+{
+    return find(m_unary_kernels, name, et, isa, selected);
+}
+
+runtime::cpu::BinaryElementwiseKernel runtime::cpu::KernelRegistry::find_binary(
+    const string& name, const element::Type& et, ISA isa, ISA* selected) const
+{
+    return find(m_binary_kernels, name, et, isa, selected);
+}
@@ -0,0 +1,141 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "ngraph/runtime/cpu/cpu_isa.hpp"
+#include "ngraph/type/element_type.hpp"
+
+// The per-ISA kernel libraries are built with hidden visibility and export only their
+// table, under this unmangled name
+#define NGRAPH_CPU_KERNEL_TABLE_SYMBOL "ngraph_cpu_kernel_table"
+#define NGRAPH_CPU_KERNEL_TABLE_API extern "C" __attribute__((visibility("default")))
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            using UnaryElementwiseKernel = void (*)(void* input0, void* output, size_t count);
+            using BinaryElementwiseKernel = void (*)(void* input0,
+                                                     void* input1,
+                                                     void* output,
+                                                     size_t count);
+
+            /// \brief Element types of the kernels in a KernelTable
+            enum class KernelElementType
+            {
+                boolean,
+                f32,
+                f64,
+                i8,
+                i16,
+                i32,
+                i64,
+                u8,
+                u16,
+                u32,
+                u64
+            };
+
+            /// \brief A kernel of a KernelTable; one of unary and binary is set
+            struct KernelTableEntry
+            {
+                const char* name;
+                KernelElementType element_type;
+                UnaryElementwiseKernel unary;
+                BinaryElementwiseKernel binary;
+            };
+
+            /// \brief The kernels of one ISA build of kernel/isa_kernels.cpp. This is
+            ///        constant data, so it can be read before the level is known to be
+            ///        supported by the host.
+            struct KernelTable
+            {
+                ISA isa;
+                const KernelTableEntry* entries;
+                size_t size;
+            };
+
+            /// \brief Table of DEX kernels compiled for several ISA levels.
+            ///
+            /// The kernel table of each per-ISA build of kernel/isa_kernels.cpp is
+            /// registered here. The generic table is part of the CPU backend; the table of
+            /// a higher level is loaded from its library only if the host supports the
+            /// level. Lookups return the variant for the highest registered level
+            /// that does not exceed the requested one, or nullptr if no variant was
+            /// registered.
+            class KernelRegistry
+            {
+            public:
+                static KernelRegistry& get();
+
+                void register_kernel(const std::string& name,
+                                     const element::Type& et,
+                                     ISA isa,
+                                     UnaryElementwiseKernel kernel);
+                void register_kernel(const std::string& name,
+                                     const element::Type& et,
+                                     ISA isa,
+                                     BinaryElementwiseKernel kernel);
+
+                /// \param selected Set to the level of the returned variant, if any
+                UnaryElementwiseKernel find_unary(const std::string& name,
+                                                  const element::Type& et,
+                                                  ISA isa,
+                                                  ISA* selected = nullptr) const;
+                BinaryElementwiseKernel find_binary(const std::string& name,
+                                                    const element::Type& et,
+                                                    ISA isa,
+                                                    ISA* selected = nullptr) const;
+
+                /// \brief True if the kernels of this level were built and registered
+                bool has_variant(ISA isa) const;
+
+            private:
+                KernelRegistry();
+                void register_table(const KernelTable& table);
+
+                template <typename KERNEL>
+                using VariantTable =
+                    std::map<std::pair<std::string, element::Type>, std::array<KERNEL, ISA_COUNT>>;
+
+                template <typename KERNEL>
+                static KERNEL find(const VariantTable<KERNEL>& table,
+                                   const std::string& name,
+                                   const element::Type& et,
+                                   ISA isa,
+                                   ISA* selected);
+
+                VariantTable<UnaryElementwiseKernel> m_unary_kernels;
+                VariantTable<BinaryElementwiseKernel> m_binary_kernels;
+                std::array<bool, ISA_COUNT> m_variants;
+            };
+
+            namespace kernel
+            {
+                // The generic build of kernel/isa_kernels.cpp, part of the CPU backend
+                extern const KernelTable generic_kernel_table;
+            }
+        }
+    }
+}
@@ -19,10 +19,7 @@
 #include <chrono>
 #include <cstdint>
 
-#define TBB_PREVIEW_GLOBAL_CONTROL 1
 #include <tbb/flow_graph.h>
-#include <tbb/global_control.h>
-#include <tbb/task_scheduler_init.h>
 
 namespace mkldnn
 {
@@ -50,14 +47,17 @@ namespace ngraph
             extern "C" {
             struct CPURuntimeContext
             {
-                int64_t* op_durations;
+                // Id of the current call in the Tracer, 0 if the call is not traced
+                uint64_t trace_call_id;
+                uint32_t trace_function_id;
                 bool* p_en;
                 mkldnn::primitive* const* mkldnn_primitives;
                 std::vector<AlignedBuffer*> memory_buffers;
                 char* const* mkldnn_workspaces;
                 tbb::flow::graph* G;
-                tbb::global_control* c;
-                tbb::task_scheduler_init* init;
+                // Arguments of the current call, for the nodes of the persistent flow graph
+                void** inputs;
+                void** outputs;
             };
             }
         }
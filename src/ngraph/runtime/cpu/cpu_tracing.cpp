@@ -14,64 +14,29 @@
 * limitations under the License.
 *******************************************************************************/
 
-#include <fstream>
-#include <map>
+#include "ngraph/runtime/cpu/cpu_tracing.hpp"
+#include "ngraph/runtime/tracer.hpp"
 
-#include "cpu_tracing.hpp"
+using namespace std;
+using namespace ngraph;
 
-void ngraph::runtime::cpu::to_json(nlohmann::json& json, const TraceEvent& event)
+uint32_t runtime::cpu::register_trace_function(const string& name,
+                                               const vector<OpAttributes>& op_attrs)
 {
-    std::map<std::string, std::string> args;
-    for (size_t i = 0; i < event.Inputs.size(); i++)
+    vector<TraceOp> ops;
+    for (const OpAttributes& attrs : op_attrs)
     {
-        args["Input" + std::to_string(i + 1)] = event.Inputs[i];
+        TraceOp op;
+        op.name = attrs.Description;
+        for (size_t i = 0; i < attrs.Inputs.size(); i++)
+        {
+            op.args["Input" + to_string(i + 1)] = attrs.Inputs[i];
+        }
+        for (size_t i = 0; i < attrs.Outputs.size(); i++)
+        {
+            op.args["Output" + to_string(i + 1)] = attrs.Outputs[i];
+        }
+        ops.push_back(op);
     }
-    for (size_t i = 0; i < event.Outputs.size(); i++)
-    {
-        args["Output" + std::to_string(i + 1)] = event.Outputs[i];
-    }
-
-    json = nlohmann::json{{"ph", event.Phase},
-                          {"cat", event.Category},
-                          {"name", event.Name},
-                          {"pid", event.PID},
-                          {"tid", event.TID},
-                          {"ts", event.Timestamp},
-                          {"dur", event.Duration},
-                          {"args", args}};
-}
-
-void ngraph::runtime::cpu::GenerateTimeline(const std::vector<OpAttributes>& op_attrs,
-                                            int64_t* op_durations,
-                                            const std::string& file_name)
-{
-    nlohmann::json timeline;
-    std::list<TraceEvent> trace;
-    std::ofstream out(file_name);
-
-    int64_t ts = 0;
-    for (size_t i = 0; i < op_attrs.size(); i++)
-    {
-        trace.emplace_back("X",
-                           "Op",
-                           op_attrs[i].Description,
-                           0,
-                           0,
-                           ts,
-                           op_durations[i],
-                           op_attrs[i].Outputs,
-                           op_attrs[i].Inputs);
-        ts += op_durations[i];
-    }
-
-    timeline["traceEvents"] = trace;
-    out << timeline;
-    out.close();
-
-    return;
-}
-
-bool ngraph::runtime::cpu::IsTracingEnabled()
-{
-    return (std::getenv("NGRAPH_CPU_TRACING") != nullptr);
+    return Tracer::get().add_function(name, move(ops));
 }
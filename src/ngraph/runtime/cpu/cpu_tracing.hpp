@@ -21,7 +21,6 @@
 #include <vector>
 
 #include "ngraph/runtime/cpu/cpu_external_function.hpp"
-#include "nlohmann/json.hpp"
 
 namespace ngraph
 {
@@ -29,49 +28,11 @@ namespace ngraph
     {
         namespace cpu
         {
-            struct TraceEvent
-            {
-                // This should be a single character
-                // but the JSON encoder nlohmann::json
-                // is broken and doesn't handle character fields
-                std::string Phase;
-                std::string Category;
-                const std::string& Name;
-                unsigned int PID;
-                unsigned int TID;
-                int64_t Timestamp;
-                int64_t Duration;
-                const std::vector<std::string>& Outputs;
-                const std::vector<std::string>& Inputs;
-
-                TraceEvent(const std::string& ph,
-                           const std::string& cat,
-                           const std::string& name,
-                           unsigned int pid,
-                           unsigned int tid,
-                           int64_t ts,
-                           int64_t dur,
-                           const std::vector<std::string>& outputs,
-                           const std::vector<std::string>& inputs)
-                    : Phase(ph)
-                    , Category(cat)
-                    , Name(name)
-                    , PID(pid)
-                    , TID(tid)
-                    , Timestamp(ts)
-                    , Duration(dur)
-                    , Outputs(outputs)
-                    , Inputs(inputs)
-                {
-                }
-            };
-
-            void to_json(nlohmann::json& json, const TraceEvent& event);
-
-            void GenerateTimeline(const std::vector<OpAttributes>& op_attrs,
-                                  int64_t* op_durations,
-                                  const std::string& file_name);
-            bool IsTracingEnabled();
+            /// \brief Registers the ops of a compiled function with the runtime::Tracer,
+            ///        named by their description and annotated with their tensors
+            /// \return The function id the generated code records the ops with
+            uint32_t register_trace_function(const std::string& name,
+                                             const std::vector<OpAttributes>& op_attrs);
         }
     }
 }
@@ -14,9 +14,8 @@
 * limitations under the License.
 *******************************************************************************/
 
-#include <thread>
-
 #include "eigen_thread_pool.hpp"
+#include "ngraph/runtime/cpu/cpu_executor.hpp"
 
 namespace ngraph
 {
@@ -26,25 +25,23 @@ namespace ngraph
         {
             namespace eigen
             {
-                static int GetNumCores()
-                {
-                    const auto omp_num_threads = std::getenv("OMP_NUM_THREADS");
-                    int count;
+                static thread_local Eigen::ThreadPoolDevice* s_thread_pool_device = nullptr;
 
-                    if (omp_num_threads && (count = std::atoi(omp_num_threads)))
-                    {
-                        return count;
-                    }
-                    else
+                Eigen::ThreadPoolDevice& get_thread_pool_device()
+                {
+                    if (s_thread_pool_device == nullptr)
                     {
-                        count = std::thread::hardware_concurrency() >> 1;
+                        return executor::CPUExecutor::get_default()->get_eigen_device();
                     }
-                    return count ? count : 1;
+                    return *s_thread_pool_device;
                 }
 
-                Eigen::ThreadPool global_thread_pool(GetNumCores());
-                Eigen::ThreadPoolDevice global_thread_pool_device(&global_thread_pool,
-                                                                  global_thread_pool.NumThreads());
+                Eigen::ThreadPoolDevice* set_thread_pool_device(Eigen::ThreadPoolDevice* device)
+                {
+                    Eigen::ThreadPoolDevice* previous = s_thread_pool_device;
+                    s_thread_pool_device = device;
+                    return previous;
+                }
             }
         }
     }
@@ -27,8 +27,15 @@ namespace ngraph
         {
             namespace eigen
             {
-                extern Eigen::ThreadPool global_thread_pool;
-                extern Eigen::ThreadPoolDevice global_thread_pool_device;
+                /// \brief Device used by Eigen kernels on the calling thread.
+                ///
+                /// This is the device of the executor running the current call, or the
+                /// default executor's device outside of one.
+                Eigen::ThreadPoolDevice& get_thread_pool_device();
+
+                /// \brief Sets the device for the calling thread and returns the previous
+                ///        one; nullptr selects the default executor's device.
+                Eigen::ThreadPoolDevice* set_thread_pool_device(Eigen::ThreadPoolDevice* device);
             }
         }
     }
@@ -0,0 +1,70 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+// This file is compiled once per ISA level with NGRAPH_CPU_ISA_NAMESPACE set to the
+// level and the matching -m flags (see CMakeLists.txt). The generic build is part of the
+// CPU backend. Every other level is a library of its own, built with hidden visibility:
+// the Eigen and standard library templates the kernels instantiate then stay private
+// to that library, instead of the linker keeping one copy, possibly compiled for a
+// higher level, for every user. The only symbol a level exports is its kernel table,
+// which is constant data; the registry loads a level's library only if the host supports
+// the level.
+
+#include <cstdint>
+
+#include "ngraph/runtime/cpu/cpu_isa.hpp"
+#include "ngraph/runtime/cpu/cpu_kernel_registry.hpp"
+#include "ngraph/runtime/cpu/kernel/abs.hpp"
+#include "ngraph/runtime/cpu/kernel/add.hpp"
+#include "ngraph/runtime/cpu/kernel/ceil.hpp"
+#include "ngraph/runtime/cpu/kernel/multiply.hpp"
+#include "ngraph/runtime/cpu/kernel/relu.hpp"
+
+#define UNARY(K) &K, nullptr
+#define BINARY(K) nullptr, &K
+
+#define KERNEL_ALL_TYPES(NAME, KIND, K)                                                            \
+    {NAME, KernelElementType::boolean, KIND(K<char>)},                                             \
+        {NAME, KernelElementType::f32, KIND(K<float>)},                                            \
+        {NAME, KernelElementType::f64, KIND(K<double>)},                                           \
+        {NAME, KernelElementType::i8, KIND(K<int8_t>)},                                            \
+        {NAME, KernelElementType::i16, KIND(K<int16_t>)},                                          \
+        {NAME, KernelElementType::i32, KIND(K<int32_t>)},                                          \
+        {NAME, KernelElementType::i64, KIND(K<int64_t>)},                                          \
+        {NAME, KernelElementType::u8, KIND(K<uint8_t>)},                                           \
+        {NAME, KernelElementType::u16, KIND(K<uint16_t>)},                                         \
+        {NAME, KernelElementType::u32, KIND(K<uint32_t>)},                                         \
+        {NAME, KernelElementType::u64, KIND(K<uint64_t>)},
+
+using namespace ngraph::runtime::cpu;
+
+// Each KERNEL_ALL_TYPES adds the entries for every element type, ending in a comma
+// clang-format off
+static const KernelTableEntry s_entries[] = {
+    KERNEL_ALL_TYPES("add", BINARY, kernel::NGRAPH_CPU_ISA_NAMESPACE::add)
+    KERNEL_ALL_TYPES("multiply", BINARY, kernel::NGRAPH_CPU_ISA_NAMESPACE::multiply)
+    KERNEL_ALL_TYPES("abs", UNARY, kernel::NGRAPH_CPU_ISA_NAMESPACE::abs)
+    KERNEL_ALL_TYPES("ceil", UNARY, kernel::NGRAPH_CPU_ISA_NAMESPACE::ceil)
+    KERNEL_ALL_TYPES("relu", UNARY, kernel::NGRAPH_CPU_ISA_NAMESPACE::relu)
+};
+// clang-format on
+
+#ifdef NGRAPH_CPU_ISA_VARIANT_LIBRARY
+NGRAPH_CPU_KERNEL_TABLE_API const KernelTable ngraph_cpu_kernel_table = {
+#else
+const KernelTable kernel::generic_kernel_table = {
+#endif
+    ISA::NGRAPH_CPU_ISA_NAMESPACE, s_entries, sizeof(s_entries) / sizeof(s_entries[0])};
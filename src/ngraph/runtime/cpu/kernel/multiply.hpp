@@ -19,6 +19,7 @@
 #define EIGEN_USE_THREADS
 #include <unsupported/Eigen/CXX11/Tensor>
 
+#include "ngraph/runtime/cpu/cpu_isa.hpp"
 #include "ngraph/runtime/cpu/kernel/eigen_thread_pool.hpp"
 
 namespace ngraph
@@ -29,21 +30,24 @@ namespace ngraph
         {
             namespace kernel
             {
-                template <typename ElementType>
-                void multiply(void* input0, void* input1, void* output, size_t count)
+                inline namespace NGRAPH_CPU_ISA_NAMESPACE
                 {
-                    Eigen::array<Eigen::Index, 1> out_dims, in_dims;
+                    template <typename ElementType>
+                    void multiply(void* input0, void* input1, void* output, size_t count)
+                    {
+                        Eigen::array<Eigen::Index, 1> out_dims, in_dims;
 
-                    out_dims[0] = in_dims[0] = count;
+                        out_dims[0] = in_dims[0] = count;
 
-                    Eigen::TensorMap<Eigen::Tensor<ElementType, 1, Eigen::RowMajor>> out(
-                        static_cast<ElementType*>(output), out_dims);
-                    Eigen::TensorMap<Eigen::Tensor<ElementType, 1, Eigen::RowMajor>> in0(
-                        static_cast<ElementType*>(input0), in_dims);
-                    Eigen::TensorMap<Eigen::Tensor<ElementType, 1, Eigen::RowMajor>> in1(
-                        static_cast<ElementType*>(input1), in_dims);
+                        Eigen::TensorMap<Eigen::Tensor<ElementType, 1, Eigen::RowMajor>> out(
+                            static_cast<ElementType*>(output), out_dims);
+                        Eigen::TensorMap<Eigen::Tensor<ElementType, 1, Eigen::RowMajor>> in0(
+                            static_cast<ElementType*>(input0), in_dims);
+                        Eigen::TensorMap<Eigen::Tensor<ElementType, 1, Eigen::RowMajor>> in1(
+                            static_cast<ElementType*>(input1), in_dims);
 
-                    out.device(eigen::global_thread_pool_device) = in0 * in1;
+                        out.device(eigen::get_thread_pool_device()) = in0 * in1;
+                    }
                 }
             }
         }
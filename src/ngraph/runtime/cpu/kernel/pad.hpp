@@ -53,7 +53,7 @@ namespace ngraph
                     Eigen::TensorMap<Eigen::Tensor<ElementType, Rank, Eigen::RowMajor>> in(input,
                                                                                            in_dims);
 
-                    out.device(eigen::global_thread_pool_device) = in.pad(padding, pad_value);
+                    out.device(eigen::get_thread_pool_device()) = in.pad(padding, pad_value);
                 }
             }
         }
@@ -48,7 +48,7 @@ namespace ngraph
                                                                                          out_dims);
                     Eigen::TensorMap<Eigen::Tensor<ElementType, Rank, Eigen::RowMajor>> in(input,
                                                                                            in_dims);
-                    out.device(eigen::global_thread_pool_device) = in.sum();
+                    out.device(eigen::get_thread_pool_device()) = in.sum();
                 }
 
                 template <typename ElementType, unsigned int Rank, unsigned int ReductionDims>
@@ -83,7 +83,7 @@ namespace ngraph
                         out(output, out_dims);
                     Eigen::TensorMap<Eigen::Tensor<ElementType, Rank, Eigen::RowMajor>> in(input,
                                                                                            in_dims);
-                    out.device(eigen::global_thread_pool_device) = in.sum(reduction_dims);
+                    out.device(eigen::get_thread_pool_device()) = in.sum(reduction_dims);
                 }
             }
         }
@@ -59,7 +59,7 @@ namespace ngraph
                     Eigen::TensorMap<Eigen::Tensor<ElementType, InRank, Eigen::RowMajor>> in(
                         input, in_dims);
 
-                    out.device(eigen::global_thread_pool_device) =
+                    out.device(eigen::get_thread_pool_device()) =
                         in.shuffle(axis_order).reshape(out_dims);
                 }
 
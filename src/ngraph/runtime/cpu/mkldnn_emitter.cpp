@@ -43,6 +43,16 @@ const std::vector<char*>& MKLDNNEmitter::get_mkldnn_workspaces()
     return m_workspace_bufs;
 }
 
+size_t MKLDNNEmitter::get_mkldnn_workspace_size() const
+{
+    size_t size = 0;
+    for (const auto& workspace : m_workspaces)
+    {
+        size += workspace->size;
+    }
+    return size;
+}
+
 size_t MKLDNNEmitter::insert_primitive(mkldnn::primitive* primitive)
 {
     m_mkldnn_primitives.emplace_back(primitive);
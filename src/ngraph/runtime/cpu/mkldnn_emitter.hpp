@@ -45,9 +45,14 @@ namespace ngraph
             class MKLDNNWorkspace
             {
             public:
-                MKLDNNWorkspace(size_t size) { buf = reinterpret_cast<char*>(malloc(size)); }
+                MKLDNNWorkspace(size_t size)
+                    : size(size)
+                {
+                    buf = reinterpret_cast<char*>(malloc(size));
+                }
                 ~MKLDNNWorkspace() { free(buf); }
                 char* buf;
+                size_t size;
             };
 
             class MKLDNNEmitter
@@ -58,6 +63,8 @@ namespace ngraph
 
                 const std::vector<mkldnn::primitive*>& get_mkldnn_primitives() const;
                 const std::vector<char*>& get_mkldnn_workspaces();
+                /// \brief Bytes of all workspaces
+                size_t get_mkldnn_workspace_size() const;
 
                 size_t insert_primitive(mkldnn::primitive* primitive);
                 size_t insert_workspace(std::unique_ptr<MKLDNNWorkspace>& workspace);
@@ -0,0 +1,128 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "ngraph/log.hpp"
+#include "ngraph/runtime/hardware_counters.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+constexpr uint64_t runtime::HardwareCounters::cache_line_size;
+constexpr int runtime::HardwareCounters::s_event_count;
+
+#ifdef __linux__
+static int open_event(uint64_t config, int group_fd)
+{
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = (group_fd == -1 ? 1 : 0);
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+#endif
+
+runtime::HardwareCounters::HardwareCounters()
+    : m_opened(false)
+{
+    for (int i = 0; i < s_event_count; i++)
+    {
+        m_fds[i] = -1;
+    }
+}
+
+runtime::HardwareCounters::~HardwareCounters()
+{
+#ifdef __linux__
+    for (int i = 0; i < s_event_count; i++)
+    {
+        if (m_fds[i] != -1)
+        {
+            close(m_fds[i]);
+        }
+    }
+#endif
+}
+
+void runtime::HardwareCounters::open()
+{
+    m_opened = true;
+#ifdef __linux__
+    // The order matches the fields of HardwareCounts. Cycles lead the group, the other
+    // events are optional.
+    const uint64_t events[s_event_count] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES};
+    m_fds[0] = open_event(events[0], -1);
+    if (m_fds[0] == -1)
+    {
+        NGRAPH_DEBUG << "Hardware counters not available: " << strerror(errno);
+        return;
+    }
+    for (int i = 1; i < s_event_count; i++)
+    {
+        m_fds[i] = open_event(events[i], m_fds[0]);
+    }
+    ioctl(m_fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(m_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+bool runtime::HardwareCounters::is_available()
+{
+    if (!m_opened)
+    {
+        open();
+    }
+    return m_fds[0] != -1;
+}
+
+runtime::HardwareCounts runtime::HardwareCounters::read()
+{
+    HardwareCounts rc;
+#ifdef __linux__
+    if (is_available())
+    {
+        // Group format: the number of events, then their values in the order they joined
+        uint64_t values[1 + s_event_count];
+        if (::read(m_fds[0], values, sizeof(values)) > 0)
+        {
+            uint64_t* fields[s_event_count] = {&rc.cycles, &rc.instructions, &rc.llc_misses};
+            size_t value_index = 1;
+            for (int i = 0; i < s_event_count && value_index <= values[0]; i++)
+            {
+                if (m_fds[i] != -1)
+                {
+                    *fields[i] = values[value_index++];
+                }
+            }
+        }
+    }
+#endif
+    return rc;
+}
@@ -0,0 +1,84 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        struct HardwareCounts;
+        class HardwareCounters;
+    }
+}
+
+/// \brief Hardware event counts, as sampled by HardwareCounters
+struct ngraph::runtime::HardwareCounts
+{
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    /// \brief Last level cache misses; each one is a cache line read from memory
+    uint64_t llc_misses = 0;
+
+    HardwareCounts& operator+=(const HardwareCounts& other)
+    {
+        cycles += other.cycles;
+        instructions += other.instructions;
+        llc_misses += other.llc_misses;
+        return *this;
+    }
+    HardwareCounts operator-(const HardwareCounts& other) const
+    {
+        HardwareCounts rc;
+        rc.cycles = cycles - other.cycles;
+        rc.instructions = instructions - other.instructions;
+        rc.llc_misses = llc_misses - other.llc_misses;
+        return rc;
+    }
+};
+
+/// \brief A group of Linux perf_event counters for the cycles, instructions and last level
+///        cache misses of one thread, in user space.
+///
+/// The counters are opened by the first call to read() and count the thread that made it,
+/// so work an op hands to other threads is not included. Reading the group costs a system
+/// call, which is significant for very small ops. When perf_event_open is not available,
+/// e.g. on other operating systems or when kernel.perf_event_paranoid forbids it,
+/// is_available() is false and read() returns zeros.
+class ngraph::runtime::HardwareCounters
+{
+public:
+    HardwareCounters();
+    ~HardwareCounters();
+    HardwareCounters(const HardwareCounters&) = delete;
+    HardwareCounters& operator=(const HardwareCounters&) = delete;
+
+    bool is_available();
+    /// \brief Counts since the counters were opened
+    HardwareCounts read();
+
+    /// \brief Bytes moved from memory per last level cache miss
+    static constexpr uint64_t cache_line_size = 64;
+
+private:
+    void open();
+
+    static constexpr int s_event_count = 3;
+    bool m_opened;
+    int m_fds[s_event_count];
+};
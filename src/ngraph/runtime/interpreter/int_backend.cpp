@@ -66,6 +66,7 @@ bool runtime::interpreter::INTBackend::compile(shared_ptr<Function> function)
         pass_manager.register_pass<pass::AssignLayout<DenseTensorViewLayout>>();
         pass_manager.register_pass<pass::Liveness>();
         pass_manager.run_passes(function);
+        add_pass_phases(instance.m_compile_profile, pass_manager);
     }
 
     return true;
@@ -91,6 +92,23 @@ bool runtime::interpreter::INTBackend::call(shared_ptr<Function> function,
         perform_nan_check(func_inputs);
     }
 
+    // The counters only count the thread that opened them, calls from other threads are
+    // not counted
+    HardwareCounters* hardware_counters = nullptr;
+    if (instance.m_performance_counters_enabled && instance.m_hardware_counters_enabled)
+    {
+        if (!instance.m_hardware_counters)
+        {
+            instance.m_hardware_counters = make_shared<HardwareCounters>();
+            instance.m_hardware_counters_thread = this_thread::get_id();
+        }
+        if (instance.m_hardware_counters_thread == this_thread::get_id() &&
+            instance.m_hardware_counters->is_available())
+        {
+            hardware_counters = instance.m_hardware_counters.get();
+        }
+    }
+
     // convert outputs to HostTensorView
     vector<shared_ptr<runtime::HostTensorView>> func_outputs;
     for (auto tv : outputs)
@@ -123,6 +141,7 @@ bool runtime::interpreter::INTBackend::call(shared_ptr<Function> function,
     }
 
     // for each ordered op in the graph
+    size_t live_bytes = 0;
     for (shared_ptr<Node> op : function->get_ordered_ops())
     {
         if (op->description() == "Parameter")
@@ -152,6 +171,7 @@ bool runtime::interpreter::INTBackend::call(shared_ptr<Function> function,
                 string name = op->get_output_tensor(i).get_name();
                 htv = make_shared<runtime::HostTensorView>(type, shape, name);
                 tensor_map.insert({tv, htv});
+                live_bytes += htv->get_size() * type.size();
             }
             else
             {
@@ -159,6 +179,7 @@ bool runtime::interpreter::INTBackend::call(shared_ptr<Function> function,
             }
             op_outputs.push_back(htv);
         }
+        instance.m_peak_live_bytes = max(instance.m_peak_live_bytes, live_bytes);
 
         // get op type
         element::Type type;
@@ -179,14 +200,23 @@ bool runtime::interpreter::INTBackend::call(shared_ptr<Function> function,
             type = op->get_outputs().at(0).get_element_type();
         }
 
+        HardwareCounts start_counts;
         if (instance.m_performance_counters_enabled)
         {
+            if (hardware_counters)
+            {
+                start_counts = hardware_counters->read();
+            }
             instance.m_timer_map[op.get()].start();
         }
         generate_calls(type, *op, op_outputs, op_inputs);
         if (instance.m_performance_counters_enabled)
         {
             instance.m_timer_map[op.get()].stop();
+            if (hardware_counters)
+            {
+                instance.m_hardware_count_map[op.get()] += hardware_counters->read() - start_counts;
+            }
         }
         if (instance.m_nan_check_enabled)
         {
@@ -200,6 +230,7 @@ bool runtime::interpreter::INTBackend::call(shared_ptr<Function> function,
             {
                 if (it->second->get_tensor().get_name() == t->get_name())
                 {
+                    live_bytes -= it->second->get_size() * it->second->get_element_type().size();
                     tensor_map.erase(it);
                     break;
                 }
@@ -281,6 +312,13 @@ void runtime::interpreter::INTBackend::enable_performance_data(shared_ptr<Functi
     instance.m_performance_counters_enabled = enable;
 }
 
+void runtime::interpreter::INTBackend::enable_hardware_counters(shared_ptr<Function> func,
+                                                                bool enable)
+{
+    FunctionInstance& instance = m_function_map[func];
+    instance.m_hardware_counters_enabled = enable;
+}
+
 vector<runtime::PerformanceCounter>
     runtime::interpreter::INTBackend::get_performance_data(shared_ptr<Function> func) const
 {
@@ -291,10 +329,35 @@ vector<runtime::PerformanceCounter>
         rc.emplace_back(p.first->get_name().c_str(),
                         p.second.get_total_microseconds(),
                         p.second.get_call_count());
+        rc.back().set_work(*p.first);
+        auto it = instance.m_hardware_count_map.find(p.first);
+        if (it != instance.m_hardware_count_map.end())
+        {
+            rc.back().set_hardware_counts(it->second);
+        }
     }
     return rc;
 }
 
+runtime::MemoryStats
+    runtime::interpreter::INTBackend::get_memory_stats(shared_ptr<Function> func) const
+{
+    MemoryStats stats = MemoryStats::from_function(func);
+    auto it = m_function_map.find(func);
+    if (it != m_function_map.end() && it->second.m_peak_live_bytes > 0)
+    {
+        stats.peak_live_bytes = it->second.m_peak_live_bytes;
+    }
+    return stats;
+}
+
+vector<runtime::CompilePhase>
+    runtime::interpreter::INTBackend::get_compile_profile(shared_ptr<Function> func) const
+{
+    auto it = m_function_map.find(func);
+    return it == m_function_map.end() ? vector<CompilePhase>() : it->second.m_compile_profile;
+}
+
 void runtime::interpreter::INTBackend::perform_nan_check(
     const vector<shared_ptr<HostTensorView>>& tvs, const Node* op)
 {
@@ -19,9 +19,11 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "ngraph/runtime/backend.hpp"
+#include "ngraph/runtime/hardware_counters.hpp"
 #include "ngraph/runtime/host_tensor_view.hpp"
 #include "ngraph/runtime/tensor_view.hpp"
 
@@ -146,8 +148,14 @@ public:
     void set_nan_check(std::shared_ptr<Function> func, bool);
 
     void enable_performance_data(std::shared_ptr<Function> func, bool enable) override;
+    void enable_hardware_counters(std::shared_ptr<Function> func, bool enable) override;
     std::vector<PerformanceCounter>
         get_performance_data(std::shared_ptr<Function> func) const override;
+    /// \brief Also reports the most bytes of tensors that calls of the function held at
+    ///        once, apart from its inputs and outputs
+    MemoryStats get_memory_stats(std::shared_ptr<Function> func) const override;
+    std::vector<CompilePhase>
+        get_compile_profile(std::shared_ptr<Function> func) const override;
 
 private:
     class FunctionInstance
@@ -157,6 +165,12 @@ private:
         bool m_nan_check_enabled = false;
         bool m_performance_counters_enabled = false;
         std::unordered_map<const Node*, stopwatch> m_timer_map;
+        bool m_hardware_counters_enabled = false;
+        std::shared_ptr<HardwareCounters> m_hardware_counters;
+        std::thread::id m_hardware_counters_thread;
+        std::unordered_map<const Node*, HardwareCounts> m_hardware_count_map;
+        size_t m_peak_live_bytes = 0;
+        std::vector<CompilePhase> m_compile_profile;
     };
     std::map<std::shared_ptr<Function>, FunctionInstance> m_function_map;
 
@@ -0,0 +1,75 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+
+#include "ngraph/descriptor/tensor.hpp"
+#include "ngraph/function.hpp"
+#include "ngraph/node.hpp"
+#include "ngraph/op/constant.hpp"
+#include "ngraph/runtime/memory_stats.hpp"
+#include "nlohmann/json.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+runtime::MemoryStats runtime::MemoryStats::from_function(shared_ptr<Function> function)
+{
+    MemoryStats stats;
+    stats.temporary_pool_bytes = function->get_temporary_pool_size();
+    size_t live = 0;
+    for (shared_ptr<Node> node : function->get_ordered_ops())
+    {
+        if (dynamic_pointer_cast<op::Constant>(node))
+        {
+            for (size_t i = 0; i < node->get_output_size(); ++i)
+            {
+                stats.constant_bytes += node->get_output_tensor(i).size();
+            }
+        }
+
+        // Tensors in the new list are allocated before the op runs and the ones in the
+        // free list are released after it
+        for (const descriptor::Tensor* tensor : node->liveness_new_list)
+        {
+            live += tensor->size();
+        }
+        stats.live_bytes.push_back({node->get_name(), live});
+        stats.peak_live_bytes = max(stats.peak_live_bytes, live);
+        for (const descriptor::Tensor* tensor : node->liveness_free_list)
+        {
+            live -= tensor->size();
+        }
+    }
+    return stats;
+}
+
+void runtime::MemoryStats::write_json(ostream& out) const
+{
+    nlohmann::json timeline = nlohmann::json::array();
+    for (const pair<string, size_t>& p : live_bytes)
+    {
+        timeline.push_back({{"op", p.first}, {"live_bytes", p.second}});
+    }
+    nlohmann::json doc{{"temporary_pool_bytes", temporary_pool_bytes},
+                       {"constant_bytes", constant_bytes},
+                       {"workspace_bytes", workspace_bytes},
+                       {"code_bytes", code_bytes},
+                       {"call_frame_bytes", call_frame_bytes},
+                       {"peak_live_bytes", peak_live_bytes},
+                       {"live_bytes", timeline}};
+    out << doc.dump(4);
+}
@@ -0,0 +1,66 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ngraph
+{
+    class Function;
+
+    namespace runtime
+    {
+        struct MemoryStats;
+    }
+}
+
+/// \brief Memory taken by a compiled function, in bytes.
+///
+/// Backends fill in what applies to them and leave the rest 0.
+struct ngraph::runtime::MemoryStats
+{
+    /// \brief Statistics that follow from the compiled graph: the temporary pool, the
+    ///        constants and the live bytes of temporaries over the op schedule.
+    ///
+    /// The live bytes are derived from the lists pass::Liveness leaves on the ops, so they
+    /// are 0 when the function has not been through the pass.
+    static MemoryStats from_function(std::shared_ptr<Function> function);
+
+    /// \brief Writes the statistics as a JSON object
+    void write_json(std::ostream& out) const;
+
+    /// Temporaries as laid out by pass::MemoryLayout
+    size_t temporary_pool_bytes = 0;
+    /// Data of Constant ops
+    size_t constant_bytes = 0;
+    /// Scratch buffers of MKLDNN primitives
+    size_t workspace_bytes = 0;
+    /// Code and data sections emitted by the JIT
+    size_t code_bytes = 0;
+    /// Allocated with each call frame, including its temporary pools
+    size_t call_frame_bytes = 0;
+    /// Most bytes of temporaries live at once. Backends that allocate tensors as they run
+    /// report the most they measured, which also counts constants.
+    size_t peak_live_bytes = 0;
+    /// Bytes of temporaries live while each op runs, in execution order
+    std::vector<std::pair<std::string, size_t>> live_bytes;
+};
@@ -0,0 +1,104 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "ngraph/runtime/performance_counter.hpp"
+#include "ngraph/cost_model.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+void runtime::PerformanceCounter::set_work(const Node& node)
+{
+    Cost cost = estimate_cost(node);
+    set_work(cost.flops, cost.bytes_read, cost.bytes_written);
+}
+
+void runtime::PerformanceCounter::set_work(size_t flops, size_t bytes_read, size_t bytes_written)
+{
+    m_flops = flops;
+    m_bytes_read = bytes_read;
+    m_bytes_written = bytes_written;
+}
+
+void runtime::PerformanceCounter::set_hardware_counts(const HardwareCounts& counts)
+{
+    m_has_hardware_counts = true;
+    m_hardware_counts = counts;
+}
+
+// Per call amounts are in units, rates in billions of units per second
+static double giga_per_second(double per_call, size_t calls, size_t total_microseconds)
+{
+    return total_microseconds > 0 ? per_call * calls / (total_microseconds * 1e3) : 0;
+}
+
+double runtime::PerformanceCounter::gflops_per_second() const
+{
+    return giga_per_second(m_flops, m_call_count, m_total_microseconds);
+}
+
+double runtime::PerformanceCounter::gbytes_per_second() const
+{
+    return giga_per_second(m_bytes_read + m_bytes_written, m_call_count, m_total_microseconds);
+}
+
+double runtime::PerformanceCounter::memory_gbytes_per_second() const
+{
+    return giga_per_second(
+        static_cast<double>(m_hardware_counts.llc_misses) * HardwareCounters::cache_line_size,
+        1,
+        m_total_microseconds);
+}
+
+double runtime::PerformanceCounter::instructions_per_cycle() const
+{
+    return m_hardware_counts.cycles > 0
+               ? static_cast<double>(m_hardware_counts.instructions) / m_hardware_counts.cycles
+               : 0;
+}
+
+vector<runtime::PerformanceCounter>
+    runtime::attribute_to_replaced_nodes(const vector<PerformanceCounter>& counters)
+{
+    vector<PerformanceCounter> rc;
+    for (const PerformanceCounter& counter : counters)
+    {
+        const map<string, Cost>& replaced = counter.replaced_nodes();
+        if (replaced.empty())
+        {
+            rc.push_back(counter);
+            continue;
+        }
+        size_t total_weight = 0;
+        for (const auto& node : replaced)
+        {
+            const Cost& cost = node.second;
+            total_weight += cost.flops + cost.bytes_read + cost.bytes_written;
+        }
+        for (const auto& node : replaced)
+        {
+            const Cost& cost = node.second;
+            size_t weight = cost.flops + cost.bytes_read + cost.bytes_written;
+            double share = total_weight > 0 ? static_cast<double>(weight) / total_weight
+                                            : 1.0 / replaced.size();
+            rc.emplace_back(node.first.c_str(),
+                            static_cast<size_t>(counter.total_microseconds() * share + 0.5),
+                            counter.call_count());
+            rc.back().set_work(cost.flops, cost.bytes_read, cost.bytes_written);
+        }
+    }
+    return rc;
+}
@@ -17,9 +17,17 @@
 #pragma once
 
 #include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "ngraph/cost_model.hpp"
+#include "ngraph/runtime/hardware_counters.hpp"
 
 namespace ngraph
 {
+    class Node;
+
     namespace runtime
     {
         class PerformanceCounter
@@ -35,10 +43,56 @@ namespace ngraph
             size_t total_microseconds() const { return m_total_microseconds; }
             size_t microseconds() const { return m_total_microseconds / m_call_count; }
             size_t call_count() const { return m_call_count; }
+            /// \brief Takes the work of one call from estimate_cost(node)
+            void set_work(const Node& node);
+            void set_work(size_t flops, size_t bytes_read, size_t bytes_written);
+            /// \brief Estimated floating point operations per call, 0 for data movement
+            size_t flops() const { return m_flops; }
+            /// \brief Size of the input tensors
+            size_t bytes_read() const { return m_bytes_read; }
+            /// \brief Size of the output tensors
+            size_t bytes_written() const { return m_bytes_written; }
+            /// \brief Counts over all calls, if the backend collected hardware counters
+            void set_hardware_counts(const HardwareCounts& counts);
+            bool has_hardware_counts() const { return m_has_hardware_counts; }
+            const HardwareCounts& hardware_counts() const { return m_hardware_counts; }
+            double gflops_per_second() const;
+            /// \brief Bandwidth needed for the tensors read and written, as if they were
+            ///        all in memory
+            double gbytes_per_second() const;
+            /// \brief Bandwidth of the cache lines read from memory after a last level
+            ///        cache miss, 0 without hardware counts
+            double memory_gbytes_per_second() const;
+            double instructions_per_cycle() const;
+            /// \brief Ops of the original graph the counted op replaced, as given by
+            ///         Node::get_replaced_nodes
+            void set_replaced_nodes(const std::map<std::string, Cost>& nodes)
+            {
+                m_replaced_nodes = nodes;
+            }
+            const std::map<std::string, Cost>& replaced_nodes() const
+            {
+                return m_replaced_nodes;
+            }
+
         private:
             std::string m_name;
             size_t m_total_microseconds;
             size_t m_call_count;
+            size_t m_flops = 0;
+            size_t m_bytes_read = 0;
+            size_t m_bytes_written = 0;
+            bool m_has_hardware_counts = false;
+            HardwareCounts m_hardware_counts;
+            std::map<std::string, Cost> m_replaced_nodes;
         };
+
+        /// \brief Splits the time of every counter that replaced ops of the original graph
+        ///        among those ops, in proportion to their estimated FLOPs plus bytes moved,
+        ///        so that differently optimized versions of a function can be compared op by
+        ///        op. The new counters have the work of the op they stand for; counters that
+        ///        replaced nothing are kept.
+        std::vector<PerformanceCounter>
+            attribute_to_replaced_nodes(const std::vector<PerformanceCounter>& counters);
     }
 }
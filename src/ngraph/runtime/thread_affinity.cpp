@@ -0,0 +1,90 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "ngraph/runtime/thread_affinity.hpp"
+#include "ngraph/except.hpp"
+#include "ngraph/util.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+vector<int> runtime::parse_cpu_list(const string& list)
+{
+    vector<int> cores;
+    for (const string& range : split(list, ',', true))
+    {
+        if (range.empty())
+        {
+            continue;
+        }
+        auto dash = range.find('-');
+        try
+        {
+            if (dash == string::npos)
+            {
+                cores.push_back(stoi(range));
+            }
+            else
+            {
+                int first = stoi(range.substr(0, dash));
+                int last = stoi(range.substr(dash + 1));
+                for (int core = first; core <= last; core++)
+                {
+                    cores.push_back(core);
+                }
+            }
+        }
+        catch (const logic_error&)
+        {
+            throw ngraph_error("Invalid cpu list '" + list + "'");
+        }
+    }
+    return cores;
+}
+
+bool runtime::set_thread_affinity(const vector<int>& cores)
+{
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for (int core : cores)
+    {
+        if (core < 0 || core >= CPU_SETSIZE)
+        {
+            return false;
+        }
+        CPU_SET(core, &mask);
+    }
+    return sched_setaffinity(0, sizeof(mask), &mask) == 0;
+}
+
+runtime::ScopedAffinity::ScopedAffinity(const vector<int>& cores)
+    : m_applied(cores.empty())
+    , m_restricted(false)
+{
+    if (!cores.empty() && sched_getaffinity(0, sizeof(m_saved_mask), &m_saved_mask) == 0)
+    {
+        m_restricted = set_thread_affinity(cores);
+        m_applied = m_restricted;
+    }
+}
+
+runtime::ScopedAffinity::~ScopedAffinity()
+{
+    if (m_restricted)
+    {
+        sched_setaffinity(0, sizeof(m_saved_mask), &m_saved_mask);
+    }
+}
@@ -0,0 +1,55 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#pragma once
+
+#include <sched.h>
+#include <string>
+#include <vector>
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        /// \brief Parses a Linux cpu list such as "0-3,8,10-11".
+        /// \throws ngraph_error if the list is malformed
+        std::vector<int> parse_cpu_list(const std::string& list);
+
+        /// \brief Restricts the calling thread to a set of cores.
+        /// \returns false if the system rejected the set
+        bool set_thread_affinity(const std::vector<int>& cores);
+
+        /// \brief Restricts the calling thread to a set of cores for the lifetime of the
+        ///        object. Threads created meanwhile, such as thread pools, inherit the
+        ///        restriction. An empty set leaves the affinity alone.
+        class ScopedAffinity
+        {
+        public:
+            ScopedAffinity(const std::vector<int>& cores);
+            ~ScopedAffinity();
+            ScopedAffinity(const ScopedAffinity&) = delete;
+            ScopedAffinity& operator=(const ScopedAffinity&) = delete;
+
+            /// \brief False if cores were requested but the thread could not be restricted
+            bool is_applied() const { return m_applied; }
+
+        private:
+            bool m_applied;
+            bool m_restricted;
+            cpu_set_t m_saved_mask;
+        };
+    }
+}
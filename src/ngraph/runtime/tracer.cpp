@@ -0,0 +1,305 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+
+#include "ngraph/except.hpp"
+#include "ngraph/log.hpp"
+#include "ngraph/runtime/tracer.hpp"
+#include "nlohmann/json.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+namespace
+{
+    // Slots are written by the ring's thread while another thread may read them, so every
+    // field is atomic. As in a sequence lock, the sequence is odd while the slot is being
+    // written and otherwise tells which record the slot holds.
+    struct TraceSlot
+    {
+        atomic<uint64_t> sequence{0};
+        atomic<uint64_t> call_id{0};
+        atomic<int64_t> start{0};
+        atomic<int64_t> end{0};
+        atomic<uint32_t> function_id{0};
+        atomic<uint32_t> op_index{0};
+    };
+}
+
+/// \brief Ring buffer written by one thread and drained by any
+class ngraph::runtime::TraceRing
+{
+public:
+    TraceRing(size_t capacity, size_t thread_number)
+        : m_slots(new TraceSlot[capacity])
+        , m_capacity(capacity)
+        , m_mask(capacity - 1)
+        , m_head(0)
+        , m_tail(0)
+        , m_thread_number(thread_number)
+    {
+    }
+
+    void push(const TraceRecord& record)
+    {
+        uint64_t head = m_head.load(memory_order_relaxed);
+        TraceSlot& slot = m_slots[head & m_mask];
+        slot.sequence.store(2 * head + 1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+        slot.call_id.store(record.call_id, memory_order_relaxed);
+        slot.start.store(record.start, memory_order_relaxed);
+        slot.end.store(record.end, memory_order_relaxed);
+        slot.function_id.store(record.function_id, memory_order_relaxed);
+        slot.op_index.store(record.op_index, memory_order_relaxed);
+        slot.sequence.store(2 * head + 2, memory_order_release);
+        m_head.store(head + 1, memory_order_release);
+    }
+
+    // Appends the records pushed since the last drain that have not been overwritten
+    void drain(vector<TraceRecord>& records)
+    {
+        uint64_t head = m_head.load(memory_order_acquire);
+        uint64_t first = max(m_tail, head > m_capacity ? head - m_capacity : 0);
+        for (uint64_t i = first; i < head; i++)
+        {
+            const TraceSlot& slot = m_slots[i & m_mask];
+            uint64_t sequence = slot.sequence.load(memory_order_acquire);
+            if (sequence != 2 * i + 2)
+            {
+                // Reused by a later record
+                continue;
+            }
+            TraceRecord record{slot.call_id.load(memory_order_relaxed),
+                               slot.start.load(memory_order_relaxed),
+                               slot.end.load(memory_order_relaxed),
+                               slot.function_id.load(memory_order_relaxed),
+                               slot.op_index.load(memory_order_relaxed)};
+            // The writer may have started reusing the slot while it was read
+            atomic_thread_fence(memory_order_acquire);
+            if (slot.sequence.load(memory_order_relaxed) == sequence)
+            {
+                records.push_back(record);
+            }
+        }
+        m_tail = head;
+    }
+
+    bool has_pending() const { return m_head.load(memory_order_acquire) > m_tail; }
+    size_t get_thread_number() const { return m_thread_number; }
+private:
+    unique_ptr<TraceSlot[]> m_slots;
+    uint64_t m_capacity;
+    uint64_t m_mask;
+    atomic<uint64_t> m_head;
+    // Only accessed by drain, under the tracer's mutex
+    uint64_t m_tail;
+    size_t m_thread_number;
+};
+
+// Gives the ring of a thread back to the tracer when the thread exits
+class runtime::Tracer::ThreadRing
+{
+public:
+    ~ThreadRing()
+    {
+        if (m_ring != nullptr)
+        {
+            Tracer::get().release_ring(m_ring);
+        }
+    }
+
+    TraceRing* m_ring = nullptr;
+};
+
+thread_local runtime::Tracer::ThreadRing runtime::Tracer::s_thread_ring;
+
+static size_t round_up_to_power_of_two(size_t n)
+{
+    size_t rc = 1;
+    while (rc < n)
+    {
+        rc <<= 1;
+    }
+    return rc;
+}
+
+runtime::Tracer& runtime::Tracer::get()
+{
+    static Tracer s_tracer;
+    return s_tracer;
+}
+
+runtime::Tracer::Tracer()
+    : m_thread_count(0)
+    , m_last_call_id(0)
+    , m_buffer_size(65536)
+{
+    if (const char* size = getenv("NGRAPH_TRACE_BUFFER_SIZE"))
+    {
+        set_buffer_size(strtoul(size, nullptr, 10));
+    }
+}
+
+runtime::Tracer::~Tracer()
+{
+    const char* file_name = getenv("NGRAPH_TRACE_FILE");
+    if (file_name == nullptr)
+    {
+        return;
+    }
+    try
+    {
+        // Nothing is written if nothing was traced since the last write
+        bool pending;
+        {
+            lock_guard<mutex> lock(m_mutex);
+            pending = !m_released.empty();
+            for (const unique_ptr<TraceRing>& ring : m_rings)
+            {
+                pending = pending || ring->has_pending();
+            }
+        }
+        if (pending)
+        {
+            write(file_name);
+        }
+    }
+    catch (const exception& e)
+    {
+        NGRAPH_WARN << "Trace not written: " << e.what();
+    }
+}
+
+uint32_t runtime::Tracer::add_function(const string& name, vector<TraceOp> ops)
+{
+    lock_guard<mutex> lock(m_mutex);
+    m_functions.emplace_back(name, move(ops));
+    return static_cast<uint32_t>(m_functions.size() - 1);
+}
+
+int64_t runtime::Tracer::now()
+{
+    return chrono::duration_cast<chrono::nanoseconds>(
+               chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+void runtime::Tracer::record(uint32_t function_id,
+                             uint32_t op_index,
+                             uint64_t call_id,
+                             int64_t start)
+{
+    int64_t end = now();
+    TraceRing*& ring = s_thread_ring.m_ring;
+    if (ring == nullptr)
+    {
+        ring = create_ring();
+    }
+    ring->push({call_id, start, end, function_id, op_index});
+}
+
+runtime::TraceRing* runtime::Tracer::create_ring()
+{
+    lock_guard<mutex> lock(m_mutex);
+    m_rings.emplace_back(new TraceRing(m_buffer_size, m_thread_count++));
+    return m_rings.back().get();
+}
+
+void runtime::Tracer::release_ring(TraceRing* ring)
+{
+    lock_guard<mutex> lock(m_mutex);
+    vector<TraceRecord> records;
+    ring->drain(records);
+    for (const TraceRecord& record : records)
+    {
+        m_released.emplace_back(ring->get_thread_number(), record);
+    }
+    while (m_released.size() > m_buffer_size)
+    {
+        m_released.pop_front();
+    }
+    m_rings.erase(find_if(m_rings.begin(),
+                          m_rings.end(),
+                          [ring](const unique_ptr<TraceRing>& r) { return r.get() == ring; }));
+}
+
+void runtime::Tracer::set_buffer_size(size_t events)
+{
+    lock_guard<mutex> lock(m_mutex);
+    m_buffer_size = round_up_to_power_of_two(max<size_t>(events, 1));
+}
+
+void runtime::Tracer::write(ostream& out)
+{
+    lock_guard<mutex> lock(m_mutex);
+    // Functions are shown as processes and the recording threads as their threads
+    out << "{\"traceEvents\":[";
+    bool first = true;
+    for (size_t i = 0; i < m_functions.size(); i++)
+    {
+        nlohmann::json event{{"ph", "M"},
+                             {"name", "process_name"},
+                             {"pid", i},
+                             {"args", {{"name", m_functions[i].first}}}};
+        out << (first ? "\n" : ",\n") << event.dump();
+        first = false;
+    }
+    auto write_event = [&](size_t thread_number, const TraceRecord& record) {
+        const TraceOp& op = m_functions.at(record.function_id).second.at(record.op_index);
+        nlohmann::json args(op.args);
+        args["call"] = record.call_id;
+        nlohmann::json event{{"ph", "X"},
+                             {"cat", "Op"},
+                             {"name", op.name},
+                             {"pid", record.function_id},
+                             {"tid", thread_number},
+                             {"ts", record.start / 1000.0},
+                             {"dur", (record.end - record.start) / 1000.0},
+                             {"args", args}};
+        out << (first ? "\n" : ",\n") << event.dump();
+        first = false;
+    };
+    vector<TraceRecord> records;
+    for (const unique_ptr<TraceRing>& ring : m_rings)
+    {
+        records.clear();
+        ring->drain(records);
+        for (const TraceRecord& record : records)
+        {
+            write_event(ring->get_thread_number(), record);
+        }
+    }
+    for (const pair<size_t, TraceRecord>& released : m_released)
+    {
+        write_event(released.first, released.second);
+    }
+    m_released.clear();
+    out << "\n]}\n";
+}
+
+void runtime::Tracer::write(const string& file_name)
+{
+    ofstream out(file_name);
+    if (!out)
+    {
+        throw ngraph_error("Unable to write trace file " + file_name);
+    }
+    write(out);
+}
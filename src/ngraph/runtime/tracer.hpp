@@ -0,0 +1,113 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        class Tracer;
+        class TraceRing;
+
+        /// \brief An op as shown in a trace
+        struct TraceOp
+        {
+            std::string name;
+            std::map<std::string, std::string> args;
+        };
+
+        /// \brief An op run as recorded by a thread
+        struct TraceRecord
+        {
+            uint64_t call_id;
+            int64_t start;
+            int64_t end;
+            uint32_t function_id;
+            uint32_t op_index;
+        };
+    }
+}
+
+/// \brief Records op start and end times with little enough overhead to leave tracing on
+///        under load, and writes them as a Chrome trace on demand.
+///
+/// Every thread records into its own ring buffer without locking. When a buffer is full the
+/// oldest events are overwritten, so only the last get_buffer_size() events of each thread
+/// are kept. write() collects the events of all threads and removes them from the buffers.
+/// Backends usually trace only a sample of the calls.
+///
+/// The buffer of a thread is freed when the thread exits. Its events are kept for the next
+/// write(), up to get_buffer_size() events of exited threads in all.
+///
+/// When NGRAPH_TRACE_FILE is set, events still buffered when the process exits are written
+/// to that file.
+class ngraph::runtime::Tracer
+{
+public:
+    static Tracer& get();
+    ~Tracer();
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    /// \brief Registers the ops of a compiled function
+    /// \return The id to record the ops with; ops are identified by their index in ops
+    uint32_t add_function(const std::string& name, std::vector<TraceOp> ops);
+    /// \brief A new id for a traced call, never 0
+    uint64_t next_call_id() { return ++m_last_call_id; }
+    /// \brief Nanoseconds of a steady clock shared by all threads
+    static int64_t now();
+    /// \brief Records an op that ran on the calling thread
+    void record(uint32_t function_id, uint32_t op_index, uint64_t call_id, int64_t start);
+
+    /// \brief Writes the recorded events in Chrome trace format, which chrome://tracing
+    ///        and other trace viewers load, and removes them from the buffers
+    void write(std::ostream& out);
+    void write(const std::string& file_name);
+
+    /// \brief Events kept per thread, from NGRAPH_TRACE_BUFFER_SIZE or 65536. Applies to
+    ///        threads that have not recorded yet and is rounded up to a power of two.
+    void set_buffer_size(size_t events);
+    size_t get_buffer_size() const { return m_buffer_size; }
+
+private:
+    class ThreadRing;
+
+    Tracer();
+    TraceRing* create_ring();
+    void release_ring(TraceRing* ring);
+
+    static thread_local ThreadRing s_thread_ring;
+
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<TraceRing>> m_rings;
+    size_t m_thread_count;
+    /// Thread numbers and events of exited threads
+    std::deque<std::pair<size_t, TraceRecord>> m_released;
+    std::vector<std::pair<std::string, std::vector<TraceOp>>> m_functions;
+    std::atomic<uint64_t> m_last_call_id;
+    size_t m_buffer_size;
+};
@@ -14,12 +14,20 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <atomic>
+#include <cctype>
+#include <exception>
 #include <fstream>
 #include <functional>
+#include <mutex>
+#include <sstream>
+#include <streambuf>
+#include <thread>
 
 #include "ngraph/cpio.hpp"
 #include "ngraph/file_util.hpp"
 #include "ngraph/graph_util.hpp"
+#include "ngraph/model_container.hpp"
 #include "ngraph/op/abs.hpp"
 #include "ngraph/op/acos.hpp"
 #include "ngraph/op/add.hpp"
@@ -101,15 +109,339 @@ T get_or_default(nlohmann::json& j, const std::string& key, const T& default_val
     return j.count(key) != 0 ? j.at(key).get<T>() : default_value;
 }
 
-static std::shared_ptr<ngraph::Function>
-    read_function(const json&,
-                  std::unordered_map<std::string, std::shared_ptr<Function>>&,
-                  function<const_data_callback_t>);
+// Pull parser for the serialized graph. The function and op arrays are read incrementally
+// and only a single op is parsed into a json object at a time, so memory use does not grow
+// with the size of the graph beyond the nodes being built.
+class JsonReader
+{
+public:
+    JsonReader(streambuf* buffer)
+        : m_buffer(buffer)
+        , m_offset(0)
+    {
+    }
+
+    // Returns the next character after any whitespace without consuming it
+    int peek()
+    {
+        int ch = m_buffer->sgetc();
+        while (ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r')
+        {
+            ch = advance();
+        }
+        return ch;
+    }
+
+    void expect(char expected)
+    {
+        if (peek() != expected)
+        {
+            error(string("expected '") + expected + "'");
+        }
+        advance();
+    }
+
+    // Steps to the next element of an array or member of an object whose opening bracket
+    // was read. Returns false and consumes close at the end.
+    bool next(bool& first, char close)
+    {
+        if (peek() == close)
+        {
+            advance();
+            return false;
+        }
+        if (!first)
+        {
+            expect(',');
+        }
+        first = false;
+        return true;
+    }
+
+    string read_string()
+    {
+        if (peek() != '"')
+        {
+            error("expected a string");
+        }
+        string text;
+        copy_string(text);
+        return json::parse(text).get<string>();
+    }
+
+    // Returns the json text of the next value, to be parsed on its own
+    string read_value_text()
+    {
+        string text;
+        int ch = peek();
+        if (ch == '"')
+        {
+            copy_string(text);
+        }
+        else if (ch == '{' || ch == '[')
+        {
+            size_t depth = 0;
+            do
+            {
+                ch = m_buffer->sgetc();
+                if (ch == '"')
+                {
+                    copy_string(text);
+                    continue;
+                }
+                else if (ch == '{' || ch == '[')
+                {
+                    depth++;
+                }
+                else if (ch == '}' || ch == ']')
+                {
+                    depth--;
+                }
+                else if (ch == char_traits<char>::eof())
+                {
+                    error("unexpected end of input");
+                }
+                text.push_back(static_cast<char>(ch));
+                advance();
+            } while (depth > 0);
+        }
+        else
+        {
+            // number, true, false or null
+            while (isalnum(ch) || ch == '-' || ch == '+' || ch == '.')
+            {
+                text.push_back(static_cast<char>(ch));
+                ch = advance();
+            }
+            if (text.empty())
+            {
+                error("expected a value");
+            }
+        }
+        return text;
+    }
+
+    void error(const string& message)
+    {
+        throw ngraph_error("Error parsing json at offset " + to_string(m_offset) + ": " +
+                           message);
+    }
+
+private:
+    int advance()
+    {
+        m_buffer->sbumpc();
+        m_offset++;
+        return m_buffer->sgetc();
+    }
+
+    void copy_string(string& text)
+    {
+        text.push_back('"');
+        int ch = advance();
+        while (ch != '"')
+        {
+            if (ch == char_traits<char>::eof())
+            {
+                error("unexpected end of input");
+            }
+            text.push_back(static_cast<char>(ch));
+            if (ch == '\\')
+            {
+                ch = advance();
+                if (ch == char_traits<char>::eof())
+                {
+                    error("unexpected end of input");
+                }
+                text.push_back(static_cast<char>(ch));
+            }
+            ch = advance();
+        }
+        text.push_back('"');
+        advance();
+    }
+
+    streambuf* m_buffer;
+    size_t m_offset;
+};
+
+// Writes the function and op arrays incrementally, formatted the same way as json::dump
+class JsonWriter
+{
+public:
+    JsonWriter(ostream& out, size_t indent)
+        : m_out(out)
+        , m_indent(indent)
+    {
+    }
+
+    void begin(char open)
+    {
+        m_out << open;
+        m_first.push_back(true);
+    }
+
+    void end(char close)
+    {
+        bool empty = m_first.back();
+        m_first.pop_back();
+        if (!empty)
+        {
+            newline();
+        }
+        m_out << close;
+    }
+
+    // Starts the next element of the current array
+    void next()
+    {
+        if (!m_first.back())
+        {
+            m_out << ',';
+        }
+        m_first.back() = false;
+        newline();
+    }
+
+    // Starts the next member of the current object
+    void key(const string& name)
+    {
+        next();
+        m_out << json(name).dump() << (m_indent == 0 ? ":" : ": ");
+    }
+
+    void value(const json& j)
+    {
+        if (m_indent == 0)
+        {
+            m_out << j.dump();
+            return;
+        }
+        // Nested lines are indented relative to the current depth
+        string prefix(m_indent * m_first.size(), ' ');
+        for (char ch : j.dump(static_cast<int>(m_indent)))
+        {
+            m_out << ch;
+            if (ch == '\n')
+            {
+                m_out << prefix;
+            }
+        }
+    }
+
+private:
+    void newline()
+    {
+        if (m_indent != 0)
+        {
+            m_out << '\n' << string(m_indent * m_first.size(), ' ');
+        }
+    }
+
+    ostream& m_out;
+    size_t m_indent;
+    vector<bool> m_first;
+};
+
+// Read-only stream buffer over memory, such as a mapped file, that is not copied
+class MemoryBuffer : public streambuf
+{
+public:
+    MemoryBuffer(const char* data, size_t size)
+    {
+        char* p = const_cast<char*>(data);
+        setg(p, p, p + size);
+    }
+};
+
+static shared_ptr<ngraph::Function>
+    read_function(JsonReader& reader,
+                  unordered_map<string, shared_ptr<Function>>& function_map,
+                  function<const_data_callback_t> const_data_callback);
+static void decode_constants(shared_ptr<ngraph::Function> func);
+
+// Where the json puts the data of constants
+enum class ConstantData
+{
+    // Not in the json, but in separate blobs of a model container
+    external,
+    // "value", a list of literal strings
+    strings,
+    // "value_base64", the bytes of the constant in base64
+    base64
+};
+
+static void write(JsonWriter& writer, const ngraph::Function&, ConstantData constant_data);
+static json write(const ngraph::Node&, ConstantData constant_data);
+static bool write_attributes(const ngraph::Node&, json& node, ConstantData constant_data);
+static void write_functions(ostream& out,
+                            shared_ptr<ngraph::Function> func,
+                            size_t indent,
+                            ConstantData constant_data);
+
+static const char s_base64_chars[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static string base64_encode(const void* data, size_t size)
+{
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    string rc;
+    rc.reserve((size + 2) / 3 * 4);
+    for (size_t i = 0; i < size; i += 3)
+    {
+        uint32_t triple = static_cast<uint32_t>(p[i]) << 16;
+        if (i + 1 < size)
+        {
+            triple |= static_cast<uint32_t>(p[i + 1]) << 8;
+        }
+        if (i + 2 < size)
+        {
+            triple |= p[i + 2];
+        }
+        rc.push_back(s_base64_chars[(triple >> 18) & 0x3F]);
+        rc.push_back(s_base64_chars[(triple >> 12) & 0x3F]);
+        rc.push_back(i + 1 < size ? s_base64_chars[(triple >> 6) & 0x3F] : '=');
+        rc.push_back(i + 2 < size ? s_base64_chars[triple & 0x3F] : '=');
+    }
+    return rc;
+}
 
-static json write(const ngraph::Function&, bool binary_constant_data);
-static json write(const ngraph::Node&, bool binary_constant_data);
-static string
-    serialize(shared_ptr<ngraph::Function> func, size_t indent, bool binary_constant_data);
+static void base64_decode(const string& text, void* data, size_t size)
+{
+    static const vector<int8_t> values = [] {
+        vector<int8_t> table(256, -1);
+        for (int8_t i = 0; i < 64; i++)
+        {
+            table[static_cast<uint8_t>(s_base64_chars[i])] = i;
+        }
+        return table;
+    }();
+
+    if (text.size() != (size + 2) / 3 * 4)
+    {
+        throw ngraph_error("base64 data does not match the constant size");
+    }
+    uint8_t* p = static_cast<uint8_t*>(data);
+    size_t out = 0;
+    for (size_t i = 0; i < text.size(); i += 4)
+    {
+        uint32_t quad = 0;
+        for (size_t k = 0; k < 4; k++)
+        {
+            char ch = text[i + k];
+            int8_t value = ch == '=' ? 0 : values[static_cast<uint8_t>(ch)];
+            if (value < 0)
+            {
+                throw ngraph_error("invalid base64 character");
+            }
+            quad = (quad << 6) | static_cast<uint32_t>(value);
+        }
+        for (size_t k = 0; k < 3 && out < size; k++)
+        {
+            p[out++] = static_cast<uint8_t>(quad >> (16 - 8 * k));
+        }
+    }
+}
 
 static json write_element_type(const ngraph::element::Type& n)
 {
@@ -149,24 +481,32 @@ static element::Type read_element_type(const json& j)
     return element::Type(bitwidth, is_real, is_signed, c_type_string);
 }
 
-void ngraph::serialize(const string& path, shared_ptr<ngraph::Function> func, size_t indent)
+void ngraph::serialize(const string& path,
+                       shared_ptr<ngraph::Function> func,
+                       size_t indent,
+                       bool checksums)
 {
-    ofstream out(path);
-    serialize(out, func, indent);
+    ofstream out(path, ios_base::binary | ios_base::out);
+    serialize(out, func, indent, checksums);
 }
 
-void ngraph::serialize(ostream& out, shared_ptr<ngraph::Function> func, size_t indent)
+void ngraph::serialize(ostream& out,
+                       shared_ptr<ngraph::Function> func,
+                       size_t indent,
+                       bool checksums)
 {
-    string j = ::serialize(func, indent, true);
-    cpio::Writer writer(out);
-    writer.write(func->get_name(), j.c_str(), static_cast<uint32_t>(j.size()));
+    stringstream ss;
+    write_functions(ss, func, indent, ConstantData::external);
+    string j = ss.str();
+    model_container::Writer writer(out, checksums);
+    writer.write(func->get_name(), j.c_str(), j.size());
 
     traverse_functions(func, [&](shared_ptr<ngraph::Function> f) {
         traverse_nodes(const_cast<Function*>(f.get()), [&](shared_ptr<Node> node) {
             if (auto c = dynamic_pointer_cast<op::Constant>(node))
             {
-                uint32_t size = static_cast<uint32_t>(shape_size(c->get_output_shape(0)) *
-                                                      c->get_output_element_type(0).size());
+                uint64_t size = shape_size(c->get_output_shape(0)) *
+                                c->get_output_element_type(0).size();
                 writer.write(c->get_name(), c->get_data_ptr(), size);
             }
         });
@@ -175,125 +515,438 @@ void ngraph::serialize(ostream& out, shared_ptr<ngraph::Function> func, size_t i
     writer.close();
 }
 
-static string serialize(shared_ptr<ngraph::Function> func, size_t indent, bool binary_constant_data)
+static void write_functions(ostream& out,
+                            shared_ptr<ngraph::Function> func,
+                            size_t indent,
+                            ConstantData constant_data)
 {
-    json j;
-    vector<json> functions;
-    traverse_functions(func, [&](shared_ptr<ngraph::Function> f) {
-        functions.push_back(write(*f, binary_constant_data));
-    });
+    // Called functions are written before their callers
+    vector<shared_ptr<Function>> functions;
+    traverse_functions(func, [&](shared_ptr<ngraph::Function> f) { functions.push_back(f); });
+
+    JsonWriter writer(out, indent);
+    writer.begin('[');
     for (auto it = functions.rbegin(); it != functions.rend(); it++)
     {
-        j.push_back(*it);
+        writer.next();
+        write(writer, **it, constant_data);
     }
+    writer.end(']');
+}
 
-    string rc;
-    if (indent == 0)
+std::string ngraph::serialize(std::shared_ptr<ngraph::Function> func,
+                              size_t indent,
+                              bool base64_constants)
+{
+    stringstream ss;
+    write_functions(
+        ss, func, indent, base64_constants ? ConstantData::base64 : ConstantData::strings);
+    return ss.str();
+}
+
+static shared_ptr<ngraph::Function>
+    read_functions(streambuf* buffer,
+                   function<const_data_callback_t> const_data_callback,
+                   bool lazy_constants = false)
+{
+    shared_ptr<Function> rc;
+    JsonReader reader(buffer);
+    unordered_map<string, shared_ptr<Function>> function_map;
+    reader.expect('[');
+    bool first = true;
+    while (reader.next(first, ']'))
     {
-        rc = j.dump();
+        rc = read_function(reader, function_map, const_data_callback);
     }
-    else
+    if (rc && !lazy_constants)
     {
-        rc = j.dump(static_cast<int>(indent));
+        decode_constants(rc);
     }
     return rc;
 }
 
-std::string ngraph::serialize(std::shared_ptr<ngraph::Function> func, size_t indent)
+// Decodes the constants read from json text on all hardware threads
+static void decode_constants(shared_ptr<ngraph::Function> func)
 {
-    return ::serialize(func, indent, false);
+    vector<shared_ptr<op::Constant>> constants;
+    traverse_functions(func, [&](shared_ptr<ngraph::Function> f) {
+        for (shared_ptr<Node> node : f->get_ops())
+        {
+            auto c = dynamic_pointer_cast<op::Constant>(node);
+            if (c && !c->is_decoded())
+            {
+                constants.push_back(c);
+            }
+        }
+    });
+
+    size_t thread_count =
+        min<size_t>(max<size_t>(thread::hardware_concurrency(), 1), constants.size());
+    atomic<size_t> next(0);
+    exception_ptr error;
+    mutex error_mutex;
+    auto decode = [&]() {
+        for (size_t i = next++; i < constants.size(); i = next++)
+        {
+            try
+            {
+                constants[i]->decode();
+            }
+            catch (...)
+            {
+                lock_guard<mutex> lock(error_mutex);
+                if (!error)
+                {
+                    error = current_exception();
+                }
+            }
+        }
+    };
+    vector<thread> threads;
+    for (size_t i = 1; i < thread_count; i++)
+    {
+        threads.emplace_back(decode);
+    }
+    decode();
+    for (thread& t : threads)
+    {
+        t.join();
+    }
+    if (error)
+    {
+        rethrow_exception(error);
+    }
+}
+
+static shared_ptr<ngraph::Function>
+    read_functions(const string& jstr,
+                   function<const_data_callback_t> const_data_callback,
+                   bool lazy_constants = false)
+{
+    MemoryBuffer buffer(jstr.data(), jstr.size());
+    return read_functions(&buffer, const_data_callback, lazy_constants);
 }
 
-shared_ptr<ngraph::Function> ngraph::deserialize(istream& in)
+static void check_constant_size(const string& const_name,
+                                uint64_t size,
+                                const element::Type& et,
+                                const Shape& shape)
+{
+    if (size != shape_size(shape) * et.size())
+    {
+        throw ngraph_error("Size of constant '" + const_name + "' does not match its shape");
+    }
+}
+
+shared_ptr<ngraph::Function> ngraph::deserialize(istream& in, bool lazy_constants)
 {
     shared_ptr<Function> rc;
-    if (cpio::is_cpio(in))
+    if (model_container::is_model_container(in))
+    {
+        model_container::Reader reader(in);
+        const vector<model_container::BlobInfo>& blob_info = reader.get_blob_info();
+        if (blob_info.size() > 0)
+        {
+            // The first blob is the model
+            string jstr(blob_info[0].get_size(), 0);
+            reader.read(blob_info[0], &jstr[0]);
+            rc = read_functions(
+                jstr, [&](const string& const_name, const element::Type& et, const Shape& shape) {
+                    shared_ptr<Node> const_node;
+                    if (const model_container::BlobInfo* info = reader.find(const_name))
+                    {
+                        check_constant_size(const_name, info->get_size(), et, shape);
+                        // Read straight into the storage of the constant instead of copying
+                        shared_ptr<void> const_data(aligned_alloc(et.size(), info->get_size()),
+                                                    aligned_free);
+                        reader.read(*info, const_data.get());
+                        const_node =
+                            make_shared<op::Constant>(et, shape, const_data.get(), const_data);
+                    }
+                    return const_node;
+                });
+        }
+    }
+    else if (cpio::is_cpio(in))
     {
+        // Legacy format, limited to 4 GB per constant
         cpio::Reader reader(in);
-        vector<cpio::FileInfo> file_info = reader.get_file_info();
+        const vector<cpio::FileInfo>& file_info = reader.get_file_info();
         if (file_info.size() > 0)
         {
-            // The first file is the model
-            uint32_t size = static_cast<uint32_t>(file_info[0].get_size());
-            char* data = new char[size];
-            reader.read(file_info[0].get_name(), data, size);
-            string jstr(data, size);
-            delete[] data;
-            json js = json::parse(jstr);
-            unordered_map<string, shared_ptr<Function>> function_map;
-            for (json func : js)
+            unordered_map<string, const cpio::FileInfo*> constant_info;
+            for (size_t i = 1; i < file_info.size(); i++)
             {
-                shared_ptr<Function> f = read_function(
-                    func,
-                    function_map,
-                    [&](const string& const_name, const element::Type& et, const Shape& shape) {
-                        shared_ptr<Node> const_node;
-                        for (const cpio::FileInfo& info : file_info)
-                        {
-                            if (info.get_name() == const_name)
-                            {
-                                void* const_data = malloc(info.get_size());
-                                reader.read(const_name, const_data, info.get_size());
-                                const_node = make_shared<op::Constant>(et, shape, const_data);
-                                free(const_data);
-                                break;
-                            }
-                        }
-                        return const_node;
-                    });
-                rc = f;
+                constant_info.insert({file_info[i].get_name(), &file_info[i]});
             }
+
+            // The first file is the model
+            string jstr(file_info[0].get_size(), 0);
+            reader.read(file_info[0], &jstr[0]);
+            rc = read_functions(
+                jstr, [&](const string& const_name, const element::Type& et, const Shape& shape) {
+                    shared_ptr<Node> const_node;
+                    auto it = constant_info.find(const_name);
+                    if (it != constant_info.end())
+                    {
+                        const cpio::FileInfo& info = *it->second;
+                        check_constant_size(const_name, info.get_size(), et, shape);
+                        shared_ptr<void> const_data(aligned_alloc(et.size(), info.get_size()),
+                                                    aligned_free);
+                        reader.read(info, const_data.get());
+                        const_node =
+                            make_shared<op::Constant>(et, shape, const_data.get(), const_data);
+                    }
+                    return const_node;
+                });
         }
     }
     else
     {
         // json file?
-        std::stringstream ss;
-        ss << in.rdbuf();
-        rc = deserialize(ss.str());
+        rc = read_functions(in.rdbuf(), nullptr, lazy_constants);
+    }
+    return rc;
+}
+
+shared_ptr<ngraph::Function> ngraph::deserialize_mmap(const string& path)
+{
+    ifstream in(path, ios_base::binary | ios_base::in);
+    bool is_container = model_container::is_model_container(in);
+    if (!is_container && !cpio::is_cpio(in))
+    {
+        // json has no binary constant data to map
+        return deserialize(in);
+    }
+
+    auto mapping = make_shared<file_util::MappedFile>(path);
+    const char* base = mapping->get_data();
+    auto make_constant = [&](const string& const_name,
+                             const element::Type& et,
+                             const Shape& shape,
+                             uint64_t offset,
+                             uint64_t size) -> shared_ptr<Node> {
+        check_constant_size(const_name, size, et, shape);
+        const char* const_data = base + offset;
+        if (reinterpret_cast<uintptr_t>(const_data) % et.size() == 0)
+        {
+            return make_shared<op::Constant>(et, shape, const_data, mapping);
+        }
+        // cpio files written before constant data was aligned
+        return make_shared<op::Constant>(et, shape, const_data);
+    };
+
+    shared_ptr<Function> rc;
+    if (is_container)
+    {
+        // Only the table of contents is read here; checksums are not verified as that would
+        // read all constant data
+        model_container::Reader reader(in);
+        const vector<model_container::BlobInfo>& blob_info = reader.get_blob_info();
+        if (blob_info.size() > 0)
+        {
+            MemoryBuffer model(base + blob_info[0].get_offset(), blob_info[0].get_size());
+            rc = read_functions(
+                &model, [&](const string& const_name, const element::Type& et, const Shape& shape) {
+                    shared_ptr<Node> const_node;
+                    if (const model_container::BlobInfo* info = reader.find(const_name))
+                    {
+                        const_node = make_constant(
+                            const_name, et, shape, info->get_offset(), info->get_size());
+                    }
+                    return const_node;
+                });
+        }
+    }
+    else
+    {
+        cpio::Reader reader(in);
+        const vector<cpio::FileInfo>& file_info = reader.get_file_info();
+        if (file_info.size() > 0)
+        {
+            unordered_map<string, const cpio::FileInfo*> constant_info;
+            for (size_t i = 1; i < file_info.size(); i++)
+            {
+                constant_info.insert({file_info[i].get_name(), &file_info[i]});
+            }
+
+            MemoryBuffer model(base + file_info[0].get_offset(), file_info[0].get_size());
+            rc = read_functions(
+                &model, [&](const string& const_name, const element::Type& et, const Shape& shape) {
+                    shared_ptr<Node> const_node;
+                    auto it = constant_info.find(const_name);
+                    if (it != constant_info.end())
+                    {
+                        const_node = make_constant(const_name,
+                                                   et,
+                                                   shape,
+                                                   it->second->get_offset(),
+                                                   it->second->get_size());
+                    }
+                    return const_node;
+                });
+        }
     }
     return rc;
 }
 
-shared_ptr<ngraph::Function> ngraph::deserialize(const string& s)
+shared_ptr<ngraph::Function> ngraph::deserialize(const string& s, bool lazy_constants)
 {
     shared_ptr<Function> rc;
     if (file_util::exists(s))
     {
         // s is a file and not a json string
         ifstream in(s, ios_base::binary | ios_base::in);
-        rc = deserialize(in);
+        rc = deserialize(in, lazy_constants);
     }
     else
     {
-        json js = json::parse(s);
-        unordered_map<string, shared_ptr<Function>> function_map;
-        for (json func : js)
+        rc = read_functions(s, nullptr, lazy_constants);
+    }
+
+    return rc;
+}
+
+// FNV-1a, which gives the same hash on every platform and in every process
+class Hasher
+{
+public:
+    void update(const void* data, size_t size)
+    {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; i++)
         {
-            shared_ptr<Function> f = read_function(func, function_map, nullptr);
-            rc = f;
+            m_hash ^= p[i];
+            m_hash *= 1099511628211ULL;
         }
     }
 
-    return rc;
+    void update(uint64_t value)
+    {
+        uint8_t bytes[8];
+        for (size_t i = 0; i < 8; i++)
+        {
+            bytes[i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+        update(bytes, sizeof(bytes));
+    }
+
+    void update(const string& value)
+    {
+        update(static_cast<uint64_t>(value.size()));
+        update(value.data(), value.size());
+    }
+
+    uint64_t get_hash() const { return m_hash; }
+private:
+    uint64_t m_hash = 14695981039346656037ULL;
+};
+
+static uint64_t hash_function(const Function& f,
+                              bool include_constants,
+                              unordered_map<const Function*, uint64_t>& function_hashes)
+{
+    auto it = function_hashes.find(&f);
+    if (it != function_hashes.end())
+    {
+        return it->second;
+    }
+
+    unordered_map<const Node*, size_t> parameter_index;
+    for (size_t i = 0; i < f.get_parameters().size(); i++)
+    {
+        parameter_index[f.get_parameters()[i].get()] = i;
+    }
+
+    // Every node hash covers the hashes of its arguments, so the result does not depend on
+    // node names or on the order the graph was built in
+    unordered_map<const Node*, uint64_t> node_hashes;
+    for (shared_ptr<Node> node : const_cast<Function&>(f).get_ordered_ops())
+    {
+        Hasher hasher;
+        json attributes = write(*node, ConstantData::external);
+        for (const char* key : {"name",
+                                "inputs",
+                                "outputs",
+                                "output_shapes",
+                                "function",
+                                "selection_function",
+                                "scatter_function"})
+        {
+            attributes.erase(key);
+        }
+        hasher.update(attributes.dump());
+        for (size_t i = 0; i < node->get_output_size(); i++)
+        {
+            hasher.update(node->get_output_element_type(i).c_type_string());
+            hasher.update(join(node->get_output_shape(i)));
+        }
+        for (const descriptor::Input& input : node->get_inputs())
+        {
+            const descriptor::Output& output = input.get_output();
+            hasher.update(node_hashes.at(output.get_node().get()));
+            hasher.update(static_cast<uint64_t>(output.get_index()));
+        }
+        for (shared_ptr<Function> called : node->get_functions())
+        {
+            hasher.update(hash_function(*called, include_constants, function_hashes));
+        }
+        auto parameter = parameter_index.find(node.get());
+        if (parameter != parameter_index.end())
+        {
+            hasher.update(static_cast<uint64_t>(parameter->second));
+        }
+        if (include_constants)
+        {
+            if (auto c = dynamic_pointer_cast<op::Constant>(node))
+            {
+                hasher.update(c->get_data_ptr(),
+                              shape_size(c->get_shape()) * c->get_element_type().size());
+            }
+        }
+        node_hashes[node.get()] = hasher.get_hash();
+    }
+
+    Hasher hasher;
+    hasher.update(static_cast<uint64_t>(f.get_parameters().size()));
+    for (const shared_ptr<op::Result>& result : f.get_results())
+    {
+        hasher.update(node_hashes.at(result.get()));
+    }
+    function_hashes[&f] = hasher.get_hash();
+    return hasher.get_hash();
+}
+
+uint64_t ngraph::hash_function(shared_ptr<Function> func, bool include_constants)
+{
+    unordered_map<const Function*, uint64_t> function_hashes;
+    return ::hash_function(*func, include_constants, function_hashes);
 }
 
-static json write(const Function& f, bool binary_constant_data)
+bool ngraph::serialize_attributes(const Node& node, string& attributes)
 {
-    json function;
-    function["name"] = f.get_name();
+    json node_js = json::object();
+    if (!write_attributes(node, node_js, ConstantData::external))
+    {
+        return false;
+    }
+    attributes = node_js.dump();
+    return true;
+}
 
+static void write(JsonWriter& writer, const Function& f, ConstantData constant_data)
+{
     vector<string> parameter_list;
     for (auto param : f.get_parameters())
     {
         parameter_list.push_back(param->get_name());
     }
-    function["parameters"] = parameter_list;
 
     // TODO Functions can return multiple results
+    vector<string> result_names;
     for (size_t i = 0; i < f.get_output_size(); ++i)
     {
-        function["result"].push_back(f.get_output_op(i)->get_name());
+        result_names.push_back(f.get_output_op(i)->get_name());
     }
 
     list<shared_ptr<Node>> result_list;
@@ -317,607 +970,657 @@ static json write(const Function& f, bool binary_constant_data)
             result_list.push_back(node_map[independent_node]);
             independent_nodes.pop_front();
 
-            for (auto sp_user : independent_node->get_users())
-            {
-                Node* user = sp_user.get();
-                node_depencency_count[user] -= 1;
-                size_t count = node_depencency_count[user];
-                if (count == 0)
-                {
-                    independent_nodes.push_back(user);
-                }
-            }
-        }
-    }
-
-    json nodes;
-    for (shared_ptr<Node> node : result_list)
-    {
-        nodes.push_back(write(*node, binary_constant_data));
-    }
-    function["ops"] = nodes;
-    return function;
-}
-
-static shared_ptr<ngraph::Function>
-    read_function(const json& func_js,
-                  unordered_map<string, shared_ptr<Function>>& function_map,
-                  function<const_data_callback_t> const_data_callback)
-{
-    shared_ptr<ngraph::Function> rc;
-
-    string func_name = func_js.at("name").get<string>();
-    vector<string> func_parameters = func_js.at("parameters").get<vector<string>>();
-    vector<string> func_result = func_js.at("result").get<vector<string>>();
-    unordered_map<string, shared_ptr<Node>> node_map;
-    for (json node_js : func_js.at("ops"))
-    {
-        try
-        {
-            string node_name = node_js.at("name").get<string>();
-            string node_op = node_js.at("op").get<string>();
-            vector<string> node_inputs = node_js.at("inputs").get<vector<string>>();
-            vector<string> node_outputs = node_js.at("outputs").get<vector<string>>();
-            shared_ptr<Node> node;
-            vector<shared_ptr<Node>> args;
-            for (const string& name : node_inputs)
-            {
-                args.push_back(node_map.at(name));
-            }
-
-            if (node_op == "Abs")
-            {
-                node = make_shared<op::Abs>(args[0]);
-            }
-            else if (node_op == "Acos")
-            {
-                node = make_shared<op::Acos>(args[0]);
-            }
-            else if (node_op == "Add")
-            {
-                node = make_shared<op::Add>(args[0], args[1]);
-            }
-            else if (node_op == "AllReduce")
-            {
-                node = make_shared<op::AllReduce>(args[0]);
-            }
-            else if (node_op == "And")
-            {
-                node = make_shared<op::And>(args[0], args[1]);
-            }
-            else if (node_op == "Asin")
-            {
-                node = make_shared<op::Asin>(args[0]);
-            }
-            else if (node_op == "Atan")
-            {
-                node = make_shared<op::Atan>(args[0]);
-            }
-            else if (node_op == "AvgPool")
-            {
-                auto window_shape = node_js.at("window_shape").get<vector<size_t>>();
-                auto window_movement_strides =
-                    node_js.at("window_movement_strides").get<vector<size_t>>();
-                auto padding_below = node_js.at("padding_below").get<vector<size_t>>();
-                auto padding_above = node_js.at("padding_above").get<vector<size_t>>();
-                auto include_padding_in_avg_computation =
-                    node_js.at("include_padding_in_avg_computation").get<bool>();
-                node = make_shared<op::AvgPool>(args[0],
-                                                window_shape,
-                                                window_movement_strides,
-                                                padding_below,
-                                                padding_above,
-                                                include_padding_in_avg_computation);
-            }
-            else if (node_op == "AvgPoolBackprop")
-            {
-                auto forward_arg_shape = node_js.at("forward_arg_shape").get<vector<size_t>>();
-                auto window_shape = node_js.at("window_shape").get<vector<size_t>>();
-                auto window_movement_strides =
-                    node_js.at("window_movement_strides").get<vector<size_t>>();
-                auto padding_below = node_js.at("padding_below").get<vector<size_t>>();
-                auto padding_above = node_js.at("padding_above").get<vector<size_t>>();
-                auto include_padding_in_avg_computation =
-                    get_or_default<bool>(node_js, "include_padding_in_avg_computation", false);
-                node = make_shared<op::AvgPoolBackprop>(forward_arg_shape,
-                                                        args[0],
-                                                        window_shape,
-                                                        window_movement_strides,
-                                                        padding_below,
-                                                        padding_above,
-                                                        include_padding_in_avg_computation);
-            }
-            else if (node_op == "BatchNorm")
-            {
-                auto epsilon = node_js.at("eps").get<double>();
-                bool training = get_or_default<bool>(node_js, "training", true);
-                if (training && args.size() == 3)
-                {
-                    node = make_shared<op::BatchNorm>(epsilon, args[0], args[1], args[2]);
-                }
-                else if (training && args.size() == 5)
-                {
-                    node = make_shared<op::BatchNorm>(
-                        epsilon, args[0], args[1], args[2], args[3], args[4], true);
-                }
-                else
-                {
-                    node = make_shared<op::BatchNorm>(
-                        epsilon, args[0], args[1], args[2], args[3], args[4]);
-                }
-            }
-            else if (node_op == "BatchNormBackprop")
-            {
-                auto epsilon = node_js.at("eps").get<double>();
-                node = make_shared<op::BatchNormBackprop>(
-                    epsilon, args[0], args[1], args[2], args[3], args[4], args[5]);
-            }
-            else if (node_op == "Broadcast")
-            {
-                auto shape = node_js.at("shape").get<vector<size_t>>();
-                auto axes = node_js.at("axes").get<set<size_t>>();
-                node = make_shared<op::Broadcast>(args[0], shape, axes);
-            }
-            else if (node_op == "Ceiling")
-            {
-                node = make_shared<op::Ceiling>(args[0]);
-            }
-            else if (node_op == "Concat")
-            {
-                auto axis = node_js.at("axis").get<size_t>();
-                node = make_shared<op::Concat>(args, axis);
-            }
-            else if (node_op == "Constant")
-            {
-                auto type_node_js =
-                    node_js.count("element_type") == 0 ? node_js.at("value_type") : node_js;
-                auto element_type = read_element_type(type_node_js.at("element_type"));
-                auto shape = type_node_js.at("shape");
-                try
-                {
-                    auto value = node_js.at("value").get<vector<string>>();
-                    node = make_shared<op::Constant>(element_type, shape, value);
-                }
-                catch (...)
-                {
-                    node = const_data_callback(node_name, element_type, shape);
-                }
-            }
-            else if (node_op == "Convert")
-            {
-                auto target_type = read_element_type(node_js.at("target_type"));
-                node = make_shared<op::Convert>(args[0], target_type);
-            }
-            else if (node_op == "Convolution")
-            {
-                auto window_movement_strides =
-                    node_js.at("window_movement_strides").get<vector<size_t>>();
-                auto window_dilation_strides =
-                    node_js.at("window_dilation_strides").get<vector<size_t>>();
-                auto padding_below = node_js.at("padding_below").get<vector<std::ptrdiff_t>>();
-                auto padding_above = node_js.at("padding_above").get<vector<std::ptrdiff_t>>();
-
-                // For backwards compatibility, we accept "image_dilation_strides" in place of
-                // "data_dilation_strides", and we also allow it to be omitted altogether.
-                auto data_dilation_strides_maybe = node_js["data_dilation_strides"];
-                if (data_dilation_strides_maybe.empty())
-                {
-                    data_dilation_strides_maybe = node_js["image_dilation_strides"];
-                }
-
-                if (data_dilation_strides_maybe.empty())
-                {
-                    node = make_shared<op::Convolution>(args[0],
-                                                        args[1],
-                                                        window_movement_strides,
-                                                        window_dilation_strides,
-                                                        padding_below,
-                                                        padding_above);
-                }
-                else
-                {
-                    node = make_shared<op::Convolution>(
-                        args[0],
-                        args[1],
-                        window_movement_strides,
-                        window_dilation_strides,
-                        padding_below,
-                        padding_above,
-                        data_dilation_strides_maybe.get<std::vector<size_t>>());
-                }
-            }
-            else if (node_op == "ConvolutionBackpropData")
-            {
-                auto data_batch_shape = node_js.at("data_batch_shape").get<vector<size_t>>();
-                auto window_movement_strides_forward =
-                    node_js.at("window_movement_strides_forward").get<vector<size_t>>();
-                auto window_dilation_strides_forward =
-                    node_js.at("window_dilation_strides_forward").get<vector<size_t>>();
-                auto padding_below_forward =
-                    node_js.at("padding_below_forward").get<vector<std::ptrdiff_t>>();
-                auto padding_above_forward =
-                    node_js.at("padding_above_forward").get<vector<std::ptrdiff_t>>();
-                auto data_dilation_strides_forward =
-                    node_js.at("data_dilation_strides_forward").get<vector<size_t>>();
-                node = make_shared<op::ConvolutionBackpropData>(data_batch_shape,
-                                                                args[0],
-                                                                args[1],
-                                                                window_movement_strides_forward,
-                                                                window_dilation_strides_forward,
-                                                                padding_below_forward,
-                                                                padding_above_forward,
-                                                                data_dilation_strides_forward);
-            }
-            else if (node_op == "ConvolutionBackpropFilters")
-            {
-                auto filters_shape = node_js.at("filters_shape").get<vector<size_t>>();
-                auto window_movement_strides_forward =
-                    node_js.at("window_movement_strides_forward").get<vector<size_t>>();
-                auto window_dilation_strides_forward =
-                    node_js.at("window_dilation_strides_forward").get<vector<size_t>>();
-                auto padding_below_forward =
-                    node_js.at("padding_below_forward").get<vector<std::ptrdiff_t>>();
-                auto padding_above_forward =
-                    node_js.at("padding_above_forward").get<vector<std::ptrdiff_t>>();
-                auto data_dilation_strides_forward =
-                    node_js.at("data_dilation_strides_forward").get<vector<size_t>>();
-                node = make_shared<op::ConvolutionBackpropFilters>(args[0],
-                                                                   filters_shape,
-                                                                   args[1],
-                                                                   window_movement_strides_forward,
-                                                                   window_dilation_strides_forward,
-                                                                   padding_below_forward,
-                                                                   padding_above_forward,
-                                                                   data_dilation_strides_forward);
-            }
-            else if (node_op == "Cos")
-            {
-                node = make_shared<op::Cos>(args[0]);
-            }
-            else if (node_op == "Cosh")
-            {
-                node = make_shared<op::Cosh>(args[0]);
-            }
-            else if (node_op == "Divide")
-            {
-                node = make_shared<op::Divide>(args[0], args[1]);
-            }
-            else if (node_op == "Dot")
-            {
-                // For backwards compatibility, reduction_axes_count is optional.
-                auto obj = node_js["reduction_axes_count"];
-                if (obj.empty())
-                {
-                    node = make_shared<op::Dot>(args[0], args[1]);
-                }
-                else
-                {
-                    size_t reduction_axes_count = obj.get<size_t>();
-                    node = make_shared<op::Dot>(args[0], args[1], reduction_axes_count);
-                }
-            }
-            else if (node_op == "Equal")
-            {
-                node = make_shared<op::Equal>(args[0], args[1]);
-            }
-            else if (node_op == "Exp")
-            {
-                node = make_shared<op::Exp>(args[0]);
-            }
-            else if (node_op == "Floor")
-            {
-                node = make_shared<op::Floor>(args[0]);
-            }
-            else if (node_op == "FunctionCall")
-            {
-                string function_name = node_js.at("function").get<string>();
-                shared_ptr<Function> f_ptr = function_map.at(function_name);
-                node = make_shared<op::FunctionCall>(f_ptr, args);
-            }
-            else if (node_op == "GetOutputElement")
-            {
-                node = make_shared<op::GetOutputElement>(args[0], node_js.at("n").get<size_t>());
-            }
-            else if (node_op == "Greater")
-            {
-                node = make_shared<op::Greater>(args[0], args[1]);
-            }
-            else if (node_op == "GreaterEq")
-            {
-                node = make_shared<op::GreaterEq>(args[0], args[1]);
-            }
-            else if (node_op == "Less")
-            {
-                node = make_shared<op::Less>(args[0], args[1]);
-            }
-            else if (node_op == "LessEq")
-            {
-                node = make_shared<op::LessEq>(args[0], args[1]);
-            }
-            else if (node_op == "Log")
-            {
-                node = make_shared<op::Log>(args[0]);
-            }
-            else if (node_op == "Max")
-            {
-                auto reduction_axes = node_js.at("reduction_axes").get<set<size_t>>();
-                node = make_shared<op::Max>(args[0], reduction_axes);
-            }
-            else if (node_op == "MaxPool")
-            {
-                auto window_shape = node_js.at("window_shape").get<vector<size_t>>();
-                auto window_movement_strides =
-                    node_js.at("window_movement_strides").get<vector<size_t>>();
-                // For backwards compatibility, both (but not just one) of the padding_ fields may be
-                // omitted.
-                auto padding_below_maybe = node_js["padding_below"];
-                auto padding_above_maybe = node_js["padding_above"];
-                if (padding_below_maybe.empty() && !padding_above_maybe.empty())
-                {
-                    throw runtime_error(
-                        "MaxPool: padding_below is absent but padding_above is present");
-                }
-                else if (!padding_below_maybe.empty() && padding_above_maybe.empty())
-                {
-                    throw runtime_error(
-                        "MaxPool: padding_below is present but padding_above is absent");
-                }
-                else if (!padding_below_maybe.empty() && !padding_above_maybe.empty())
-                {
-                    auto padding_below = padding_below_maybe.get<vector<size_t>>();
-                    auto padding_above = padding_above_maybe.get<vector<size_t>>();
-                    node = make_shared<op::MaxPool>(args[0],
-                                                    window_shape,
-                                                    window_movement_strides,
-                                                    padding_below,
-                                                    padding_above);
-                }
-                else
-                {
-                    node = make_shared<op::MaxPool>(args[0], window_shape, window_movement_strides);
-                }
-            }
-            else if (node_op == "MaxPoolBackprop")
-            {
-                auto window_shape = node_js.at("window_shape").get<vector<size_t>>();
-                auto window_movement_strides =
-                    node_js.at("window_movement_strides").get<vector<size_t>>();
-                auto padding_below = node_js.at("padding_below").get<vector<size_t>>();
-                auto padding_above = node_js.at("padding_above").get<vector<size_t>>();
-                node = make_shared<op::MaxPoolBackprop>(args[0],
-                                                        args[1],
-                                                        window_shape,
-                                                        window_movement_strides,
-                                                        padding_below,
-                                                        padding_above);
-            }
-            else if (node_op == "Maximum")
-            {
-                node = make_shared<op::Maximum>(args[0], args[1]);
-            }
-            else if (node_op == "Min")
-            {
-                auto reduction_axes = node_js.at("reduction_axes").get<set<size_t>>();
-                node = make_shared<op::Min>(args[0], reduction_axes);
-            }
-            else if (node_op == "Minimum")
-            {
-                node = make_shared<op::Minimum>(args[0], args[1]);
-            }
-            else if (node_op == "Multiply")
-            {
-                node = make_shared<op::Multiply>(args[0], args[1]);
-            }
-            else if (node_op == "Negative")
-            {
-                node = make_shared<op::Negative>(args[0]);
-            }
-            else if (node_op == "NotEqual")
-            {
-                node = make_shared<op::NotEqual>(args[0], args[1]);
-            }
-            else if (node_op == "Not")
-            {
-                node = make_shared<op::Not>(args[0]);
-            }
-            else if (node_op == "OneHot")
-            {
-                auto shape = node_js.at("shape").get<vector<size_t>>();
-                auto one_hot_axis = node_js.at("one_hot_axis").get<size_t>();
-                node = make_shared<op::OneHot>(args[0], shape, one_hot_axis);
-            }
-            else if (node_op == "Or")
-            {
-                node = make_shared<op::Or>(args[0], args[1]);
-            }
-            else if (node_op == "Pad")
-            {
-                auto padding_below = node_js.at("padding_below").get<vector<size_t>>();
-                auto padding_above = node_js.at("padding_above").get<vector<size_t>>();
-                auto padding_interior = node_js.at("padding_interior").get<vector<size_t>>();
-                node = make_shared<op::Pad>(
-                    args[0], args[1], padding_below, padding_above, padding_interior);
-            }
-            else if (node_op == "Parameter")
-            {
-                auto type_node_js =
-                    node_js.count("element_type") == 0 ? node_js.at("value_type") : node_js;
-                auto element_type = read_element_type(type_node_js.at("element_type"));
-                auto shape = type_node_js.at("shape");
-                auto cacheable = get_or_default<bool>(node_js, "cacheable", false);
-                node = make_shared<op::Parameter>(element_type, shape, cacheable);
-            }
-            else if (node_op == "Power")
-            {
-                node = make_shared<op::Power>(args[0], args[1]);
-            }
-            else if (node_op == "Product")
-            {
-                auto reduction_axes = node_js.at("reduction_axes").get<set<size_t>>();
-                node = make_shared<op::Product>(args[0], reduction_axes);
-            }
-            else if (node_op == "Reduce")
-            {
-                auto reduction_axes = node_js.at("reduction_axes").get<set<size_t>>();
-                string function_name = node_js.at("function").get<string>();
-                shared_ptr<Function> f_ptr = function_map.at(function_name);
-                node = make_shared<op::Reduce>(args[0], args[1], f_ptr, reduction_axes);
-            }
-            else if (node_op == "ReduceWindow")
-            {
-                auto window_shape = node_js.at("window_shape").get<vector<size_t>>();
-                auto window_movement_strides =
-                    node_js.at("window_movement_strides").get<vector<size_t>>();
-                string function_name = node_js.at("function").get<string>();
-                shared_ptr<Function> f_ptr = function_map.at(function_name);
-                node = make_shared<op::ReduceWindow>(
-                    args[0], args[1], f_ptr, window_shape, window_movement_strides);
-            }
-            else if (node_op == "Remainder")
-            {
-                node = make_shared<op::Remainder>(args[0], args[1]);
-            }
-            else if (node_op == "Relu")
-            {
-                node = make_shared<op::Relu>(args[0]);
-            }
-            else if (node_op == "ReluBackprop")
-            {
-                node = make_shared<op::ReluBackprop>(args[0], args[1]);
-            }
-            else if (node_op == "ReplaceSlice")
-            {
-                auto lower_bounds = node_js.at("lower_bounds").get<vector<size_t>>();
-                auto upper_bounds = node_js.at("upper_bounds").get<vector<size_t>>();
-                auto strides = node_js.at("strides").get<vector<size_t>>();
-                node = make_shared<op::ReplaceSlice>(
-                    args[0], args[1], lower_bounds, upper_bounds, strides);
-            }
-            else if (node_op == "Reshape")
-            {
-                auto input_order = node_js.at("input_order").get<vector<size_t>>();
-                auto output_shape = node_js.at("output_shape").get<vector<size_t>>();
-                node = make_shared<op::Reshape>(args[0], input_order, output_shape);
-            }
-            else if (node_op == "Result")
-            {
-                node = make_shared<op::Result>(args[0]);
-            }
-            else if (node_op == "Reverse")
-            {
-                auto reversed_axes = node_js.at("reversed_axes").get<set<size_t>>();
-                node = make_shared<op::Reverse>(args[0], reversed_axes);
-            }
-            else if (node_op == "ReverseSequence")
+            for (auto sp_user : independent_node->get_users())
             {
-                auto batch_axis = node_js.at("batch_axis").get<size_t>();
-                auto sequence_axis = node_js.at("sequence_axis").get<size_t>();
-                node =
-                    make_shared<op::ReverseSequence>(args[0], args[1], batch_axis, sequence_axis);
+                Node* user = sp_user.get();
+                node_depencency_count[user] -= 1;
+                size_t count = node_depencency_count[user];
+                if (count == 0)
+                {
+                    independent_nodes.push_back(user);
+                }
             }
-            else if (node_op == "Select")
+        }
+    }
+
+    // Members are in the order json::dump would write them
+    writer.begin('{');
+    writer.key("name");
+    writer.value(f.get_name());
+    writer.key("ops");
+    writer.begin('[');
+    for (shared_ptr<Node> node : result_list)
+    {
+        writer.next();
+        writer.value(write(*node, constant_data));
+    }
+    writer.end(']');
+    writer.key("parameters");
+    writer.value(parameter_list);
+    writer.key("result");
+    writer.value(result_names);
+    writer.end('}');
+}
+
+static shared_ptr<Node> read_node(json& node_js,
+                                  unordered_map<string, shared_ptr<Node>>& node_map,
+                                  unordered_map<string, shared_ptr<Function>>& function_map,
+                                  function<const_data_callback_t> const_data_callback)
+{
+    shared_ptr<Node> node;
+    try
+    {
+        string node_name = node_js.at("name").get<string>();
+        string node_op = node_js.at("op").get<string>();
+        vector<string> node_inputs = node_js.at("inputs").get<vector<string>>();
+        vector<string> node_outputs = node_js.at("outputs").get<vector<string>>();
+        vector<shared_ptr<Node>> args;
+        for (const string& name : node_inputs)
+        {
+            args.push_back(node_map.at(name));
+        }
+
+        if (node_op == "Abs")
+        {
+            node = make_shared<op::Abs>(args[0]);
+        }
+        else if (node_op == "Acos")
+        {
+            node = make_shared<op::Acos>(args[0]);
+        }
+        else if (node_op == "Add")
+        {
+            node = make_shared<op::Add>(args[0], args[1]);
+        }
+        else if (node_op == "AllReduce")
+        {
+            node = make_shared<op::AllReduce>(args[0]);
+        }
+        else if (node_op == "And")
+        {
+            node = make_shared<op::And>(args[0], args[1]);
+        }
+        else if (node_op == "Asin")
+        {
+            node = make_shared<op::Asin>(args[0]);
+        }
+        else if (node_op == "Atan")
+        {
+            node = make_shared<op::Atan>(args[0]);
+        }
+        else if (node_op == "AvgPool")
+        {
+            auto window_shape = node_js.at("window_shape").get<vector<size_t>>();
+            auto window_movement_strides =
+                node_js.at("window_movement_strides").get<vector<size_t>>();
+            auto padding_below = node_js.at("padding_below").get<vector<size_t>>();
+            auto padding_above = node_js.at("padding_above").get<vector<size_t>>();
+            auto include_padding_in_avg_computation =
+                node_js.at("include_padding_in_avg_computation").get<bool>();
+            node = make_shared<op::AvgPool>(args[0],
+                                            window_shape,
+                                            window_movement_strides,
+                                            padding_below,
+                                            padding_above,
+                                            include_padding_in_avg_computation);
+        }
+        else if (node_op == "AvgPoolBackprop")
+        {
+            auto forward_arg_shape = node_js.at("forward_arg_shape").get<vector<size_t>>();
+            auto window_shape = node_js.at("window_shape").get<vector<size_t>>();
+            auto window_movement_strides =
+                node_js.at("window_movement_strides").get<vector<size_t>>();
+            auto padding_below = node_js.at("padding_below").get<vector<size_t>>();
+            auto padding_above = node_js.at("padding_above").get<vector<size_t>>();
+            auto include_padding_in_avg_computation =
+                get_or_default<bool>(node_js, "include_padding_in_avg_computation", false);
+            node = make_shared<op::AvgPoolBackprop>(forward_arg_shape,
+                                                    args[0],
+                                                    window_shape,
+                                                    window_movement_strides,
+                                                    padding_below,
+                                                    padding_above,
+                                                    include_padding_in_avg_computation);
+        }
+        else if (node_op == "BatchNorm")
+        {
+            auto epsilon = node_js.at("eps").get<double>();
+            bool training = get_or_default<bool>(node_js, "training", true);
+            if (training && args.size() == 3)
             {
-                node = make_shared<op::Select>(args[0], args[1], args[2]);
+                node = make_shared<op::BatchNorm>(epsilon, args[0], args[1], args[2]);
             }
-            else if (node_op == "SelectAndScatter")
+            else if (training && args.size() == 5)
             {
-                string selection_function_name = node_js.at("selection_function").get<string>();
-                shared_ptr<Function> selection_f_ptr = function_map.at(selection_function_name);
-                string scatter_function_name = node_js.at("scatter_function").get<string>();
-                shared_ptr<Function> scatter_f_ptr = function_map.at(scatter_function_name);
-
-                auto window_shape = node_js.at("window_shape").get<vector<size_t>>();
-                auto window_movement_strides =
-                    node_js.at("window_movement_strides").get<vector<size_t>>();
-
-                node = make_shared<op::SelectAndScatter>(args[0],
-                                                         args[1],
-                                                         args[2],
-                                                         selection_f_ptr,
-                                                         scatter_f_ptr,
-                                                         window_shape,
-                                                         window_movement_strides);
+                node = make_shared<op::BatchNorm>(
+                    epsilon, args[0], args[1], args[2], args[3], args[4], true);
             }
-            else if (node_op == "Sigmoid")
+            else
             {
-                node = make_shared<op::Sigmoid>(args[0]);
+                node = make_shared<op::BatchNorm>(
+                    epsilon, args[0], args[1], args[2], args[3], args[4]);
             }
-            else if (node_op == "SigmoidBackprop")
-            {
-                node = make_shared<op::SigmoidBackprop>(args[0], args[1]);
+        }
+        else if (node_op == "BatchNormBackprop")
+        {
+            auto epsilon = node_js.at("eps").get<double>();
+            node = make_shared<op::BatchNormBackprop>(
+                epsilon, args[0], args[1], args[2], args[3], args[4], args[5]);
+        }
+        else if (node_op == "Broadcast")
+        {
+            auto shape = node_js.at("shape").get<vector<size_t>>();
+            auto axes = node_js.at("axes").get<set<size_t>>();
+            node = make_shared<op::Broadcast>(args[0], shape, axes);
+        }
+        else if (node_op == "Ceiling")
+        {
+            node = make_shared<op::Ceiling>(args[0]);
+        }
+        else if (node_op == "Concat")
+        {
+            auto axis = node_js.at("axis").get<size_t>();
+            node = make_shared<op::Concat>(args, axis);
+        }
+        else if (node_op == "Constant")
+        {
+            auto type_node_js =
+                node_js.count("element_type") == 0 ? node_js.at("value_type") : node_js;
+            auto element_type = read_element_type(type_node_js.at("element_type"));
+            Shape shape = type_node_js.at("shape");
+            // Data in the json text is decoded later, in parallel with the other constants
+            if (node_js.count("value_base64") != 0)
+            {
+                auto text = make_shared<string>(node_js.at("value_base64").get<string>());
+                size_t size = shape_size(shape) * element_type.size();
+                node = make_shared<op::Constant>(
+                    element_type, shape, [text, size, node_name](void* data) {
+                        try
+                        {
+                            base64_decode(*text, data, size);
+                        }
+                        catch (const exception& e)
+                        {
+                            throw ngraph_error("Error decoding constant '" + node_name + "': " +
+                                               e.what());
+                        }
+                    });
             }
-            else if (node_op == "Sign")
+            else if (node_js.count("value") != 0)
             {
-                node = make_shared<op::Sign>(args[0]);
+                auto values =
+                    make_shared<vector<string>>(node_js.at("value").get<vector<string>>());
+                if (values->size() != shape_size(shape))
+                {
+                    throw ngraph_error("Constant does not have the expected number of literals");
+                }
+                node = make_shared<op::Constant>(
+                    element_type, shape, [values, element_type, shape, node_name](void* data) {
+                        try
+                        {
+                            op::Constant::write_to_buffer(element_type,
+                                                          shape,
+                                                          parse_string<double>(*values),
+                                                          data,
+                                                          shape_size(shape));
+                        }
+                        catch (const exception& e)
+                        {
+                            throw ngraph_error("Error decoding constant '" + node_name + "': " +
+                                               e.what());
+                        }
+                    });
             }
-            else if (node_op == "Sin")
+            else
             {
-                node = make_shared<op::Sin>(args[0]);
+                node = const_data_callback(node_name, element_type, shape);
             }
-            else if (node_op == "Sinh")
+        }
+        else if (node_op == "Convert")
+        {
+            auto target_type = read_element_type(node_js.at("target_type"));
+            node = make_shared<op::Convert>(args[0], target_type);
+        }
+        else if (node_op == "Convolution")
+        {
+            auto window_movement_strides =
+                node_js.at("window_movement_strides").get<vector<size_t>>();
+            auto window_dilation_strides =
+                node_js.at("window_dilation_strides").get<vector<size_t>>();
+            auto padding_below = node_js.at("padding_below").get<vector<std::ptrdiff_t>>();
+            auto padding_above = node_js.at("padding_above").get<vector<std::ptrdiff_t>>();
+
+            // For backwards compatibility, we accept "image_dilation_strides" in place of
+            // "data_dilation_strides", and we also allow it to be omitted altogether.
+            auto data_dilation_strides_maybe = node_js["data_dilation_strides"];
+            if (data_dilation_strides_maybe.empty())
             {
-                node = make_shared<op::Sinh>(args[0]);
+                data_dilation_strides_maybe = node_js["image_dilation_strides"];
             }
-            else if (node_op == "Slice")
+
+            if (data_dilation_strides_maybe.empty())
             {
-                auto lower_bounds = node_js.at("lower_bounds").get<vector<size_t>>();
-                auto upper_bounds = node_js.at("upper_bounds").get<vector<size_t>>();
-                auto strides = node_js.at("strides").get<vector<size_t>>();
-                node = make_shared<op::Slice>(args[0], lower_bounds, upper_bounds, strides);
+                node = make_shared<op::Convolution>(args[0],
+                                                    args[1],
+                                                    window_movement_strides,
+                                                    window_dilation_strides,
+                                                    padding_below,
+                                                    padding_above);
             }
-            else if (node_op == "Softmax")
+            else
             {
-                auto softmax_axes = node_js.at("softmax_axes").get<set<size_t>>();
-                node = make_shared<op::Softmax>(args[0], softmax_axes);
+                node = make_shared<op::Convolution>(
+                    args[0],
+                    args[1],
+                    window_movement_strides,
+                    window_dilation_strides,
+                    padding_below,
+                    padding_above,
+                    data_dilation_strides_maybe.get<std::vector<size_t>>());
             }
-            else if (node_op == "Sqrt")
+        }
+        else if (node_op == "ConvolutionBackpropData")
+        {
+            auto data_batch_shape = node_js.at("data_batch_shape").get<vector<size_t>>();
+            auto window_movement_strides_forward =
+                node_js.at("window_movement_strides_forward").get<vector<size_t>>();
+            auto window_dilation_strides_forward =
+                node_js.at("window_dilation_strides_forward").get<vector<size_t>>();
+            auto padding_below_forward =
+                node_js.at("padding_below_forward").get<vector<std::ptrdiff_t>>();
+            auto padding_above_forward =
+                node_js.at("padding_above_forward").get<vector<std::ptrdiff_t>>();
+            auto data_dilation_strides_forward =
+                node_js.at("data_dilation_strides_forward").get<vector<size_t>>();
+            node = make_shared<op::ConvolutionBackpropData>(data_batch_shape,
+                                                            args[0],
+                                                            args[1],
+                                                            window_movement_strides_forward,
+                                                            window_dilation_strides_forward,
+                                                            padding_below_forward,
+                                                            padding_above_forward,
+                                                            data_dilation_strides_forward);
+        }
+        else if (node_op == "ConvolutionBackpropFilters")
+        {
+            auto filters_shape = node_js.at("filters_shape").get<vector<size_t>>();
+            auto window_movement_strides_forward =
+                node_js.at("window_movement_strides_forward").get<vector<size_t>>();
+            auto window_dilation_strides_forward =
+                node_js.at("window_dilation_strides_forward").get<vector<size_t>>();
+            auto padding_below_forward =
+                node_js.at("padding_below_forward").get<vector<std::ptrdiff_t>>();
+            auto padding_above_forward =
+                node_js.at("padding_above_forward").get<vector<std::ptrdiff_t>>();
+            auto data_dilation_strides_forward =
+                node_js.at("data_dilation_strides_forward").get<vector<size_t>>();
+            node = make_shared<op::ConvolutionBackpropFilters>(args[0],
+                                                               filters_shape,
+                                                               args[1],
+                                                               window_movement_strides_forward,
+                                                               window_dilation_strides_forward,
+                                                               padding_below_forward,
+                                                               padding_above_forward,
+                                                               data_dilation_strides_forward);
+        }
+        else if (node_op == "Cos")
+        {
+            node = make_shared<op::Cos>(args[0]);
+        }
+        else if (node_op == "Cosh")
+        {
+            node = make_shared<op::Cosh>(args[0]);
+        }
+        else if (node_op == "Divide")
+        {
+            node = make_shared<op::Divide>(args[0], args[1]);
+        }
+        else if (node_op == "Dot")
+        {
+            // For backwards compatibility, reduction_axes_count is optional.
+            auto obj = node_js["reduction_axes_count"];
+            if (obj.empty())
             {
-                node = make_shared<op::Sqrt>(args[0]);
+                node = make_shared<op::Dot>(args[0], args[1]);
             }
-            else if (node_op == "Subtract")
+            else
             {
-                node = make_shared<op::Subtract>(args[0], args[1]);
+                size_t reduction_axes_count = obj.get<size_t>();
+                node = make_shared<op::Dot>(args[0], args[1], reduction_axes_count);
             }
-            else if (node_op == "Sum")
+        }
+        else if (node_op == "Equal")
+        {
+            node = make_shared<op::Equal>(args[0], args[1]);
+        }
+        else if (node_op == "Exp")
+        {
+            node = make_shared<op::Exp>(args[0]);
+        }
+        else if (node_op == "Floor")
+        {
+            node = make_shared<op::Floor>(args[0]);
+        }
+        else if (node_op == "FunctionCall")
+        {
+            string function_name = node_js.at("function").get<string>();
+            shared_ptr<Function> f_ptr = function_map.at(function_name);
+            node = make_shared<op::FunctionCall>(f_ptr, args);
+        }
+        else if (node_op == "GetOutputElement")
+        {
+            node = make_shared<op::GetOutputElement>(args[0], node_js.at("n").get<size_t>());
+        }
+        else if (node_op == "Greater")
+        {
+            node = make_shared<op::Greater>(args[0], args[1]);
+        }
+        else if (node_op == "GreaterEq")
+        {
+            node = make_shared<op::GreaterEq>(args[0], args[1]);
+        }
+        else if (node_op == "Less")
+        {
+            node = make_shared<op::Less>(args[0], args[1]);
+        }
+        else if (node_op == "LessEq")
+        {
+            node = make_shared<op::LessEq>(args[0], args[1]);
+        }
+        else if (node_op == "Log")
+        {
+            node = make_shared<op::Log>(args[0]);
+        }
+        else if (node_op == "Max")
+        {
+            auto reduction_axes = node_js.at("reduction_axes").get<set<size_t>>();
+            node = make_shared<op::Max>(args[0], reduction_axes);
+        }
+        else if (node_op == "MaxPool")
+        {
+            auto window_shape = node_js.at("window_shape").get<vector<size_t>>();
+            auto window_movement_strides =
+                node_js.at("window_movement_strides").get<vector<size_t>>();
+            // For backwards compatibility, both (but not just one) of the padding_ fields may be
+            // omitted.
+            auto padding_below_maybe = node_js["padding_below"];
+            auto padding_above_maybe = node_js["padding_above"];
+            if (padding_below_maybe.empty() && !padding_above_maybe.empty())
             {
-                auto reduction_axes = node_js.at("reduction_axes").get<set<size_t>>();
-                node = make_shared<op::Sum>(args[0], reduction_axes);
+                throw runtime_error(
+                    "MaxPool: padding_below is absent but padding_above is present");
             }
-            else if (node_op == "Tan")
+            else if (!padding_below_maybe.empty() && padding_above_maybe.empty())
             {
-                node = make_shared<op::Tan>(args[0]);
+                throw runtime_error(
+                    "MaxPool: padding_below is present but padding_above is absent");
             }
-            else if (node_op == "Tanh")
+            else if (!padding_below_maybe.empty() && !padding_above_maybe.empty())
             {
-                node = make_shared<op::Tanh>(args[0]);
+                auto padding_below = padding_below_maybe.get<vector<size_t>>();
+                auto padding_above = padding_above_maybe.get<vector<size_t>>();
+                node = make_shared<op::MaxPool>(args[0],
+                                                window_shape,
+                                                window_movement_strides,
+                                                padding_below,
+                                                padding_above);
             }
             else
             {
-                stringstream ss;
-                ss << "unsupported op " << node_op;
-                throw runtime_error(ss.str());
+                node = make_shared<op::MaxPool>(args[0], window_shape, window_movement_strides);
             }
-            node_map[node_name] = node;
+        }
+        else if (node_op == "MaxPoolBackprop")
+        {
+            auto window_shape = node_js.at("window_shape").get<vector<size_t>>();
+            auto window_movement_strides =
+                node_js.at("window_movement_strides").get<vector<size_t>>();
+            auto padding_below = node_js.at("padding_below").get<vector<size_t>>();
+            auto padding_above = node_js.at("padding_above").get<vector<size_t>>();
+            node = make_shared<op::MaxPoolBackprop>(args[0],
+                                                    args[1],
+                                                    window_shape,
+                                                    window_movement_strides,
+                                                    padding_below,
+                                                    padding_above);
+        }
+        else if (node_op == "Maximum")
+        {
+            node = make_shared<op::Maximum>(args[0], args[1]);
+        }
+        else if (node_op == "Min")
+        {
+            auto reduction_axes = node_js.at("reduction_axes").get<set<size_t>>();
+            node = make_shared<op::Min>(args[0], reduction_axes);
+        }
+        else if (node_op == "Minimum")
+        {
+            node = make_shared<op::Minimum>(args[0], args[1]);
+        }
+        else if (node_op == "Multiply")
+        {
+            node = make_shared<op::Multiply>(args[0], args[1]);
+        }
+        else if (node_op == "Negative")
+        {
+            node = make_shared<op::Negative>(args[0]);
+        }
+        else if (node_op == "NotEqual")
+        {
+            node = make_shared<op::NotEqual>(args[0], args[1]);
+        }
+        else if (node_op == "Not")
+        {
+            node = make_shared<op::Not>(args[0]);
+        }
+        else if (node_op == "OneHot")
+        {
+            auto shape = node_js.at("shape").get<vector<size_t>>();
+            auto one_hot_axis = node_js.at("one_hot_axis").get<size_t>();
+            node = make_shared<op::OneHot>(args[0], shape, one_hot_axis);
+        }
+        else if (node_op == "Or")
+        {
+            node = make_shared<op::Or>(args[0], args[1]);
+        }
+        else if (node_op == "Pad")
+        {
+            auto padding_below = node_js.at("padding_below").get<vector<size_t>>();
+            auto padding_above = node_js.at("padding_above").get<vector<size_t>>();
+            auto padding_interior = node_js.at("padding_interior").get<vector<size_t>>();
+            node = make_shared<op::Pad>(
+                args[0], args[1], padding_below, padding_above, padding_interior);
+        }
+        else if (node_op == "Parameter")
+        {
+            auto type_node_js =
+                node_js.count("element_type") == 0 ? node_js.at("value_type") : node_js;
+            auto element_type = read_element_type(type_node_js.at("element_type"));
+            auto shape = type_node_js.at("shape");
+            auto cacheable = get_or_default<bool>(node_js, "cacheable", false);
+            node = make_shared<op::Parameter>(element_type, shape, cacheable);
+        }
+        else if (node_op == "Power")
+        {
+            node = make_shared<op::Power>(args[0], args[1]);
+        }
+        else if (node_op == "Product")
+        {
+            auto reduction_axes = node_js.at("reduction_axes").get<set<size_t>>();
+            node = make_shared<op::Product>(args[0], reduction_axes);
+        }
+        else if (node_op == "Reduce")
+        {
+            auto reduction_axes = node_js.at("reduction_axes").get<set<size_t>>();
+            string function_name = node_js.at("function").get<string>();
+            shared_ptr<Function> f_ptr = function_map.at(function_name);
+            node = make_shared<op::Reduce>(args[0], args[1], f_ptr, reduction_axes);
+        }
+        else if (node_op == "ReduceWindow")
+        {
+            auto window_shape = node_js.at("window_shape").get<vector<size_t>>();
+            auto window_movement_strides =
+                node_js.at("window_movement_strides").get<vector<size_t>>();
+            string function_name = node_js.at("function").get<string>();
+            shared_ptr<Function> f_ptr = function_map.at(function_name);
+            node = make_shared<op::ReduceWindow>(
+                args[0], args[1], f_ptr, window_shape, window_movement_strides);
+        }
+        else if (node_op == "Remainder")
+        {
+            node = make_shared<op::Remainder>(args[0], args[1]);
+        }
+        else if (node_op == "Relu")
+        {
+            node = make_shared<op::Relu>(args[0]);
+        }
+        else if (node_op == "ReluBackprop")
+        {
+            node = make_shared<op::ReluBackprop>(args[0], args[1]);
+        }
+        else if (node_op == "ReplaceSlice")
+        {
+            auto lower_bounds = node_js.at("lower_bounds").get<vector<size_t>>();
+            auto upper_bounds = node_js.at("upper_bounds").get<vector<size_t>>();
+            auto strides = node_js.at("strides").get<vector<size_t>>();
+            node = make_shared<op::ReplaceSlice>(
+                args[0], args[1], lower_bounds, upper_bounds, strides);
+        }
+        else if (node_op == "Reshape")
+        {
+            auto input_order = node_js.at("input_order").get<vector<size_t>>();
+            auto output_shape = node_js.at("output_shape").get<vector<size_t>>();
+            node = make_shared<op::Reshape>(args[0], input_order, output_shape);
+        }
+        else if (node_op == "Result")
+        {
+            node = make_shared<op::Result>(args[0]);
+        }
+        else if (node_op == "Reverse")
+        {
+            auto reversed_axes = node_js.at("reversed_axes").get<set<size_t>>();
+            node = make_shared<op::Reverse>(args[0], reversed_axes);
+        }
+        else if (node_op == "ReverseSequence")
+        {
+            auto batch_axis = node_js.at("batch_axis").get<size_t>();
+            auto sequence_axis = node_js.at("sequence_axis").get<size_t>();
+            node =
+                make_shared<op::ReverseSequence>(args[0], args[1], batch_axis, sequence_axis);
+        }
+        else if (node_op == "Select")
+        {
+            node = make_shared<op::Select>(args[0], args[1], args[2]);
+        }
+        else if (node_op == "SelectAndScatter")
+        {
+            string selection_function_name = node_js.at("selection_function").get<string>();
+            shared_ptr<Function> selection_f_ptr = function_map.at(selection_function_name);
+            string scatter_function_name = node_js.at("scatter_function").get<string>();
+            shared_ptr<Function> scatter_f_ptr = function_map.at(scatter_function_name);
+
+            auto window_shape = node_js.at("window_shape").get<vector<size_t>>();
+            auto window_movement_strides =
+                node_js.at("window_movement_strides").get<vector<size_t>>();
+
+            node = make_shared<op::SelectAndScatter>(args[0],
+                                                     args[1],
+                                                     args[2],
+                                                     selection_f_ptr,
+                                                     scatter_f_ptr,
+                                                     window_shape,
+                                                     window_movement_strides);
+        }
+        else if (node_op == "Sigmoid")
+        {
+            node = make_shared<op::Sigmoid>(args[0]);
+        }
+        else if (node_op == "SigmoidBackprop")
+        {
+            node = make_shared<op::SigmoidBackprop>(args[0], args[1]);
+        }
+        else if (node_op == "Sign")
+        {
+            node = make_shared<op::Sign>(args[0]);
+        }
+        else if (node_op == "Sin")
+        {
+            node = make_shared<op::Sin>(args[0]);
+        }
+        else if (node_op == "Sinh")
+        {
+            node = make_shared<op::Sinh>(args[0]);
+        }
+        else if (node_op == "Slice")
+        {
+            auto lower_bounds = node_js.at("lower_bounds").get<vector<size_t>>();
+            auto upper_bounds = node_js.at("upper_bounds").get<vector<size_t>>();
+            auto strides = node_js.at("strides").get<vector<size_t>>();
+            node = make_shared<op::Slice>(args[0], lower_bounds, upper_bounds, strides);
+        }
+        else if (node_op == "Softmax")
+        {
+            auto softmax_axes = node_js.at("softmax_axes").get<set<size_t>>();
+            node = make_shared<op::Softmax>(args[0], softmax_axes);
+        }
+        else if (node_op == "Sqrt")
+        {
+            node = make_shared<op::Sqrt>(args[0]);
+        }
+        else if (node_op == "Subtract")
+        {
+            node = make_shared<op::Subtract>(args[0], args[1]);
+        }
+        else if (node_op == "Sum")
+        {
+            auto reduction_axes = node_js.at("reduction_axes").get<set<size_t>>();
+            node = make_shared<op::Sum>(args[0], reduction_axes);
+        }
+        else if (node_op == "Tan")
+        {
+            node = make_shared<op::Tan>(args[0]);
+        }
+        else if (node_op == "Tanh")
+        {
+            node = make_shared<op::Tanh>(args[0]);
+        }
+        else
+        {
+            stringstream ss;
+            ss << "unsupported op " << node_op;
+            throw runtime_error(ss.str());
+        }
+        node_map[node_name] = node;
 
-            // Typically, it could be unsafe to change the name of a node since it may break nameing
-            // uniqueness. However, it could sometimes be helpful to use the original name from
-            // the serialization for debugging.
-            // node->set_name(node_name);
+        // Typically, it could be unsafe to change the name of a node since it may break nameing
+        // uniqueness. However, it could sometimes be helpful to use the original name from
+        // the serialization for debugging.
+        // node->set_name(node_name);
+    }
+    catch (...)
+    {
+        string node_name;
+        try
+        {
+            node_name = node_js.at("name").get<string>();
         }
         catch (...)
         {
-            string node_name;
-            try
-            {
-                node_name = node_js.at("name").get<string>();
-            }
-            catch (...)
-            {
-                node_name = "UNKNOWN";
-            }
-            throw runtime_error("Error parsing json at node '" + node_name + "'");
+            node_name = "UNKNOWN";
         }
+        throw runtime_error("Error parsing json at node '" + node_name + "'");
     }
+    return node;
+}
+
+static shared_ptr<ngraph::Function>
+    make_function(const string& func_name,
+                  const vector<string>& func_parameters,
+                  const vector<string>& func_result,
+                  const unordered_map<string, shared_ptr<Node>>& node_map,
+                  unordered_map<string, shared_ptr<Function>>& function_map)
+{
+    shared_ptr<ngraph::Function> rc;
 
     //This handles both graphs w/ `op::Result` and legacy graphs w/o it
     //If we are dealing w/ a legacy graph, add op::Result for each output node
@@ -956,7 +1659,54 @@ static shared_ptr<ngraph::Function>
     return rc;
 }
 
-static json write(const Node& n, bool binary_constant_data)
+static shared_ptr<ngraph::Function>
+    read_function(JsonReader& reader,
+                  unordered_map<string, shared_ptr<Function>>& function_map,
+                  function<const_data_callback_t> const_data_callback)
+{
+    string func_name;
+    vector<string> func_parameters;
+    vector<string> func_result;
+    unordered_map<string, shared_ptr<Node>> node_map;
+
+    reader.expect('{');
+    bool first = true;
+    while (reader.next(first, '}'))
+    {
+        string key = reader.read_string();
+        reader.expect(':');
+        if (key == "name")
+        {
+            func_name = reader.read_string();
+        }
+        else if (key == "parameters")
+        {
+            func_parameters = json::parse(reader.read_value_text()).get<vector<string>>();
+        }
+        else if (key == "result")
+        {
+            func_result = json::parse(reader.read_value_text()).get<vector<string>>();
+        }
+        else if (key == "ops")
+        {
+            // Nodes are built as they are read, from one op at a time
+            reader.expect('[');
+            bool first_op = true;
+            while (reader.next(first_op, ']'))
+            {
+                json node_js = json::parse(reader.read_value_text());
+                read_node(node_js, node_map, function_map, const_data_callback);
+            }
+        }
+        else
+        {
+            reader.read_value_text();
+        }
+    }
+    return make_function(func_name, func_parameters, func_result, node_map, function_map);
+}
+
+static json write(const Node& n, ConstantData constant_data)
 {
     json node;
     node["name"] = n.get_name();
@@ -987,6 +1737,12 @@ static json write(const Node& n, bool binary_constant_data)
         node["output_shapes"] = output_shapes;
     }
 
+    write_attributes(n, node, constant_data);
+    return node;
+}
+
+static bool write_attributes(const Node& n, json& node, ConstantData constant_data)
+{
     string node_op = n.description();
     if (node_op == "Abs")
     {
@@ -1000,6 +1756,9 @@ static json write(const Node& n, bool binary_constant_data)
     else if (node_op == "AllReduce")
     {
     }
+    else if (node_op == "And")
+    {
+    }
     else if (node_op == "Asin")
     {
     }
@@ -1053,10 +1812,15 @@ static json write(const Node& n, bool binary_constant_data)
     else if (node_op == "Constant")
     {
         auto tmp = dynamic_cast<const op::Constant*>(&n);
-        if (!binary_constant_data)
+        if (constant_data == ConstantData::strings)
         {
             node["value"] = tmp->get_value_strings();
         }
+        else if (constant_data == ConstantData::base64)
+        {
+            size_t size = shape_size(tmp->get_shape()) * tmp->get_element_type().size();
+            node["value_base64"] = base64_encode(tmp->get_data_ptr(), size);
+        }
         node["shape"] = tmp->get_shape();
         node["element_type"] = write_element_type(tmp->get_element_type());
     }
@@ -1191,6 +1955,9 @@ static json write(const Node& n, bool binary_constant_data)
         node["shape"] = tmp->get_shape();
         node["one_hot_axis"] = tmp->get_one_hot_axis();
     }
+    else if (node_op == "Or")
+    {
+    }
     else if (node_op == "Pad")
     {
         auto tmp = dynamic_cast<const op::Pad*>(&n);
@@ -1317,6 +2084,10 @@ static json write(const Node& n, bool binary_constant_data)
     else if (node_op == "Tanh")
     {
     }
+    else
+    {
+        return false;
+    }
 
-    return node;
+    return true;
 }
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
 #include "ngraph/function.hpp"
@@ -28,7 +29,12 @@ namespace ngraph
     // @param indent If 0 then there is no formatting applied and the resulting string is the
     //    most compact representation. If non-zero then the json string is formatted with the
     //    indent level specified.
-    std::string serialize(std::shared_ptr<ngraph::Function> func, size_t indent = 0);
+    // @param base64_constants Write the exact bytes of constants as "value_base64" instead
+    //    of the "value" literal strings. This is smaller and faster to read, but readers
+    //    older than this option can't load the result.
+    std::string serialize(std::shared_ptr<ngraph::Function> func,
+                          size_t indent = 0,
+                          bool base64_constants = false);
 
     // @brief Serialize a Function to as a json file
     // @param path The path to the output file
@@ -36,23 +42,63 @@ namespace ngraph
     // @param indent If 0 then there is no formatting applied and the resulting string is the
     //    most compact representation. If non-zero then the json string is formatted with the
     //    indent level specified.
+    // @param checksums Store a CRC-32 of every blob, see the stream overload
     void serialize(const std::string& path,
                    std::shared_ptr<ngraph::Function> func,
-                   size_t indent = 0);
+                   size_t indent = 0,
+                   bool checksums = false);
 
-    // @brief Serialize a Function to a CPIO file with all constant data stored as binary
+    // @brief Serialize a Function to a model container (see model_container.hpp) with all
+    //    constant data stored as binary blobs
     // @param out The output stream to which the data is serialized.
     // @param func The Function to serialize
     // @param indent If 0 then there is no formatting applied and the json is the
     //    most compact representation. If non-zero then the json is formatted with the
     //    indent level specified.
-    void serialize(std::ostream& out, std::shared_ptr<ngraph::Function> func, size_t indent = 0);
+    // @param checksums Store a CRC-32 of every blob. deserialize verifies the blobs that
+    //    have one, at the cost of a pass over all constant data on both ends.
+    void serialize(std::ostream& out,
+                   std::shared_ptr<ngraph::Function> func,
+                   size_t indent = 0,
+                   bool checksums = false);
 
     // @brief Deserialize a Function
-    // @param in An isteam to the input data
-    std::shared_ptr<ngraph::Function> deserialize(std::istream& in);
+    // @param in An isteam to a model container, a legacy CPIO file or json
+    // @param lazy_constants Decode the data of json constants when it is first used rather
+    //    than on all hardware threads before returning
+    std::shared_ptr<ngraph::Function> deserialize(std::istream& in, bool lazy_constants = false);
 
     // @brief Deserialize a Function
     // @param str The json formatted string to deseriailze.
-    std::shared_ptr<ngraph::Function> deserialize(const std::string& str);
+    // @param lazy_constants Decode the data of json constants when it is first used rather
+    //    than on all hardware threads before returning
+    std::shared_ptr<ngraph::Function> deserialize(const std::string& str,
+                                                  bool lazy_constants = false);
+
+    // @brief Deserialize a Function from a file without copying its constant data
+    //
+    // The file is memory mapped and the constants of a model container or CPIO file reference
+    // their data in the mapping, which stays mapped while any of them exists. Constant data is
+    // only read from disk when it is used and its pages are shared by all processes loading
+    // the same file. Checksums are not verified.
+    // @param path The path of a file written by serialize
+    std::shared_ptr<ngraph::Function> deserialize_mmap(const std::string& path);
+
+    // @brief Computes a structural hash of a Function in one pass over its ops
+    //
+    // The hash covers op types, the attributes the serializer writes, output element types
+    // and shapes, the connections between ops, parameter order and called functions. It does
+    // not depend on node or function names, so equal graphs built separately, or in different
+    // processes, hash the same. Attributes of ops unknown to the serializer, such as backend
+    // specific fused ops, are not covered.
+    // @param func The Function to hash
+    // @param include_constants Also hash the data of constants, not only their types and shapes
+    uint64_t hash_function(std::shared_ptr<ngraph::Function> func, bool include_constants = false);
+
+    // @brief Writes the op specific attributes of a node, such as the axes of a Sum or the
+    //    function called by a FunctionCall, in the canonical form the serializer uses. Two ops
+    //    of the same type with equal attributes compute the same function of their inputs.
+    //    Constant data is not included.
+    // @return false if the op is not known to the serializer, such as a backend fused op
+    bool serialize_attributes(const ngraph::Node& node, std::string& attributes);
 }
@@ -14,20 +14,33 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <future>
 #include <iomanip>
 #include <random>
+#include <thread>
 
 #include "benchmark.hpp"
+#include "ngraph/except.hpp"
 #include "ngraph/file_util.hpp"
 #include "ngraph/graph_util.hpp"
+#include "ngraph/op/broadcast.hpp"
+#include "ngraph/op/constant.hpp"
+#include "ngraph/op/parameter.hpp"
+#include "ngraph/op/reshape.hpp"
 #include "ngraph/runtime/backend.hpp"
 #include "ngraph/runtime/tensor_view.hpp"
-#include "ngraph/runtime/tensor_view.hpp"
+#include "ngraph/runtime/thread_affinity.hpp"
 #include "ngraph/serializer.hpp"
 #include "ngraph/util.hpp"
+#include "nlohmann/json.hpp"
 
 using namespace std;
 using namespace ngraph;
+using json = nlohmann::json;
 
 multimap<size_t, string>
     aggregate_timing_details(const vector<runtime::PerformanceCounter>& perf_data,
@@ -48,9 +61,14 @@ multimap<size_t, string>
     unordered_map<string, size_t> count;
     for (const runtime::PerformanceCounter& p : perf_data)
     {
-        shared_ptr<Node> node = node_map.at(p.name());
+        // Ops that were replaced while compiling are no longer in the function
+        auto node = node_map.find(p.name());
         string op = p.name().substr(0, p.name().find('_'));
-        string shape_name = " {" + join(node->get_outputs()[0].get_shape()) + "} ";
+        string shape_name = " ";
+        if (node != node_map.end())
+        {
+            shape_name = " {" + join(node->second->get_outputs()[0].get_shape()) + "} ";
+        }
         timing[op + shape_name] += p.microseconds();
         count[op + shape_name] += 1;
     }
@@ -115,6 +133,70 @@ void print_times(const multimap<size_t, string>& timing)
     }
 }
 
+// GB/s counts the input and output tensors of every call, so an op that reaches close to
+// the memory bandwidth of the machine is bandwidth bound and one with a high GFLOP/s is
+// compute bound. With hardware counters the bandwidth actually drawn from memory, estimated
+// from the last level cache misses, and the instructions per cycle are shown too.
+static void print_op_rates(const vector<runtime::PerformanceCounter>& perf_data)
+{
+    bool hardware_counts = false;
+    size_t name_width = 4;
+    for (const runtime::PerformanceCounter& p : perf_data)
+    {
+        hardware_counts = hardware_counts || p.has_hardware_counts();
+        name_width = max(name_width, p.name().size());
+    }
+    stringstream ss;
+    ss << setw(name_width + 2) << left << "op" << right << setw(12) << "us/call" << setw(12)
+       << "GFLOP/s" << setw(10) << "GB/s";
+    if (hardware_counts)
+    {
+        ss << setw(8) << "IPC" << setw(14) << "LLC miss/call" << setw(12) << "mem GB/s";
+    }
+    ss << "\n" << fixed;
+    for (const runtime::PerformanceCounter& p : perf_data)
+    {
+        ss << setw(name_width + 2) << left << p.name() << right << setprecision(1) << setw(12)
+           << static_cast<double>(p.total_microseconds()) / p.call_count() << setprecision(2)
+           << setw(12) << p.gflops_per_second() << setw(10) << p.gbytes_per_second();
+        if (p.has_hardware_counts())
+        {
+            ss << setw(8) << p.instructions_per_cycle() << setw(14)
+               << p.hardware_counts().llc_misses / p.call_count() << setw(12)
+               << p.memory_gbytes_per_second();
+        }
+        ss << "\n";
+    }
+    cout << ss.str();
+}
+
+// Parts of a phase, such as the single passes, are indented below it
+static void print_compile_profile(const vector<runtime::CompilePhase>& profile)
+{
+    size_t total = 0;
+    size_t name_width = 5;
+    for (const runtime::CompilePhase& phase : profile)
+    {
+        if (phase.depth == 0)
+        {
+            total += phase.microseconds;
+        }
+        name_width = max(name_width, phase.name.size() + 2 * phase.depth);
+    }
+    stringstream ss;
+    ss << setw(name_width + 2) << left << "phase" << right << setw(12) << "ms" << setw(8)
+       << "%"
+       << "\n"
+       << fixed << setprecision(1);
+    for (const runtime::CompilePhase& phase : profile)
+    {
+        ss << setw(name_width + 2) << left << string(2 * phase.depth, ' ') + phase.name << right
+           << setw(12) << phase.microseconds / 1000.0 << setw(8)
+           << 100.0 * phase.microseconds / max<size_t>(total, 1) << "\n";
+    }
+    cout << ss.str();
+}
+
 static default_random_engine s_random_engine;
 
 template <typename T>
@@ -196,65 +278,485 @@ static void random_init(shared_ptr<runtime::TensorView> tv)
     }
 }
 
-void run_benchmark(shared_ptr<Function> f,
-                   const string& backend_name,
-                   size_t iterations,
-                   bool timing_detail)
+vector<size_t> parse_int_list(const string& list)
+{
+    vector<size_t> values;
+    for (const string& value : split(list, ',', true))
+    {
+        if (!value.empty())
+        {
+            size_t end;
+            values.push_back(stoul(value, &end));
+            if (end != value.size())
+            {
+                throw invalid_argument("invalid integer " + value);
+            }
+        }
+    }
+    return values;
+}
+
+shared_ptr<Function> set_batch_size(shared_ptr<Function> f, size_t batch_size)
+{
+    // The inputs are taken to be the parameters of highest rank; weights and biases
+    // usually have fewer dimensions
+    const op::ParameterVector& parameters = f->get_parameters();
+    size_t input_rank = 0;
+    size_t old_batch_size = 0;
+    for (shared_ptr<op::Parameter> parameter : parameters)
+    {
+        if (parameter->get_shape().size() > input_rank)
+        {
+            input_rank = parameter->get_shape().size();
+            old_batch_size = parameter->get_shape().at(0);
+        }
+    }
+    if (input_rank == 0)
+    {
+        throw ngraph_error("The parameters have no batch dimension");
+    }
+
+    NodeMap node_map;
+    op::ParameterVector new_parameters;
+    for (shared_ptr<op::Parameter> parameter : parameters)
+    {
+        Shape shape = parameter->get_shape();
+        if (shape.size() == input_rank && shape.at(0) == old_batch_size)
+        {
+            shape.at(0) = batch_size;
+        }
+        auto new_parameter = make_shared<op::Parameter>(
+            parameter->get_element_type(), shape, parameter->get_cacheable());
+        node_map.add(parameter, new_parameter);
+        new_parameters.push_back(new_parameter);
+    }
+
+    for (shared_ptr<Node> node : f->get_ordered_ops())
+    {
+        if (node_map.exists(node))
+        {
+            continue;
+        }
+        NodeVector args;
+        for (shared_ptr<Node> arg : node->get_arguments())
+        {
+            args.push_back(node_map.get(arg));
+        }
+        shared_ptr<Node> new_node;
+        if (auto reshape = dynamic_pointer_cast<op::Reshape>(node))
+        {
+            // Only the leading dimension carries the batch
+            Shape shape = reshape->get_output_shape();
+            if (shape_size(args.at(0)->get_shape()) != shape_size(shape))
+            {
+                if (shape.empty() || shape.at(0) != old_batch_size)
+                {
+                    throw ngraph_error("Reshape " + node->get_name() +
+                                       " depends on the batch size");
+                }
+                shape.at(0) = batch_size;
+            }
+            new_node = make_shared<op::Reshape>(args.at(0), reshape->get_input_order(), shape);
+        }
+        else if (auto broadcast = dynamic_pointer_cast<op::Broadcast>(node))
+        {
+            // Dimensions that are not broadcast come from the argument
+            Shape shape = broadcast->get_broadcast_shape();
+            const AxisSet& axes = broadcast->get_broadcast_axes();
+            size_t arg_axis = 0;
+            for (size_t i = 0; i < shape.size(); i++)
+            {
+                if (axes.count(i) == 0)
+                {
+                    shape.at(i) = args.at(0)->get_shape().at(arg_axis++);
+                }
+                else if (i == 0 && shape.at(i) == old_batch_size)
+                {
+                    shape.at(i) = batch_size;
+                }
+            }
+            new_node = make_shared<op::Broadcast>(args.at(0), shape, axes);
+        }
+        else
+        {
+            new_node = node->copy_with_new_args(args);
+        }
+        node_map.add(node, new_node);
+    }
+
+    ResultVector results;
+    for (shared_ptr<op::Result> result : f->get_results())
+    {
+        results.push_back(dynamic_pointer_cast<op::Result>(node_map.get(result)));
+    }
+    return make_shared<Function>(results, new_parameters, f->get_friendly_name());
+}
+
+// Nearest-rank percentile of sorted values
+static double percentile(const vector<double>& sorted, double p)
+{
+    size_t rank = static_cast<size_t>(ceil(p / 100 * sorted.size()));
+    return sorted.at(rank > 0 ? rank - 1 : 0);
+}
+
+// Backends accumulate counters over all calls; removes the calls counted in before
+static vector<runtime::PerformanceCounter>
+    subtract_performance_data(const vector<runtime::PerformanceCounter>& after,
+                              const vector<runtime::PerformanceCounter>& before)
+{
+    unordered_map<string, const runtime::PerformanceCounter*> before_map;
+    for (const runtime::PerformanceCounter& p : before)
+    {
+        before_map[p.name()] = &p;
+    }
+    vector<runtime::PerformanceCounter> rc;
+    for (const runtime::PerformanceCounter& p : after)
+    {
+        size_t microseconds = p.total_microseconds();
+        size_t calls = p.call_count();
+        runtime::HardwareCounts counts = p.hardware_counts();
+        auto it = before_map.find(p.name());
+        if (it != before_map.end())
+        {
+            microseconds -= min(microseconds, it->second->total_microseconds());
+            calls -= min(calls, it->second->call_count());
+            counts = counts - it->second->hardware_counts();
+        }
+        if (calls > 0)
+        {
+            rc.emplace_back(p.name().c_str(), microseconds, calls);
+            rc.back().set_work(p.flops(), p.bytes_read(), p.bytes_written());
+            rc.back().set_replaced_nodes(p.replaced_nodes());
+            if (p.has_hardware_counts())
+            {
+                rc.back().set_hardware_counts(counts);
+            }
+        }
+    }
+    return rc;
+}
+
+// Function and tensors of one concurrent caller
+struct BenchmarkStream
+{
+    shared_ptr<Function> function;
+    vector<shared_ptr<runtime::TensorView>> args;
+    vector<shared_ptr<runtime::TensorView>> results;
+    vector<double> times;
+};
+
+static void create_tensors(runtime::Backend& backend, BenchmarkStream& stream)
+{
+    for (shared_ptr<op::Parameter> param : stream.function->get_parameters())
+    {
+        auto tensor = backend.create_tensor(param->get_element_type(), param->get_shape());
+        random_init(tensor);
+        if (param->get_cacheable())
+        {
+            tensor->set_stale(false);
+        }
+        stream.args.push_back(tensor);
+    }
+    for (shared_ptr<Node> out : stream.function->get_results())
+    {
+        auto result = backend.create_tensor(out->get_element_type(), out->get_shape());
+        stream.results.push_back(result);
+    }
+}
+
+BenchmarkResult run_benchmark(shared_ptr<Function> f,
+                              const string& backend_name,
+                              const BenchmarkOptions& options)
 {
+    runtime::ScopedAffinity affinity(options.cores);
+    if (!affinity.is_applied())
+    {
+        throw runtime_error("unable to pin to cores " + join(options.cores));
+    }
+
+    BenchmarkResult rc;
+    rc.backend = backend_name;
     stopwatch timer;
     timer.start();
     auto backend = runtime::Backend::create(backend_name);
-    backend->enable_performance_data(f, timing_detail);
+    backend->enable_performance_data(f, options.timing_detail);
+    backend->enable_hardware_counters(f, options.timing_detail && options.hardware_counters);
     backend->compile(f);
     timer.stop();
-    cout.imbue(locale(""));
-    cout << "compile time: " << timer.get_milliseconds() << "ms" << endl;
+    rc.compile_time = timer.get_microseconds() / 1000.0;
+    if (options.compile_profile)
+    {
+        rc.compile_profile = backend->get_compile_profile(f);
+    }
 
-    vector<shared_ptr<runtime::TensorView>> args;
-    vector<bool> args_cacheable;
-    for (shared_ptr<op::Parameter> param : f->get_parameters())
+    // Stream 0 calls f itself so that its performance data matches the nodes of f
+    vector<BenchmarkStream> streams(max<size_t>(options.threads, 1));
+    streams[0].function = f;
+    for (size_t i = 1; i < streams.size(); i++)
     {
-        auto tensor = backend->create_tensor(param->get_element_type(), param->get_shape());
-        random_init(tensor);
-        args.push_back(tensor);
-        args_cacheable.push_back(param->get_cacheable());
+        streams[i].function = clone_function(*f);
+        backend->compile(streams[i].function);
     }
-    vector<shared_ptr<runtime::TensorView>> results;
-    for (shared_ptr<Node> out : f->get_results())
+    for (BenchmarkStream& stream : streams)
+    {
+        create_tensors(*backend, stream);
+        for (size_t i = 0; i < options.warmup_iterations; i++)
+        {
+            backend->call(stream.function, stream.results, stream.args);
+        }
+    }
+    rc.threads = streams.size();
+    rc.batch_size = options.batch_size;
+    rc.warmup_iterations = options.warmup_iterations;
+    vector<runtime::PerformanceCounter> warmup_perf_data = backend->get_performance_data(f);
+
+    chrono::steady_clock::time_point start_time;
+    promise<void> start;
+    shared_future<void> started = start.get_future().share();
+    vector<exception_ptr> errors(streams.size());
+    auto done = [&](const vector<double>& times) {
+        if (options.duration > 0)
+        {
+            chrono::duration<double> elapsed = chrono::steady_clock::now() - start_time;
+            return times.size() >= max<size_t>(options.min_iterations, 1) &&
+                   elapsed.count() >= options.duration;
+        }
+        return times.size() >= options.iterations;
+    };
+    auto run_stream = [&](size_t index) {
+        BenchmarkStream& stream = streams[index];
+        started.wait();
+        try
+        {
+            stopwatch call_timer;
+            while (!done(stream.times))
+            {
+                call_timer.start();
+                backend->call(stream.function, stream.results, stream.args);
+                call_timer.stop();
+                stream.times.push_back(call_timer.get_nanoseconds() / 1000000.0);
+            }
+        }
+        catch (...)
+        {
+            errors[index] = current_exception();
+        }
+    };
+    vector<thread> threads;
+    for (size_t i = 1; i < streams.size(); i++)
     {
-        auto result = backend->create_tensor(out->get_element_type(), out->get_shape());
-        results.push_back(result);
+        threads.emplace_back(run_stream, i);
     }
 
-    for (size_t i = 0; i < args.size(); i++)
+    stopwatch total_timer;
+    total_timer.start();
+    start_time = chrono::steady_clock::now();
+    start.set_value();
+    run_stream(0);
+    for (thread& t : threads)
     {
-        if (args_cacheable[i])
+        t.join();
+    }
+    total_timer.stop();
+    for (exception_ptr error : errors)
+    {
+        if (error)
         {
-            args[i]->set_stale(false);
+            rethrow_exception(error);
         }
     }
-    stopwatch t1;
-    t1.start();
-    for (size_t i = 0; i < static_cast<size_t>(iterations); i++)
+
+    vector<double> times;
+    for (const BenchmarkStream& stream : streams)
+    {
+        times.insert(times.end(), stream.times.begin(), stream.times.end());
+    }
+    rc.iterations = times.size();
+    rc.total_time = total_timer.get_microseconds() / 1000.0;
+    if (rc.total_time > 0)
     {
-        backend->call(f, results, args);
+        rc.throughput = rc.iterations * rc.batch_size / (rc.total_time / 1000);
     }
-    t1.stop();
-    float time = t1.get_milliseconds();
-    cout << time / iterations << "ms per iteration" << endl;
 
-    vector<runtime::PerformanceCounter> perf_data = backend->get_performance_data(f);
-    sort(perf_data.begin(),
-         perf_data.end(),
+    if (!times.empty())
+    {
+        double sum = 0;
+        for (double t : times)
+        {
+            sum += t;
+        }
+        rc.mean = sum / times.size();
+        double square_sum = 0;
+        for (double t : times)
+        {
+            square_sum += (t - rc.mean) * (t - rc.mean);
+        }
+        rc.stddev = sqrt(square_sum / times.size());
+        sort(times.begin(), times.end());
+        rc.min = times.front();
+        rc.p50 = percentile(times, 50);
+        rc.p90 = percentile(times, 90);
+        rc.p99 = percentile(times, 99);
+        rc.max = times.back();
+    }
+
+    rc.perf_data = subtract_performance_data(backend->get_performance_data(f), warmup_perf_data);
+    if (options.original_nodes)
+    {
+        rc.perf_data = runtime::attribute_to_replaced_nodes(rc.perf_data);
+    }
+    sort(rc.perf_data.begin(),
+         rc.perf_data.end(),
          [](const runtime::PerformanceCounter& p1, const runtime::PerformanceCounter& p2) {
              return p1.total_microseconds() > p2.total_microseconds();
          });
-    multimap<size_t, string> timing = aggregate_timing(perf_data);
-    multimap<size_t, string> timing_details = aggregate_timing_details(perf_data, f);
+    if (options.memory_stats)
+    {
+        rc.memory_stats = make_shared<runtime::MemoryStats>(backend->get_memory_stats(f));
+    }
+    return rc;
+}
+
+void print_benchmark_result(const BenchmarkResult& result, shared_ptr<Function> f)
+{
+    cout.imbue(locale(""));
+    cout << "compile time: " << static_cast<size_t>(result.compile_time) << "ms" << endl;
+    cout << result.mean << "ms per iteration" << endl;
+    cout << fixed << setprecision(3) << "latency over " << result.iterations
+         << " iterations (" << result.warmup_iterations << " warmup): mean " << result.mean
+         << "ms, stddev " << result.stddev << "ms, min " << result.min << "ms, p50 "
+         << result.p50 << "ms, p90 " << result.p90 << "ms, p99 " << result.p99 << "ms, max "
+         << result.max << "ms" << endl;
+    cout << setprecision(1) << "throughput: " << result.throughput << " inputs/s ("
+         << result.threads << " threads, batch size " << result.batch_size << ")" << endl;
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+
+    if (!result.compile_profile.empty())
+    {
+        cout << "\n---- Compile time per phase ----\n";
+        print_compile_profile(result.compile_profile);
+    }
+
+    if (result.memory_stats)
+    {
+        cout << "\n---- Memory ----\n";
+        result.memory_stats->write_json(cout);
+        cout << endl;
+    }
+
+    if (result.perf_data.empty())
+    {
+        return;
+    }
+    multimap<size_t, string> timing = aggregate_timing(result.perf_data);
+    multimap<size_t, string> timing_details = aggregate_timing_details(result.perf_data, f);
 
     cout << "\n---- Aggregate times per op type ----\n";
     print_times(timing);
 
     cout << "\n---- Aggregate times per op type/shape/count ----\n";
     print_times(timing_details);
+
+    cout << "\n---- Achieved rates per op ----\n";
+    print_op_rates(result.perf_data);
+}
+
+void print_throughput_table(const vector<BenchmarkResult>& results)
+{
+    stringstream ss;
+    ss << setw(8) << "batch" << setw(9) << "threads" << setw(14) << "inputs/s" << setw(12)
+       << "mean(ms)" << setw(12) << "p50(ms)" << setw(12) << "p99(ms)" << "\n";
+    ss << fixed;
+    for (const BenchmarkResult& r : results)
+    {
+        ss << setw(8) << r.batch_size << setw(9) << r.threads << setprecision(1) << setw(14)
+           << r.throughput << setprecision(3) << setw(12) << r.mean << setw(12) << r.p50
+           << setw(12) << r.p99 << "\n";
+    }
+    cout << ss.str();
+}
+
+void write_benchmark_json(ostream& out, const vector<BenchmarkResult>& results)
+{
+    json doc;
+    doc["ngraph_version"] = NGRAPH_VERSION;
+    doc["results"] = json::array();
+    for (const BenchmarkResult& result : results)
+    {
+        json r;
+        r["model"] = result.model;
+        r["backend"] = result.backend;
+        r["compile_ms"] = result.compile_time;
+        r["threads"] = result.threads;
+        r["batch_size"] = result.batch_size;
+        r["throughput"] = result.throughput;
+        r["warmup_iterations"] = result.warmup_iterations;
+        r["iterations"] = result.iterations;
+        r["total_ms"] = result.total_time;
+        r["latency_ms"] = {{"mean", result.mean},
+                           {"stddev", result.stddev},
+                           {"min", result.min},
+                           {"p50", result.p50},
+                           {"p90", result.p90},
+                           {"p99", result.p99},
+                           {"max", result.max}};
+        if (!result.perf_data.empty())
+        {
+            json op_times;
+            for (const pair<size_t, string>& t : aggregate_timing(result.perf_data))
+            {
+                op_times[t.second] = t.first;
+            }
+            r["op_times_us"] = op_times;
+        }
+        if (!result.compile_profile.empty())
+        {
+            json phases = json::array();
+            for (const runtime::CompilePhase& phase : result.compile_profile)
+            {
+                phases.push_back(
+                    {{"name", phase.name}, {"us", phase.microseconds}, {"depth", phase.depth}});
+            }
+            r["compile_profile"] = phases;
+        }
+        if (result.memory_stats)
+        {
+            stringstream ss;
+            result.memory_stats->write_json(ss);
+            r["memory"] = json::parse(ss.str());
+        }
+        doc["results"].push_back(r);
+    }
+    out << doc.dump(4) << endl;
+}
+
+void write_benchmark_csv(ostream& out, const vector<BenchmarkResult>& results)
+{
+    stringstream ss;
+    ss.imbue(locale::classic());
+    ss << "model,backend,compile_ms,threads,batch_size,warmup_iterations,iterations,total_ms,"
+          "throughput,mean_ms,stddev_ms,min_ms,p50_ms,p90_ms,p99_ms,max_ms\n";
+    for (const BenchmarkResult& r : results)
+    {
+        ss << r.model << "," << r.backend << "," << r.compile_time << "," << r.threads << ","
+           << r.batch_size << "," << r.warmup_iterations << "," << r.iterations << ","
+           << r.total_time << "," << r.throughput << "," << r.mean << "," << r.stddev
+           << "," << r.min << "," << r.p50 << "," << r.p90 << "," << r.p99 << "," << r.max
+           << "\n";
+    }
+    out << ss.str();
+}
+
+void run_benchmark(shared_ptr<Function> f,
+                   const string& backend_name,
+                   size_t iterations,
+                   bool timing_detail)
+{
+    BenchmarkOptions options;
+    options.iterations = iterations;
+    // Callers of this overload time the first call
+    options.warmup_iterations = 0;
+    options.timing_detail = timing_detail;
+    print_benchmark_result(run_benchmark(f, backend_name, options), f);
 }
@@ -16,18 +16,111 @@
 
 #pragma once
 
+#include <iostream>
 #include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "ngraph/function.hpp"
+#include "ngraph/runtime/compile_profile.hpp"
+#include "ngraph/runtime/memory_stats.hpp"
 #include "ngraph/runtime/performance_counter.hpp"
 
 /// performance test utilities
 std::multimap<size_t, std::string>
     aggregate_timing(const std::vector<ngraph::runtime::PerformanceCounter>& perf_data);
 
+struct BenchmarkOptions
+{
+    /// Timed calls, unless duration is set
+    size_t iterations = 10;
+    /// Untimed calls before measuring, so that first-call costs such as JIT and MKLDNN
+    /// primitive creation do not show up in the results
+    size_t warmup_iterations = 1;
+    /// When positive, call repeatedly for this many seconds instead of iterations times
+    double duration = 0;
+    /// With a duration, keep calling until each stream made at least this many timed calls
+    size_t min_iterations = 1;
+    bool timing_detail = false;
+    /// Also count cycles, instructions and cache misses per op, with timing_detail
+    bool hardware_counters = false;
+    /// Report the time of fused ops under the ops of the original function they replaced,
+    /// with timing_detail
+    bool original_nodes = false;
+    /// Cores the benchmark and the backend threads it creates are pinned to; empty
+    /// means no pinning
+    std::vector<int> cores;
+    /// Concurrent streams calling the function. Each stream has its own tensors and its
+    /// own compiled copy of the function, so backends give it its own call frame.
+    size_t threads = 1;
+    /// Inputs per call, used to compute the throughput
+    size_t batch_size = 1;
+    /// Collect the memory statistics of the compiled function
+    bool memory_stats = false;
+    /// Collect the time the backend spent in each phase of compiling the function
+    bool compile_profile = false;
+};
+
+/// Latencies are in milliseconds
+struct BenchmarkResult
+{
+    std::string model;
+    std::string backend;
+    double compile_time = 0;
+    size_t threads = 1;
+    size_t batch_size = 1;
+    size_t warmup_iterations = 0;
+    /// Calls of all threads
+    size_t iterations = 0;
+    double total_time = 0;
+    /// Inputs per second over all threads
+    double throughput = 0;
+    double mean = 0;
+    double stddev = 0;
+    double min = 0;
+    double p50 = 0;
+    double p90 = 0;
+    double p99 = 0;
+    double max = 0;
+    /// Per-op counters of the timed calls only
+    std::vector<ngraph::runtime::PerformanceCounter> perf_data;
+    /// Set with BenchmarkOptions::memory_stats
+    std::shared_ptr<ngraph::runtime::MemoryStats> memory_stats;
+    /// Set with BenchmarkOptions::compile_profile
+    std::vector<ngraph::runtime::CompilePhase> compile_profile;
+};
+
+BenchmarkResult run_benchmark(std::shared_ptr<ngraph::Function> f,
+                              const std::string& backend_name,
+                              const BenchmarkOptions& options);
+
+/// \brief Prints the compile time, latency statistics and, when available, the compile
+///        phases, the memory statistics and the times and achieved rates per op
+void print_benchmark_result(const BenchmarkResult& result, std::shared_ptr<ngraph::Function> f);
+
+/// \brief Writes the results as a JSON document for tracking across versions
+void write_benchmark_json(std::ostream& out, const std::vector<BenchmarkResult>& results);
+
+/// \brief Writes the results as CSV with a header line
+void write_benchmark_csv(std::ostream& out, const std::vector<BenchmarkResult>& results);
+
+/// \brief Parses a comma separated list of integers such as "1,8,32"
+std::vector<size_t> parse_int_list(const std::string& list);
+
+/// \brief Rebuilds a function for another batch size.
+///
+/// The parameters of highest rank are taken as the inputs and their leading dimension as
+/// the batch dimension. Other shapes are inferred again, except that the leading
+/// dimension of Reshape and Broadcast shapes is replaced when it is the old batch size.
+/// Constants are kept as they are.
+/// \throws ngraph_error if the function does not accept the new batch size
+std::shared_ptr<ngraph::Function> set_batch_size(std::shared_ptr<ngraph::Function> f,
+                                                 size_t batch_size);
+
+/// \brief Prints throughput and latency of several configurations as a table
+void print_throughput_table(const std::vector<BenchmarkResult>& results);
+
 void run_benchmark(std::shared_ptr<ngraph::Function> f,
                    const std::string& backend_name,
                    size_t iterations,
@@ -23,10 +23,12 @@
 #include <fstream>
 
 #include "benchmark.hpp"
+#include "ngraph/cost_model.hpp"
 #include "ngraph/file_util.hpp"
 #include "ngraph/pass/manager.hpp"
 #include "ngraph/pass/visualize_tree.hpp"
 #include "ngraph/runtime/backend.hpp"
+#include "ngraph/runtime/thread_affinity.hpp"
 #include "ngraph/serializer.hpp"
 #include "ngraph/util.hpp"
 
@@ -40,8 +42,12 @@ int main(int argc, char** argv)
     int iterations = 10;
     bool failed = false;
     bool statistics = false;
-    bool timing_detail = false;
     bool visualize = false;
+    BenchmarkOptions options;
+    string format = "text";
+    string output_file;
+    vector<size_t> thread_counts{1};
+    vector<size_t> batch_sizes;
     for (size_t i = 1; i < argc; i++)
     {
         string arg = argv[i];
@@ -71,7 +77,98 @@ int main(int argc, char** argv)
         }
         else if (arg == "--timing_detail")
         {
-            timing_detail = true;
+            options.timing_detail = true;
+        }
+        else if (arg == "--hw_counters")
+        {
+            options.timing_detail = true;
+            options.hardware_counters = true;
+        }
+        else if (arg == "--original_nodes")
+        {
+            options.timing_detail = true;
+            options.original_nodes = true;
+        }
+        else if (arg == "--compile-profile")
+        {
+            options.compile_profile = true;
+        }
+        else if (arg == "--memory_stats")
+        {
+            options.memory_stats = true;
+        }
+        else if (arg == "-w" || arg == "--warmup")
+        {
+            try
+            {
+                options.warmup_iterations = stoul(argv[++i]);
+            }
+            catch (...)
+            {
+                cout << "Invalid Argument\n";
+                failed = true;
+            }
+        }
+        else if (arg == "-d" || arg == "--duration")
+        {
+            try
+            {
+                options.duration = stod(argv[++i]);
+            }
+            catch (...)
+            {
+                cout << "Invalid Argument\n";
+                failed = true;
+            }
+        }
+        else if (arg == "--cores")
+        {
+            try
+            {
+                options.cores = runtime::parse_cpu_list(argv[++i]);
+            }
+            catch (...)
+            {
+                cout << "Invalid Argument\n";
+                failed = true;
+            }
+        }
+        else if (arg == "-t" || arg == "--threads")
+        {
+            try
+            {
+                thread_counts = parse_int_list(argv[++i]);
+            }
+            catch (...)
+            {
+                cout << "Invalid Argument\n";
+                failed = true;
+            }
+        }
+        else if (arg == "--batch-sweep")
+        {
+            try
+            {
+                batch_sizes = parse_int_list(argv[++i]);
+            }
+            catch (...)
+            {
+                cout << "Invalid Argument\n";
+                failed = true;
+            }
+        }
+        else if (arg == "--format")
+        {
+            format = argv[++i];
+            if (format != "text" && format != "json" && format != "csv")
+            {
+                cout << "Invalid format: " << format << endl;
+                failed = true;
+            }
+        }
+        else if (arg == "-o" || arg == "--output")
+        {
+            output_file = argv[++i];
         }
         else if (arg == "-v" || arg == "--visualize")
         {
@@ -96,7 +193,9 @@ DESCRIPTION
     Benchmark ngraph json model with given backend.
 
 SYNOPSIS
-        nbench [-f <filename>] [-b <backend>] [-i <iterations>]
+        nbench [-f <filename>] [-b <backend>] [-i <iterations> | -d <seconds>] [-w <warmup>]
+               [--cores <list>] [-t <threads>] [--batch-sweep <list>]
+               [--format text|json|csv] [-o <file>]
 
 OPTIONS
         -f|--file          Serialized model file
@@ -104,7 +203,28 @@ OPTIONS
         -i|--iterations    Iterations (default: 10)
         -s|--statistics    Display op stastics
         -v|--visualize     Visualize a model (WARNING: requires GraphViz installed)
-        --timing_detail    Gather detailed timing
+        --timing_detail    Gather detailed timing, with achieved GFLOP/s and GB/s per op
+        --hw_counters      Also count cycles, instructions and last level cache misses per
+                           op with perf_event_open, implies --timing_detail
+        --original_nodes   Split the time of fused ops among the ops of the model they
+                           replaced, in proportion to their estimated work, so that
+                           backends and CPU modes can be compared op by op; implies
+                           --timing_detail
+        --compile-profile  Show the time spent in each phase of compiling the model, such as
+                           every pass and, on CPU, code generation, clang and LLVM
+        --memory_stats     Print the temporary pool, constant, workspace, code and call
+                           frame bytes and the live bytes over the op schedule as JSON
+        -w|--warmup        Untimed iterations before measuring (default: 1)
+        -d|--duration      Measure for this many seconds instead of a number of iterations
+        --cores            Pin to a list of cores, such as 0-3,8
+        -t|--threads       Concurrent streams, each with its own tensors and compiled copy
+                           of the model. A list such as 1,2,4 runs each count (default: 1)
+        --batch-sweep      Rebuild the model for each batch size in a list such as 1,8,32
+                           by changing the leading dimension of the parameters of highest
+                           rank. Throughput counts inputs with this option and calls
+                           without it.
+        --format           Output format: text, json or csv (default: text)
+        -o|--output        Write the json or csv output to a file instead of stdout
 )###";
         return 1;
     }
@@ -152,16 +272,97 @@ OPTIONS
             }
         }
         cout << "Total Constant size: " << total_constant_bytes << " bytes\n";
+        Cost cost = estimate_cost(*f);
+        cout << "Estimated per call: " << cost.flops << " FLOPs, " << cost.bytes_read
+             << " bytes read, " << cost.bytes_written << " bytes written, "
+             << cost.working_set << " bytes working set\n";
         for (const pair<string, size_t>& op_info : op_list)
         {
             cout << op_info.first << ": " << op_info.second << " ops" << endl;
         }
     }
-    else if (iterations > 0)
+    else if (iterations > 0 || options.duration > 0)
     {
-        cout << "Benchmarking " << model << ", " << backend << " backend, " << iterations
-             << " iterations.\n";
-        run_benchmark(f, backend, iterations, timing_detail);
+        options.iterations = iterations;
+        if (format == "text")
+        {
+            cout << "Benchmarking " << model << ", " << backend << " backend, ";
+            if (options.duration > 0)
+            {
+                cout << options.duration << " seconds.\n";
+            }
+            else
+            {
+                cout << iterations << " iterations.\n";
+            }
+        }
+
+        // Without a sweep the model runs as it is; batch size 0 stands for that
+        if (batch_sizes.empty())
+        {
+            batch_sizes.push_back(0);
+        }
+        bool single = batch_sizes.size() == 1 && thread_counts.size() == 1;
+        vector<BenchmarkResult> results;
+        for (size_t batch_size : batch_sizes)
+        {
+            shared_ptr<Function> batch_function = f;
+            if (batch_size > 0)
+            {
+                try
+                {
+                    batch_function = set_batch_size(f, batch_size);
+                }
+                catch (const exception& e)
+                {
+                    cerr << "Skipping batch size " << batch_size << ": " << e.what() << endl;
+                    continue;
+                }
+            }
+            for (size_t threads : thread_counts)
+            {
+                options.threads = threads;
+                options.batch_size = batch_size > 0 ? batch_size : 1;
+                if (format == "text" && !single)
+                {
+                    cout << "batch size " << options.batch_size << ", " << threads
+                         << " threads" << endl;
+                }
+                BenchmarkResult result = run_benchmark(batch_function, backend, options);
+                result.model = model;
+                if (format == "text")
+                {
+                    print_benchmark_result(result, batch_function);
+                }
+                results.push_back(result);
+            }
+        }
+
+        if (format == "text")
+        {
+            if (!single)
+            {
+                cout << "\n---- Throughput and latency ----\n";
+                print_throughput_table(results);
+            }
+        }
+        else
+        {
+            ofstream out_file;
+            if (!output_file.empty())
+            {
+                out_file.open(output_file);
+            }
+            ostream& out = output_file.empty() ? cout : out_file;
+            if (format == "json")
+            {
+                write_benchmark_json(out, results);
+            }
+            else
+            {
+                write_benchmark_csv(out, results);
+            }
+        }
     }
 
     return 0;
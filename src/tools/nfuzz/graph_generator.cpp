@@ -0,0 +1,577 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#include <algorithm>
+#include <numeric>
+#include <unordered_set>
+
+#include "graph_generator.hpp"
+#include "ngraph/log.hpp"
+#include "ngraph/ngraph.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+static shared_ptr<Node> constant(const Shape& shape, float value)
+{
+    return op::Constant::create(element::f32, shape, vector<float>{value});
+}
+
+GraphGenerator::GraphGenerator(unsigned seed, const GraphGeneratorOptions& options)
+    : m_engine(seed)
+    , m_options(options)
+{
+    for (const string& name : get_op_names())
+    {
+        if (m_options.op_names.empty() || m_options.op_names.count(name))
+        {
+            m_op_names.push_back(name);
+        }
+    }
+    if (m_op_names.empty())
+    {
+        throw ngraph_error("No op to generate graphs from");
+    }
+    m_options.max_rank = max<size_t>(m_options.max_rank, 1);
+    m_options.max_dim = max<size_t>(m_options.max_dim, 1);
+    m_options.max_parameters = max<size_t>(m_options.max_parameters, 1);
+}
+
+const map<string, GraphGenerator::Builder>& GraphGenerator::get_builders()
+{
+    static const map<string, Builder> builders{
+        {"Abs", [](GraphGenerator& g) { return g.make_unary("Abs"); }},
+        {"Add", [](GraphGenerator& g) { return g.make_binary("Add"); }},
+        {"AvgPool", [](GraphGenerator& g) { return g.make_pool("AvgPool"); }},
+        {"Broadcast", [](GraphGenerator& g) { return g.make_broadcast(); }},
+        {"Concat", [](GraphGenerator& g) { return g.make_concat(); }},
+        {"Convolution", [](GraphGenerator& g) { return g.make_convolution(); }},
+        {"Cos", [](GraphGenerator& g) { return g.make_unary("Cos"); }},
+        {"Divide", [](GraphGenerator& g) { return g.make_binary("Divide"); }},
+        {"Dot", [](GraphGenerator& g) { return g.make_dot(); }},
+        {"Exp", [](GraphGenerator& g) { return g.make_unary("Exp"); }},
+        {"Log", [](GraphGenerator& g) { return g.make_unary("Log"); }},
+        {"Max", [](GraphGenerator& g) { return g.make_reduction("Max"); }},
+        {"MaxPool", [](GraphGenerator& g) { return g.make_pool("MaxPool"); }},
+        {"Maximum", [](GraphGenerator& g) { return g.make_binary("Maximum"); }},
+        {"Min", [](GraphGenerator& g) { return g.make_reduction("Min"); }},
+        {"Minimum", [](GraphGenerator& g) { return g.make_binary("Minimum"); }},
+        {"Multiply", [](GraphGenerator& g) { return g.make_binary("Multiply"); }},
+        {"Negative", [](GraphGenerator& g) { return g.make_unary("Negative"); }},
+        {"Pad", [](GraphGenerator& g) { return g.make_pad(); }},
+        {"Relu", [](GraphGenerator& g) { return g.make_unary("Relu"); }},
+        {"Reshape", [](GraphGenerator& g) { return g.make_reshape(); }},
+        {"Reverse", [](GraphGenerator& g) { return g.make_reverse(); }},
+        {"Select", [](GraphGenerator& g) { return g.make_select(); }},
+        {"Sigmoid", [](GraphGenerator& g) { return g.make_unary("Sigmoid"); }},
+        {"Sin", [](GraphGenerator& g) { return g.make_unary("Sin"); }},
+        {"Slice", [](GraphGenerator& g) { return g.make_slice(); }},
+        {"Softmax", [](GraphGenerator& g) { return g.make_softmax(); }},
+        {"Sqrt", [](GraphGenerator& g) { return g.make_unary("Sqrt"); }},
+        {"Subtract", [](GraphGenerator& g) { return g.make_binary("Subtract"); }},
+        {"Sum", [](GraphGenerator& g) { return g.make_reduction("Sum"); }},
+        {"Tanh", [](GraphGenerator& g) { return g.make_unary("Tanh"); }},
+    };
+    return builders;
+}
+
+vector<string> GraphGenerator::get_op_names()
+{
+    vector<string> names;
+    for (auto& builder : get_builders())
+    {
+        names.push_back(builder.first);
+    }
+    return names;
+}
+
+shared_ptr<Function> GraphGenerator::generate()
+{
+    m_parameters.clear();
+    m_nodes.clear();
+    create_parameter(random_shape(1, m_options.max_rank));
+
+    const auto& builders = get_builders();
+    size_t added = 0;
+    for (size_t attempt = 0; added < m_options.ops && attempt < m_options.ops * 20; attempt++)
+    {
+        const string& name = m_op_names[random(0, m_op_names.size() - 1)];
+        size_t parameter_count = m_parameters.size();
+        size_t node_count = m_nodes.size();
+        shared_ptr<Node> node;
+        try
+        {
+            node = builders.at(name)(*this);
+        }
+        catch (const ngraph_error& e)
+        {
+            NGRAPH_DEBUG << "Generated invalid " << name << ": " << e.what();
+            m_rejected++;
+        }
+        if (node)
+        {
+            m_nodes.push_back(node);
+            added++;
+        }
+        else
+        {
+            // Drop the parameters added for an op that was not generated
+            m_parameters.resize(parameter_count);
+            m_nodes.resize(node_count);
+        }
+    }
+
+    unordered_set<Node*> used;
+    for (const shared_ptr<Node>& node : m_nodes)
+    {
+        for (const shared_ptr<Node>& arg : node->get_arguments())
+        {
+            used.insert(arg.get());
+        }
+    }
+    NodeVector results;
+    for (const shared_ptr<Node>& node : m_nodes)
+    {
+        if (!node->is_parameter() && used.count(node.get()) == 0)
+        {
+            results.push_back(node);
+        }
+    }
+    if (results.empty())
+    {
+        results.push_back(make_shared<op::Negative>(m_parameters[0]));
+    }
+    return make_shared<Function>(results, m_parameters);
+}
+
+size_t GraphGenerator::random(size_t min, size_t max)
+{
+    return uniform_int_distribution<size_t>(min, max)(m_engine);
+}
+
+bool GraphGenerator::coin()
+{
+    return random(0, 1) == 1;
+}
+
+Shape GraphGenerator::random_shape(size_t min_rank, size_t max_rank)
+{
+    Shape shape(random(min_rank, max_rank));
+    for (size_t& dim : shape)
+    {
+        dim = random(1, m_options.max_dim);
+    }
+    return shape;
+}
+
+AxisSet GraphGenerator::random_axes(size_t rank, bool allow_empty)
+{
+    AxisSet axes;
+    for (size_t axis = 0; axis < rank; axis++)
+    {
+        if (coin())
+        {
+            axes.insert(axis);
+        }
+    }
+    if (axes.empty() && !allow_empty && rank > 0)
+    {
+        axes.insert(random(0, rank - 1));
+    }
+    return axes;
+}
+
+shared_ptr<Node> GraphGenerator::pick(size_t min_rank, size_t max_rank)
+{
+    vector<shared_ptr<Node>> candidates;
+    for (const shared_ptr<Node>& node : m_nodes)
+    {
+        size_t rank = node->get_shape().size();
+        if (rank >= min_rank && rank <= max_rank)
+        {
+            candidates.push_back(node);
+        }
+    }
+    if (candidates.empty())
+    {
+        return nullptr;
+    }
+    size_t last = candidates.size() - 1;
+    return candidates[max(random(0, last), random(0, last))];
+}
+
+shared_ptr<Node> GraphGenerator::pick_or_create(const Shape& shape)
+{
+    vector<shared_ptr<Node>> candidates;
+    for (const shared_ptr<Node>& node : m_nodes)
+    {
+        if (node->get_shape() == shape)
+        {
+            candidates.push_back(node);
+        }
+    }
+    if ((candidates.empty() || coin()) && m_parameters.size() < m_options.max_parameters)
+    {
+        return create_parameter(shape);
+    }
+    if (candidates.empty())
+    {
+        return nullptr;
+    }
+    return candidates[random(0, candidates.size() - 1)];
+}
+
+shared_ptr<Node> GraphGenerator::create_parameter(const Shape& shape)
+{
+    auto parameter = make_shared<op::Parameter>(element::f32, shape);
+    m_parameters.push_back(parameter);
+    m_nodes.push_back(parameter);
+    return parameter;
+}
+
+shared_ptr<Node> GraphGenerator::make_unary(const string& name)
+{
+    shared_ptr<Node> x = pick();
+    if (name == "Abs")
+    {
+        return make_shared<op::Abs>(x);
+    }
+    else if (name == "Cos")
+    {
+        return make_shared<op::Cos>(x);
+    }
+    else if (name == "Exp")
+    {
+        return make_shared<op::Exp>(make_shared<op::Tanh>(x));
+    }
+    else if (name == "Log")
+    {
+        auto one = constant(x->get_shape(), 1);
+        return make_shared<op::Log>(make_shared<op::Add>(make_shared<op::Abs>(x), one));
+    }
+    else if (name == "Negative")
+    {
+        return make_shared<op::Negative>(x);
+    }
+    else if (name == "Relu")
+    {
+        return make_shared<op::Relu>(x);
+    }
+    else if (name == "Sigmoid")
+    {
+        return make_shared<op::Sigmoid>(x);
+    }
+    else if (name == "Sin")
+    {
+        return make_shared<op::Sin>(x);
+    }
+    else if (name == "Sqrt")
+    {
+        return make_shared<op::Sqrt>(make_shared<op::Abs>(x));
+    }
+    else if (name == "Tanh")
+    {
+        return make_shared<op::Tanh>(x);
+    }
+    throw ngraph_error("Unknown unary op " + name);
+}
+
+shared_ptr<Node> GraphGenerator::make_binary(const string& name)
+{
+    shared_ptr<Node> x = pick();
+    shared_ptr<Node> y = pick_or_create(x->get_shape());
+    if (!y)
+    {
+        y = x;
+    }
+    if (name == "Add")
+    {
+        return make_shared<op::Add>(x, y);
+    }
+    else if (name == "Divide")
+    {
+        auto one = constant(y->get_shape(), 1);
+        return make_shared<op::Divide>(x, make_shared<op::Add>(make_shared<op::Abs>(y), one));
+    }
+    else if (name == "Maximum")
+    {
+        return make_shared<op::Maximum>(x, y);
+    }
+    else if (name == "Minimum")
+    {
+        return make_shared<op::Minimum>(x, y);
+    }
+    else if (name == "Multiply")
+    {
+        return make_shared<op::Multiply>(x, y);
+    }
+    else if (name == "Subtract")
+    {
+        return make_shared<op::Subtract>(x, y);
+    }
+    throw ngraph_error("Unknown binary op " + name);
+}
+
+shared_ptr<Node> GraphGenerator::make_select()
+{
+    // Selecting the larger or the smaller value keeps the result continuous, so rounding
+    // differences between backends cannot flip it
+    shared_ptr<Node> x = pick();
+    shared_ptr<Node> y = pick_or_create(x->get_shape());
+    if (!y)
+    {
+        return nullptr;
+    }
+    auto greater = make_shared<op::Greater>(x, y);
+    return coin() ? make_shared<op::Select>(greater, x, y)
+                  : make_shared<op::Select>(greater, y, x);
+}
+
+shared_ptr<Node> GraphGenerator::make_broadcast()
+{
+    shared_ptr<Node> x = pick(0, m_options.max_rank - 1);
+    if (!x)
+    {
+        return nullptr;
+    }
+    const Shape& arg_shape = x->get_shape();
+    size_t rank = random(arg_shape.size() + 1, m_options.max_rank);
+    vector<size_t> positions(rank);
+    iota(positions.begin(), positions.end(), 0);
+    shuffle(positions.begin(), positions.end(), m_engine);
+    AxisSet axes;
+    for (size_t i = 0; i < rank - arg_shape.size(); i++)
+    {
+        axes.insert(positions[i]);
+    }
+
+    Shape shape;
+    auto arg_dim = arg_shape.begin();
+    for (size_t axis = 0; axis < rank; axis++)
+    {
+        shape.push_back(axes.count(axis) ? random(1, m_options.max_dim) : *arg_dim++);
+    }
+    return make_shared<op::Broadcast>(x, shape, axes);
+}
+
+shared_ptr<Node> GraphGenerator::make_reshape()
+{
+    shared_ptr<Node> x = pick(1);
+    if (!x)
+    {
+        return nullptr;
+    }
+    const Shape& arg_shape = x->get_shape();
+    AxisVector order(arg_shape.size());
+    iota(order.begin(), order.end(), 0);
+    shuffle(order.begin(), order.end(), m_engine);
+    Shape shape;
+    for (size_t axis : order)
+    {
+        shape.push_back(arg_shape[axis]);
+    }
+    if (shape.size() > 1 && coin())
+    {
+        size_t axis = random(0, shape.size() - 2);
+        shape[axis] *= shape[axis + 1];
+        shape.erase(shape.begin() + axis + 1);
+    }
+    return make_shared<op::Reshape>(x, order, shape);
+}
+
+shared_ptr<Node> GraphGenerator::make_slice()
+{
+    shared_ptr<Node> x = pick(1);
+    if (!x)
+    {
+        return nullptr;
+    }
+    Coordinate lower;
+    Coordinate upper;
+    Strides strides;
+    for (size_t dim : x->get_shape())
+    {
+        lower.push_back(random(0, dim - 1));
+        upper.push_back(random(lower.back() + 1, dim));
+        strides.push_back(random(1, 2));
+    }
+    return make_shared<op::Slice>(x, lower, upper, strides);
+}
+
+shared_ptr<Node> GraphGenerator::make_concat()
+{
+    shared_ptr<Node> x = pick(1);
+    if (!x)
+    {
+        return nullptr;
+    }
+    size_t axis = random(0, x->get_shape().size() - 1);
+    NodeVector args{x};
+    for (size_t i = random(1, 2); i > 0; i--)
+    {
+        Shape shape = x->get_shape();
+        shape[axis] = random(1, m_options.max_dim);
+        shared_ptr<Node> y = pick_or_create(shape);
+        if (!y)
+        {
+            return nullptr;
+        }
+        args.push_back(y);
+    }
+    return make_shared<op::Concat>(args, axis);
+}
+
+shared_ptr<Node> GraphGenerator::make_reduction(const string& name)
+{
+    shared_ptr<Node> x = pick(1);
+    if (!x)
+    {
+        return nullptr;
+    }
+    AxisSet axes = random_axes(x->get_shape().size(), false);
+    if (name == "Max")
+    {
+        return make_shared<op::Max>(x, axes);
+    }
+    else if (name == "Min")
+    {
+        return make_shared<op::Min>(x, axes);
+    }
+    else if (name == "Sum")
+    {
+        return make_shared<op::Sum>(x, axes);
+    }
+    throw ngraph_error("Unknown reduction op " + name);
+}
+
+shared_ptr<Node> GraphGenerator::make_dot()
+{
+    shared_ptr<Node> x = pick(1, 2);
+    if (!x)
+    {
+        return nullptr;
+    }
+    Shape shape{x->get_shape().back()};
+    if (coin())
+    {
+        shape.push_back(random(1, m_options.max_dim));
+    }
+    shared_ptr<Node> y = pick_or_create(shape);
+    if (!y)
+    {
+        return nullptr;
+    }
+    return make_shared<op::Dot>(x, y);
+}
+
+shared_ptr<Node> GraphGenerator::make_softmax()
+{
+    shared_ptr<Node> x = pick(1);
+    if (!x)
+    {
+        return nullptr;
+    }
+    return make_shared<op::Softmax>(x, random_axes(x->get_shape().size(), false));
+}
+
+shared_ptr<Node> GraphGenerator::make_reverse()
+{
+    shared_ptr<Node> x = pick(1);
+    if (!x)
+    {
+        return nullptr;
+    }
+    return make_shared<op::Reverse>(x, random_axes(x->get_shape().size(), false));
+}
+
+shared_ptr<Node> GraphGenerator::make_pad()
+{
+    shared_ptr<Node> x = pick(1);
+    if (!x)
+    {
+        return nullptr;
+    }
+    Shape below;
+    Shape above;
+    Shape interior;
+    for (size_t i = 0; i < x->get_shape().size(); i++)
+    {
+        below.push_back(random(0, 2));
+        above.push_back(random(0, 2));
+        interior.push_back(random(0, 1));
+    }
+    float value = static_cast<float>(random(0, 4)) / 2 - 1;
+    return make_shared<op::Pad>(x, constant(Shape{}, value), below, above, interior);
+}
+
+shared_ptr<Node> GraphGenerator::make_convolution()
+{
+    // Data batch of shape (N, C, spatial...) with one or two spatial axes
+    shared_ptr<Node> x = pick(3, min<size_t>(4, m_options.max_rank));
+    if (!x)
+    {
+        return nullptr;
+    }
+    const Shape& data_shape = x->get_shape();
+    Shape filters_shape{random(1, m_options.max_dim), data_shape[1]};
+    Strides strides;
+    Strides dilation;
+    CoordinateDiff below;
+    CoordinateDiff above;
+    for (size_t axis = 2; axis < data_shape.size(); axis++)
+    {
+        below.push_back(random(0, 1));
+        above.push_back(random(0, 1));
+        size_t padded = data_shape[axis] + below.back() + above.back();
+        size_t window = random(1, min<size_t>(3, padded));
+        dilation.push_back((window - 1) * 2 + 1 <= padded ? random(1, 2) : 1);
+        filters_shape.push_back(window);
+        strides.push_back(random(1, 2));
+    }
+    shared_ptr<Node> filters = pick_or_create(filters_shape);
+    if (!filters)
+    {
+        return nullptr;
+    }
+    return make_shared<op::Convolution>(x, filters, strides, dilation, below, above);
+}
+
+shared_ptr<Node> GraphGenerator::make_pool(const string& name)
+{
+    shared_ptr<Node> x = pick(3, min<size_t>(4, m_options.max_rank));
+    if (!x)
+    {
+        return nullptr;
+    }
+    const Shape& data_shape = x->get_shape();
+    Shape window;
+    Strides strides;
+    for (size_t axis = 2; axis < data_shape.size(); axis++)
+    {
+        window.push_back(random(1, min<size_t>(3, data_shape[axis])));
+        strides.push_back(random(1, 2));
+    }
+    if (name == "AvgPool")
+    {
+        return make_shared<op::AvgPool>(x, window, strides);
+    }
+    else if (name == "MaxPool")
+    {
+        return make_shared<op::MaxPool>(x, window, strides);
+    }
+    throw ngraph_error("Unknown pooling op " + name);
+}
@@ -0,0 +1,100 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "ngraph/function.hpp"
+#include "ngraph/op/parameter_vector.hpp"
+
+struct GraphGeneratorOptions
+{
+    /// Ops added to each graph, not counting parameters and the helper ops some
+    /// generators add to keep values finite
+    size_t ops = 8;
+    size_t max_rank = 4;
+    size_t max_dim = 6;
+    size_t max_parameters = 4;
+    /// Ops to choose from; empty means all of get_op_names()
+    std::set<std::string> op_names;
+};
+
+/// \brief Builds random f32 graphs from the op set.
+///
+/// Every op is generated from arguments that satisfy the shape rules of its constructor,
+/// taking an existing node of a suitable shape or adding a parameter when there is none.
+/// Ops whose constructor still rejects the arguments are dropped and counted. The results
+/// of the function are the nodes without users. Inputs are expected to lie in [-1, 1];
+/// ops that are not defined everywhere get bounded or positive arguments, so the outputs
+/// stay finite.
+class GraphGenerator
+{
+public:
+    GraphGenerator(unsigned seed, const GraphGeneratorOptions& options);
+
+    std::shared_ptr<ngraph::Function> generate();
+
+    /// \brief Op constructors that threw for the arguments the generator picked, which
+    ///        points at a mismatch between the generator and the type propagation rules
+    size_t get_rejected() const { return m_rejected; }
+    static std::vector<std::string> get_op_names();
+
+private:
+    using Builder = std::function<std::shared_ptr<ngraph::Node>(GraphGenerator&)>;
+    static const std::map<std::string, Builder>& get_builders();
+
+    size_t random(size_t min, size_t max);
+    bool coin();
+    ngraph::Shape random_shape(size_t min_rank, size_t max_rank);
+    ngraph::AxisSet random_axes(size_t rank, bool allow_empty);
+    /// \brief A node of rank in [min_rank, max_rank], favoring recent nodes so that
+    ///        graphs grow deep rather than wide; nullptr if there is none
+    std::shared_ptr<ngraph::Node> pick(size_t min_rank = 0, size_t max_rank = SIZE_MAX);
+    /// \brief A node of exactly this shape, or a new parameter
+    std::shared_ptr<ngraph::Node> pick_or_create(const ngraph::Shape& shape);
+    std::shared_ptr<ngraph::Node> create_parameter(const ngraph::Shape& shape);
+
+    std::shared_ptr<ngraph::Node> make_unary(const std::string& name);
+    std::shared_ptr<ngraph::Node> make_binary(const std::string& name);
+    std::shared_ptr<ngraph::Node> make_select();
+    std::shared_ptr<ngraph::Node> make_broadcast();
+    std::shared_ptr<ngraph::Node> make_reshape();
+    std::shared_ptr<ngraph::Node> make_slice();
+    std::shared_ptr<ngraph::Node> make_concat();
+    std::shared_ptr<ngraph::Node> make_reduction(const std::string& name);
+    std::shared_ptr<ngraph::Node> make_dot();
+    std::shared_ptr<ngraph::Node> make_softmax();
+    std::shared_ptr<ngraph::Node> make_reverse();
+    std::shared_ptr<ngraph::Node> make_pad();
+    std::shared_ptr<ngraph::Node> make_convolution();
+    std::shared_ptr<ngraph::Node> make_pool(const std::string& name);
+
+    std::mt19937 m_engine;
+    GraphGeneratorOptions m_options;
+    std::vector<std::string> m_op_names;
+    ngraph::op::ParameterVector m_parameters;
+    std::vector<std::shared_ptr<ngraph::Node>> m_nodes;
+    size_t m_rejected = 0;
+};
@@ -0,0 +1,500 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+// Differential fuzzer: runs random graphs on a backend and on a reference backend,
+// compares the results and records the speedup of the backend per graph.
+// Reproduce a graph with -s <seed> -n 1, or save failing graphs with --save and run them
+// again with -f. Saved graphs are named nfuzz_<seed>.json and -f takes the seed of their
+// inputs from that name.
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+#include "graph_generator.hpp"
+#include "ngraph/file_util.hpp"
+#include "ngraph/graph_util.hpp"
+#include "ngraph/runtime/backend.hpp"
+#include "ngraph/serializer.hpp"
+#include "ngraph/util.hpp"
+#include "nlohmann/json.hpp"
+#include "util/all_close_f.hpp"
+
+using namespace std;
+using namespace ngraph;
+using json = nlohmann::json;
+
+// The seed in the name of a graph saved with --save, nfuzz_<seed>.json
+static bool get_saved_seed(const string& path, unsigned& seed)
+{
+    const string prefix = "nfuzz_";
+    string name = file_util::get_file_name(path);
+    size_t end = name.find('.');
+    if (name.compare(0, prefix.size(), prefix) != 0 || end == prefix.size())
+    {
+        return false;
+    }
+    string digits = name.substr(prefix.size(), end - prefix.size());
+    if (digits.find_first_not_of("0123456789") != string::npos)
+    {
+        return false;
+    }
+    seed = stoul(digits);
+    return true;
+}
+
+struct FuzzResult
+{
+    unsigned seed = 0;
+    vector<string> ops;
+    /// pass, mismatch, error, or invalid when the reference results are not finite
+    string status;
+    string message;
+    double reference_us = 0;
+    double backend_us = 0;
+    double speedup = 0;
+};
+
+struct BackendRun
+{
+    vector<vector<float>> outputs;
+    /// Mean time of a call, after an untimed first call
+    double call_us = 0;
+};
+
+static BackendRun run_function(runtime::Backend& backend,
+                               shared_ptr<Function> f,
+                               const vector<vector<float>>& inputs,
+                               size_t iterations)
+{
+    // Backends rewrite the functions they compile, so each gets its own copy
+    shared_ptr<Function> clone = clone_function(*f);
+    vector<shared_ptr<runtime::TensorView>> args;
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        auto& parameter = clone->get_parameters()[i];
+        auto tensor = backend.create_tensor(parameter->get_element_type(), parameter->get_shape());
+        tensor->write(inputs[i].data(), 0, inputs[i].size() * sizeof(float));
+        args.push_back(tensor);
+    }
+    vector<shared_ptr<runtime::TensorView>> results;
+    for (size_t i = 0; i < clone->get_output_size(); i++)
+    {
+        results.push_back(
+            backend.create_tensor(clone->get_output_element_type(i), clone->get_output_shape(i)));
+    }
+
+    BackendRun run;
+    backend.compile(clone);
+    backend.call(clone, results, args);
+    for (auto& result : results)
+    {
+        vector<float> values(shape_size(result->get_shape()));
+        result->read(values.data(), 0, values.size() * sizeof(float));
+        run.outputs.push_back(values);
+    }
+    stopwatch timer;
+    for (size_t i = 0; i < iterations; i++)
+    {
+        timer.start();
+        backend.call(clone, results, args);
+        timer.stop();
+    }
+    run.call_us = iterations > 0 ? timer.get_total_nanoseconds() / (1000.0 * iterations) : 0;
+    backend.remove_compiled_function(clone);
+    return run;
+}
+
+static bool all_finite(const vector<vector<float>>& outputs)
+{
+    for (const vector<float>& output : outputs)
+    {
+        for (float value : output)
+        {
+            if (!isfinite(value))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static FuzzResult fuzz(shared_ptr<Function> f,
+                       unsigned seed,
+                       runtime::Backend& reference,
+                       runtime::Backend& backend,
+                       size_t iterations,
+                       int mantissa_bits,
+                       int tolerance_bits)
+{
+    FuzzResult result;
+    result.seed = seed;
+    for (const shared_ptr<Node>& node : f->get_ordered_ops())
+    {
+        if (!node->is_parameter() && !node->is_constant() && !node->is_output())
+        {
+            result.ops.push_back(node->description());
+        }
+    }
+
+    mt19937 engine(seed);
+    uniform_real_distribution<float> distribution(-1, 1);
+    vector<vector<float>> inputs;
+    for (auto& parameter : f->get_parameters())
+    {
+        vector<float> values(shape_size(parameter->get_shape()));
+        for (float& value : values)
+        {
+            value = distribution(engine);
+        }
+        inputs.push_back(values);
+    }
+
+    try
+    {
+        BackendRun expected = run_function(reference, f, inputs, iterations);
+        BackendRun actual = run_function(backend, f, inputs, iterations);
+        result.reference_us = expected.call_us;
+        result.backend_us = actual.call_us;
+        result.speedup = actual.call_us > 0 ? expected.call_us / actual.call_us : 0;
+        if (!all_finite(expected.outputs))
+        {
+            result.status = "invalid";
+            result.message = "reference results are not finite";
+            return result;
+        }
+        result.status = "pass";
+        for (size_t i = 0; i < expected.outputs.size(); i++)
+        {
+            if (!test::all_close_f(
+                    expected.outputs[i], actual.outputs[i], mantissa_bits, tolerance_bits))
+            {
+                result.status = "mismatch";
+                result.message += "output " + to_string(i) + " differs; ";
+            }
+        }
+    }
+    catch (const exception& e)
+    {
+        result.status = "error";
+        result.message = e.what();
+    }
+    return result;
+}
+
+static void write_json(ostream& out,
+                       const vector<FuzzResult>& results,
+                       const string& reference_name,
+                       const string& backend_name)
+{
+    json graphs = json::array();
+    for (const FuzzResult& result : results)
+    {
+        json graph;
+        graph["seed"] = result.seed;
+        graph["ops"] = result.ops;
+        graph["status"] = result.status;
+        graph["message"] = result.message;
+        graph["reference_us"] = result.reference_us;
+        graph["backend_us"] = result.backend_us;
+        graph["speedup"] = result.speedup;
+        graphs.push_back(graph);
+    }
+    json doc;
+    doc["reference"] = reference_name;
+    doc["backend"] = backend_name;
+    doc["graphs"] = graphs;
+    out << setw(4) << doc << endl;
+}
+
+static set<string> split_names(const string& list)
+{
+    set<string> names;
+    stringstream ss(list);
+    string name;
+    while (getline(ss, name, ','))
+    {
+        if (!name.empty())
+        {
+            names.insert(name);
+        }
+    }
+    return names;
+}
+
+int main(int argc, char** argv)
+{
+    string reference_name = "INTERPRETER";
+    string backend_name = "CPU";
+    size_t graph_count = 100;
+    unsigned seed = 0;
+    bool seed_set = false;
+    size_t iterations = 10;
+    int mantissa_bits = 8;
+    int tolerance_bits = 2;
+    string model;
+    string save_dir;
+    string format = "text";
+    string output_file;
+    GraphGeneratorOptions options;
+    bool list = false;
+    bool failed = false;
+    for (size_t i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        try
+        {
+            if (arg == "-r" || arg == "--reference")
+            {
+                reference_name = argv[++i];
+            }
+            else if (arg == "-b" || arg == "--backend")
+            {
+                backend_name = argv[++i];
+            }
+            else if (arg == "-n" || arg == "--graphs")
+            {
+                graph_count = stoul(argv[++i]);
+            }
+            else if (arg == "-s" || arg == "--seed")
+            {
+                seed = stoul(argv[++i]);
+                seed_set = true;
+            }
+            else if (arg == "--ops")
+            {
+                options.ops = stoul(argv[++i]);
+            }
+            else if (arg == "--op_set")
+            {
+                options.op_names = split_names(argv[++i]);
+            }
+            else if (arg == "--max_rank")
+            {
+                options.max_rank = stoul(argv[++i]);
+            }
+            else if (arg == "--max_dim")
+            {
+                options.max_dim = stoul(argv[++i]);
+            }
+            else if (arg == "--max_parameters")
+            {
+                options.max_parameters = stoul(argv[++i]);
+            }
+            else if (arg == "-i" || arg == "--iterations")
+            {
+                iterations = stoul(argv[++i]);
+            }
+            else if (arg == "--mantissa_bits")
+            {
+                mantissa_bits = stoi(argv[++i]);
+            }
+            else if (arg == "--tolerance_bits")
+            {
+                tolerance_bits = stoi(argv[++i]);
+            }
+            else if (arg == "-f" || arg == "--file")
+            {
+                model = argv[++i];
+            }
+            else if (arg == "--save")
+            {
+                save_dir = argv[++i];
+            }
+            else if (arg == "--format")
+            {
+                format = argv[++i];
+                if (format != "text" && format != "json")
+                {
+                    cout << "Invalid format: " << format << endl;
+                    failed = true;
+                }
+            }
+            else if (arg == "-o" || arg == "--output")
+            {
+                output_file = argv[++i];
+            }
+            else if (arg == "-l" || arg == "--list")
+            {
+                list = true;
+            }
+            else
+            {
+                cout << "Unknown option: " << arg << endl;
+                failed = true;
+            }
+        }
+        catch (...)
+        {
+            cout << "Invalid Argument\n";
+            failed = true;
+        }
+    }
+    for (const string& name : options.op_names)
+    {
+        auto names = GraphGenerator::get_op_names();
+        if (find(names.begin(), names.end(), name) == names.end())
+        {
+            cout << "Unknown op: " << name << endl;
+            failed = true;
+        }
+    }
+    if (!model.empty() && !static_cast<bool>(ifstream(model)))
+    {
+        cout << "File " << model << " not found\n";
+        failed = true;
+    }
+    if (!model.empty() && !seed_set)
+    {
+        get_saved_seed(model, seed);
+    }
+
+    if (failed)
+    {
+        cout << R"###(
+DESCRIPTION
+    Run random graphs on a backend and on a reference backend, compare the results with
+    all_close_f and record the speedup of the backend over the reference per graph.
+
+SYNOPSIS
+        nfuzz [-b <backend>] [-r <reference>] [-n <graphs>] [-s <seed>] [--ops <count>]
+              [--op_set <list>] [-f <filename>] [--save <dir>] [--format text|json]
+              [-o <file>]
+
+OPTIONS
+        -b|--backend       Backend to test (default: CPU)
+        -r|--reference     Backend whose results are taken as correct (default: INTERPRETER)
+        -n|--graphs        Graphs to generate (default: 100)
+        -s|--seed          Seed of the first graph; graph i uses seed + i, so a graph is
+                           generated again with its seed and -n 1 (default: 0). The
+                           seed also generates the inputs of a graph
+        --ops              Ops per graph (default: 8)
+        --op_set           Generate only these ops, such as Add,Dot,Reshape
+        --max_rank         Largest tensor rank (default: 4)
+        --max_dim          Largest dimension of a generated shape (default: 6)
+        --max_parameters   Most parameters per graph (default: 4)
+        -i|--iterations    Timed calls on each backend per graph (default: 10)
+        --mantissa_bits    Mantissa bits compared by all_close_f (default: 8)
+        --tolerance_bits   Tolerated ULPs, as a power of two, of all_close_f (default: 2)
+        -f|--file          Run a serialized graph, such as one saved with --save, instead of
+                           generating graphs. Its inputs are generated with -s, or with
+                           the seed in the name of a saved nfuzz_<seed>.json
+        --save             Serialize the graphs that mismatch or fail into this directory
+                           as nfuzz_<seed>.json
+        --format           Output format: text or json (default: text)
+        -o|--output        Write the json output to a file instead of stdout
+        -l|--list          List the ops graphs are generated from
+)###";
+        return 1;
+    }
+
+    if (list)
+    {
+        for (const string& name : GraphGenerator::get_op_names())
+        {
+            cout << name << endl;
+        }
+        return 0;
+    }
+
+    auto reference = runtime::Backend::create(reference_name);
+    auto backend = runtime::Backend::create(backend_name);
+    vector<FuzzResult> results;
+    size_t failures = 0;
+    size_t rejected = 0;
+    size_t graphs = model.empty() ? graph_count : 1;
+    for (size_t i = 0; i < graphs; i++)
+    {
+        unsigned graph_seed = seed + i;
+        shared_ptr<Function> f;
+        if (model.empty())
+        {
+            GraphGenerator generator(graph_seed, options);
+            f = generator.generate();
+            rejected += generator.get_rejected();
+        }
+        else
+        {
+            f = deserialize(model);
+        }
+        FuzzResult result = fuzz(
+            f, graph_seed, *reference, *backend, iterations, mantissa_bits, tolerance_bits);
+        if (result.status == "mismatch" || result.status == "error")
+        {
+            failures++;
+            if (!save_dir.empty())
+            {
+                string path = file_util::path_join(
+                    save_dir, "nfuzz_" + to_string(graph_seed) + ".json");
+                ofstream out(path);
+                out << serialize(f, 0, true);
+                result.message += "saved to " + path;
+            }
+        }
+        if (format == "text")
+        {
+            cout << "seed " << setw(6) << graph_seed << " " << setw(8) << result.status << " "
+                 << setw(3) << result.ops.size() << " ops " << fixed << setprecision(1)
+                 << setw(10) << result.reference_us << "us " << setw(10) << result.backend_us
+                 << "us " << setprecision(2) << setw(8) << result.speedup << "x "
+                 << result.message << endl;
+            cout.unsetf(ios::floatfield);
+        }
+        results.push_back(result);
+    }
+
+    // The geometric mean does not let a few tiny graphs dominate the summary
+    double log_speedup = 0;
+    size_t timed = 0;
+    size_t passed = 0;
+    for (const FuzzResult& result : results)
+    {
+        if (result.status == "pass")
+        {
+            passed++;
+            if (result.speedup > 0)
+            {
+                log_speedup += log(result.speedup);
+                timed++;
+            }
+        }
+    }
+    if (format == "json")
+    {
+        if (output_file.empty())
+        {
+            write_json(cout, results, reference_name, backend_name);
+        }
+        else
+        {
+            ofstream out(output_file);
+            write_json(out, results, reference_name, backend_name);
+        }
+    }
+    else
+    {
+        cout << results.size() << " graphs, " << passed << " passed, " << failures
+             << " failed, " << rejected << " ops rejected by type checks\n";
+        if (timed > 0)
+        {
+            cout << "Geometric mean speedup of " << backend_name << " over " << reference_name
+                 << ": " << exp(log_speedup / timed) << "x\n";
+        }
+    }
+    return failures > 0 ? 1 : 0;
+}
@@ -522,3 +522,112 @@ TEST(algebraic_simplification, log_no_divide)
     pass_manager.run_passes(f);
     ASSERT_EQ(neg_inner->get_argument(0), log_mul);
 }
+
+TEST(algebraic_simplification, sum_broadcast)
+{
+    auto x = make_shared<op::Parameter>(element::f32, Shape{3});
+    auto broadcast = make_shared<op::Broadcast>(x, Shape{2, 3, 4}, AxisSet{0, 2});
+    auto sum = make_shared<op::Sum>(broadcast, AxisSet{0});
+    auto f = make_shared<Function>(sum, op::ParameterVector{x});
+    auto original = clone_function(*f);
+
+    pass::AlgebraicSimplification simplification;
+    ASSERT_TRUE(simplification.run_on_function(f));
+    ASSERT_EQ(count_ops_of_type<op::Sum>(f), 0);
+    EXPECT_EQ(simplification.get_rule_hits().at("sum_broadcast"), 1);
+
+    vector<vector<float>> args{{1, 2, 3}};
+    EXPECT_EQ(execute(original, args, "INTERPRETER"), execute(f, args, "INTERPRETER"));
+}
+
+TEST(algebraic_simplification, broadcast_broadcast)
+{
+    auto x = make_shared<op::Parameter>(element::f32, Shape{3});
+    auto inner = make_shared<op::Broadcast>(x, Shape{3, 4}, AxisSet{1});
+    auto outer = make_shared<op::Broadcast>(inner, Shape{2, 3, 4}, AxisSet{0});
+    auto f = make_shared<Function>(outer, op::ParameterVector{x});
+    auto original = clone_function(*f);
+
+    pass::AlgebraicSimplification simplification;
+    simplification.run_on_function(f);
+    auto broadcast =
+        dynamic_pointer_cast<op::Broadcast>(f->get_results().at(0)->get_argument(0));
+    ASSERT_TRUE(broadcast);
+    EXPECT_EQ(broadcast->get_argument(0), x);
+    EXPECT_EQ(broadcast->get_broadcast_axes(), (AxisSet{0, 2}));
+
+    vector<vector<float>> args{{1, 2, 3}};
+    EXPECT_EQ(execute(original, args, "INTERPRETER"), execute(f, args, "INTERPRETER"));
+}
+
+TEST(algebraic_simplification, divide_constant)
+{
+    Shape shape{2, 2};
+    auto x = make_shared<op::Parameter>(element::f32, shape);
+    auto four = op::Constant::create(element::f32, Shape{}, {4});
+    auto div = x / make_shared<op::Broadcast>(four, shape, AxisSet{0, 1});
+    auto f = make_shared<Function>(div, op::ParameterVector{x});
+    auto original = clone_function(*f);
+
+    pass::AlgebraicSimplification simplification(true);
+    simplification.run_on_function(f);
+    ASSERT_EQ(count_ops_of_type<op::Divide>(f), 0);
+    ASSERT_EQ(count_ops_of_type<op::Multiply>(f), 1);
+
+    vector<vector<float>> args{{1, 2, 3, 4}};
+    EXPECT_EQ(execute(original, args, "INTERPRETER"), execute(f, args, "INTERPRETER"));
+}
+
+TEST(algebraic_simplification, fixed_point)
+{
+    Shape shape{2, 2};
+    auto x = make_shared<op::Parameter>(element::f32, shape);
+    auto two = op::Constant::create(element::f32, Shape{}, {2});
+    auto one = op::Constant::create(element::f32, Shape{}, {1});
+    auto square = make_shared<op::Power>(x, make_shared<op::Broadcast>(two, shape, AxisSet{0, 1}));
+    auto neg = make_shared<op::Negative>(make_shared<op::Negative>(square));
+    auto div = neg / make_shared<op::Broadcast>(one, shape, AxisSet{0, 1});
+    auto exp = make_shared<op::Exp>(make_shared<op::Log>(div));
+    auto f = make_shared<Function>(exp, op::ParameterVector{x});
+
+    pass::AlgebraicSimplification simplification(true);
+    simplification.run_on_function(f);
+
+    // x / 1 became x * 1, which the next sweep removed
+    auto result = f->get_results().at(0)->get_argument(0);
+    ASSERT_TRUE(dynamic_pointer_cast<op::Multiply>(result));
+    EXPECT_EQ(result->get_argument(0), x);
+    EXPECT_EQ(result->get_argument(1), x);
+    EXPECT_EQ((map<string, size_t>{{"divide_constant", 1},
+                                   {"exp_log", 1},
+                                   {"multiply_zero_or_one", 1},
+                                   {"negative_negative", 1},
+                                   {"power_constant", 1}}),
+              simplification.get_rule_hits());
+}
+
+TEST(algebraic_simplification, fast_math_off_by_default)
+{
+    Shape shape{2, 2};
+    auto x = make_shared<op::Parameter>(element::f32, shape);
+    auto three = op::Constant::create(element::f32, Shape{}, {3});
+    auto div = x / make_shared<op::Broadcast>(three, shape, AxisSet{0, 1});
+    auto exp_log = make_shared<op::Exp>(make_shared<op::Log>(div));
+    auto log_exp = make_shared<op::Log>(make_shared<op::Exp>(exp_log));
+    auto f = make_shared<Function>(log_exp, op::ParameterVector{x});
+
+    pass::AlgebraicSimplification simplification;
+    EXPECT_FALSE(simplification.run_on_function(f));
+    EXPECT_TRUE(simplification.get_rule_hits().empty());
+    EXPECT_EQ(count_ops_of_type<op::Divide>(f), 1);
+    EXPECT_EQ(count_ops_of_type<op::Exp>(f), 2);
+    EXPECT_EQ(count_ops_of_type<op::Log>(f), 2);
+
+    pass::AlgebraicSimplification fast_math(true);
+    EXPECT_TRUE(fast_math.run_on_function(f));
+    EXPECT_EQ((map<string, size_t>{{"divide_constant", 1}, {"exp_log", 1}, {"log_exp", 1}}),
+              fast_math.get_rule_hits());
+    EXPECT_EQ(count_ops_of_type<op::Divide>(f), 0);
+    EXPECT_EQ(count_ops_of_type<op::Exp>(f), 0);
+    EXPECT_EQ(count_ops_of_type<op::Log>(f), 0);
+}
@@ -34,3 +34,110 @@ TEST(backend_api, invalid_name)
 {
     ASSERT_ANY_THROW(ngraph::runtime::Backend::create("COMPLETELY-BOGUS-NAME"));
 }
+
+TEST(backend_api, unsupported_config)
+{
+    auto backend = runtime::Backend::create("INTERPRETER");
+    EXPECT_NO_THROW(backend->set_config({}));
+    EXPECT_THROW(backend->set_config({{"COMPLETELY-BOGUS-OPTION", "1"}}), ngraph_error);
+}
+
+TEST(backend_api, performance_data_work)
+{
+    Shape shape_a{2, 3};
+    Shape shape_b{3, 4};
+    auto A = make_shared<op::Parameter>(element::f32, shape_a);
+    auto B = make_shared<op::Parameter>(element::f32, shape_b);
+    auto dot = make_shared<op::Dot>(A, B);
+    auto f = make_shared<Function>(make_shared<op::Negative>(dot), op::ParameterVector{A, B});
+
+    auto backend = runtime::Backend::create("INTERPRETER");
+    backend->enable_performance_data(f, true);
+    backend->enable_hardware_counters(f, true);
+    auto a = backend->create_tensor(element::f32, shape_a);
+    auto b = backend->create_tensor(element::f32, shape_b);
+    auto result = backend->create_tensor(element::f32, Shape{2, 4});
+    backend->call(f, {result}, {a, b});
+    backend->call(f, {result}, {a, b});
+
+    bool found_dot = false;
+    for (const runtime::PerformanceCounter& p : backend->get_performance_data(f))
+    {
+        EXPECT_EQ(p.call_count(), 2);
+        if (p.name() == dot->get_name())
+        {
+            found_dot = true;
+            EXPECT_EQ(p.flops(), 2 * 8 * 3);
+            EXPECT_EQ(p.bytes_read(), (6 + 12) * sizeof(float));
+            EXPECT_EQ(p.bytes_written(), 8 * sizeof(float));
+        }
+        else if (p.name().find("Negative") == 0)
+        {
+            EXPECT_EQ(p.flops(), 8);
+        }
+        // Counters are not available on every system
+        if (p.has_hardware_counts())
+        {
+            EXPECT_GT(p.hardware_counts().instructions, 0);
+        }
+    }
+    EXPECT_TRUE(found_dot);
+}
+
+TEST(backend_api, memory_stats)
+{
+    Shape shape_a{2, 3};
+    Shape shape_b{3, 4};
+    Shape shape_r{2, 4};
+    auto A = make_shared<op::Parameter>(element::f32, shape_a);
+    auto B = make_shared<op::Parameter>(element::f32, shape_b);
+    auto C = op::Constant::create(element::f32, shape_r, vector<float>(8, 1));
+    auto sum = make_shared<op::Dot>(A, B) + C;
+    auto f = make_shared<Function>(make_shared<op::Negative>(sum), op::ParameterVector{A, B});
+
+    auto backend = runtime::Backend::create("INTERPRETER");
+    backend->compile(f);
+    runtime::MemoryStats stats = backend->get_memory_stats(f);
+    EXPECT_EQ(stats.constant_bytes, 8 * sizeof(float));
+    // The Dot and the Add results are both live while the Add runs
+    EXPECT_EQ(stats.peak_live_bytes, 2 * 8 * sizeof(float));
+    EXPECT_EQ(stats.live_bytes.size(), f->get_ordered_ops().size());
+    EXPECT_EQ(stats.live_bytes.front().second, 0);
+
+    auto a = backend->create_tensor(element::f32, shape_a);
+    auto b = backend->create_tensor(element::f32, shape_b);
+    auto result = backend->create_tensor(element::f32, shape_r);
+    backend->call(f, {result}, {a, b});
+    // The interpreter also allocates the constant on every call
+    EXPECT_EQ(backend->get_memory_stats(f).peak_live_bytes, 3 * 8 * sizeof(float));
+
+    stringstream ss;
+    stats.write_json(ss);
+    EXPECT_NE(ss.str().find("\"peak_live_bytes\": 64"), string::npos);
+}
+
+TEST(backend_api, compile_profile)
+{
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>(A + B, op::ParameterVector{A, B});
+
+    auto backend = runtime::Backend::create("INTERPRETER");
+    EXPECT_TRUE(backend->get_compile_profile(f).empty());
+    backend->compile(f);
+    vector<runtime::CompilePhase> profile = backend->get_compile_profile(f);
+    ASSERT_FALSE(profile.empty());
+    EXPECT_EQ(profile[0].name, "passes");
+    EXPECT_EQ(profile[0].depth, 0);
+    size_t pass_time = 0;
+    bool found_liveness = false;
+    for (size_t i = 1; i < profile.size(); i++)
+    {
+        EXPECT_EQ(profile[i].depth, 1);
+        pass_time += profile[i].microseconds;
+        found_liveness = found_liveness || profile[i].name == "ngraph::pass::Liveness";
+    }
+    EXPECT_EQ(profile[0].microseconds, pass_time);
+    EXPECT_TRUE(found_liveness);
+}
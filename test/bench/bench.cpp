@@ -0,0 +1,60 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#include <algorithm>
+#include <sstream>
+
+#include "bench.hpp"
+#include "ngraph/file_util.hpp"
+#include "ngraph/serializer.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+vector<BenchmarkCase>& get_benchmark_cases()
+{
+    static vector<BenchmarkCase> s_cases;
+    return s_cases;
+}
+
+bool register_benchmark(const string& name, function<shared_ptr<Function>()> make_function)
+{
+    get_benchmark_cases().push_back({name, make_function});
+    return true;
+}
+
+void register_model_benchmarks(const string& directory)
+{
+    vector<string> models;
+    file_util::iterate_files(directory,
+                             [&](const string& file, bool is_dir) {
+                                 if (!is_dir && file_util::get_file_ext(file) == ".json")
+                                 {
+                                     models.push_back(file);
+                                 }
+                             },
+                             true);
+    sort(models.begin(), models.end());
+    for (const string& model : models)
+    {
+        string name = "model" + model.substr(directory.size());
+        register_benchmark(name, [model]() {
+            stringstream ss(file_util::read_file_to_string(model));
+            return deserialize(ss);
+        });
+    }
+}
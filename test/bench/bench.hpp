@@ -0,0 +1,47 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ngraph/function.hpp"
+
+/// \brief A graph to benchmark on every backend
+struct BenchmarkCase
+{
+    /// Op/type/shape for op benchmarks and model/<path> for models, as in Google Benchmark
+    std::string name;
+    /// Builds a fresh function for each backend
+    std::function<std::shared_ptr<ngraph::Function>()> make_function;
+};
+
+/// \brief All registered cases, in registration order
+std::vector<BenchmarkCase>& get_benchmark_cases();
+
+/// \brief Registers a case, usually from a static initializer
+bool register_benchmark(const std::string& name,
+                        std::function<std::shared_ptr<ngraph::Function>()> make_function);
+
+/// \brief Registers the op microbenchmarks across shapes and element types
+void register_op_benchmarks();
+
+/// \brief Registers every serialized model under a directory, recursively
+void register_model_benchmarks(const std::string& directory);
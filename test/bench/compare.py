@@ -0,0 +1,110 @@
+#!/usr/bin/env python
+# ******************************************************************************
+# Copyright 2017-2018 Intel Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ******************************************************************************
+
+"""Compares two ngraph-bench JSON reports and flags regressions.
+
+A case regresses when its median latency grows by more than the noise threshold. The
+threshold is the larger of --threshold and --noise times the spread of the two runs
+together. The spread of a run is the gap from its median to its 90th percentile, relative
+to the median, which outliers such as a preempted call do not inflate the way they do the
+standard deviation. Cases with fewer timed calls than --min_iterations in either run have
+no meaningful spread and are skipped. Exits with 1 if any case regressed.
+
+    compare.py baseline.json new.json [--threshold 0.05] [--noise 1] [--min_iterations 10]
+"""
+
+import argparse
+import json
+import os
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        report = json.load(f)
+    cases = {}
+    for b in report['benchmarks']:
+        if 'error' not in b:
+            cases[(b['name'], b['backend'])] = b
+    return report.get('context', {}), cases
+
+
+def relative_spread(b):
+    return (b['p90_ms'] - b['p50_ms']) / b['p50_ms'] if b['p50_ms'] > 0 else 0.0
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compare ngraph-bench reports')
+    parser.add_argument('baseline')
+    parser.add_argument('current')
+    parser.add_argument('--threshold', type=float, default=0.05,
+                        help='smallest relative slowdown reported (default: 0.05)')
+    parser.add_argument('--noise', type=float, default=1.0,
+                        help='relative spreads a slowdown must exceed (default: 1)')
+    parser.add_argument('--min_iterations', type=int, default=10,
+                        help='fewest timed calls a compared case needs (default: 10)')
+    args = parser.parse_args()
+
+    if not os.path.exists(args.baseline):
+        print('no baseline at {}; record one on this machine first, for example with the '
+              'bench-baseline target'.format(args.baseline))
+        return 2
+    baseline_context, baseline = load(args.baseline)
+    current_context, current = load(args.current)
+    if baseline_context.get('host_name') != current_context.get('host_name'):
+        print('warning: the baseline was recorded on {}, not {}'.format(
+            baseline_context.get('host_name'), current_context.get('host_name')))
+
+    regressions = 0
+    skipped = 0
+    rows = []
+    for key in sorted(set(baseline) & set(current)):
+        b = baseline[key]
+        c = current[key]
+        if min(b['iterations'], c['iterations']) < args.min_iterations:
+            skipped += 1
+            continue
+        change = c['p50_ms'] / b['p50_ms'] - 1 if b['p50_ms'] > 0 else 0.0
+        allowed = max(args.threshold,
+                      args.noise * (relative_spread(b) + relative_spread(c)))
+        status = ''
+        if change > allowed:
+            status = 'REGRESSION'
+            regressions += 1
+        elif change < -allowed:
+            status = 'improvement'
+        rows.append(('{}/{}'.format(*key), b['p50_ms'], c['p50_ms'], change, allowed, status))
+
+    width = max([len(r[0]) for r in rows] + [9])
+    print('{:<{w}} {:>12} {:>12} {:>9} {:>9}'.format(
+        'Benchmark', 'base(ms)', 'new(ms)', 'change', 'noise', w=width))
+    for name, base, new, change, allowed, status in rows:
+        print('{:<{w}} {:>12.4f} {:>12.4f} {:>+8.1f}% {:>8.1f}% {}'.format(
+            name, base, new, 100 * change, 100 * allowed, status, w=width))
+
+    missing = len(set(baseline) - set(current))
+    if missing:
+        print('{} cases of the baseline are not in the new run'.format(missing))
+    if skipped:
+        print('{} cases with fewer than {} iterations were skipped'.format(
+            skipped, args.min_iterations))
+    print('{} of {} cases regressed'.format(regressions, len(rows)))
+    return 1 if regressions else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,300 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+// Runs op microbenchmarks and the bundled models on each backend and reports the latency of
+// every case, in the spirit of Google Benchmark. Compare a new JSON report with any earlier
+// one, such as the bench-baseline output, by passing both to compare.py.
+
+#include <fstream>
+#include <iomanip>
+#include <regex>
+#include <thread>
+#include <unistd.h>
+
+#include "bench.hpp"
+#include "benchmark.hpp"
+#include "ngraph/runtime/backend.hpp"
+#include "ngraph/util.hpp"
+#include "nlohmann/json.hpp"
+
+using namespace std;
+using namespace ngraph;
+using json = nlohmann::json;
+
+struct CaseResult
+{
+    string name;
+    string backend;
+    string error;
+    BenchmarkResult result;
+};
+
+static string get_host_name()
+{
+    char name[256] = {0};
+    gethostname(name, sizeof(name) - 1);
+    return name;
+}
+
+static void write_json(ostream& out,
+                       const vector<CaseResult>& results,
+                       double min_time,
+                       size_t min_iterations)
+{
+    json doc;
+    doc["context"] = {{"ngraph_version", NGRAPH_VERSION},
+                      {"host_name", get_host_name()},
+                      {"num_cpus", thread::hardware_concurrency()},
+                      {"min_time", min_time},
+                      {"min_iterations", min_iterations}};
+    doc["benchmarks"] = json::array();
+    for (const CaseResult& r : results)
+    {
+        json b{{"name", r.name}, {"backend", r.backend}};
+        if (!r.error.empty())
+        {
+            b["error"] = r.error;
+        }
+        else
+        {
+            b["iterations"] = r.result.iterations;
+            b["compile_ms"] = r.result.compile_time;
+            b["mean_ms"] = r.result.mean;
+            b["stddev_ms"] = r.result.stddev;
+            b["min_ms"] = r.result.min;
+            b["p50_ms"] = r.result.p50;
+            b["p90_ms"] = r.result.p90;
+        }
+        doc["benchmarks"].push_back(b);
+    }
+    out << doc.dump(4) << endl;
+}
+
+static void print_row(const string& name, size_t name_width, const CaseResult& r)
+{
+    stringstream ss;
+    ss << setw(name_width + 2) << left << name << right;
+    if (!r.error.empty())
+    {
+        ss << "ERROR: " << r.error;
+    }
+    else
+    {
+        ss << fixed << setprecision(4) << setw(12) << r.result.mean << setw(12)
+           << r.result.p50 << setw(12) << r.result.stddev << setw(12) << r.result.iterations;
+    }
+    cout << ss.str() << endl;
+}
+
+int main(int argc, char** argv)
+{
+    vector<string> backends;
+    string filter = ".*";
+    double min_time = 0.5;
+    size_t min_iterations = 1;
+    bool run_ops = true;
+    bool run_models = true;
+    string models = SERIALIZED_ZOO;
+    bool list = false;
+    string format = "text";
+    string output_file;
+    bool failed = false;
+    for (size_t i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if ((arg == "-b" || arg == "--backend") && i + 1 < argc)
+        {
+            backends.push_back(argv[++i]);
+        }
+        else if (arg == "--filter" && i + 1 < argc)
+        {
+            filter = argv[++i];
+        }
+        else if (arg == "--min_time" && i + 1 < argc)
+        {
+            try
+            {
+                min_time = stod(argv[++i]);
+            }
+            catch (...)
+            {
+                cout << "Invalid Argument\n";
+                failed = true;
+            }
+        }
+        else if (arg == "--min_iterations" && i + 1 < argc)
+        {
+            try
+            {
+                min_iterations = stoul(argv[++i]);
+            }
+            catch (...)
+            {
+                cout << "Invalid Argument\n";
+                failed = true;
+            }
+        }
+        else if (arg == "--models" && i + 1 < argc)
+        {
+            models = argv[++i];
+        }
+        else if (arg == "--no_models")
+        {
+            run_models = false;
+        }
+        else if (arg == "--no_ops")
+        {
+            run_ops = false;
+        }
+        else if (arg == "--list")
+        {
+            list = true;
+        }
+        else if (arg == "--format" && i + 1 < argc)
+        {
+            format = argv[++i];
+            if (format != "text" && format != "json")
+            {
+                cout << "Unknown format " << format << "\n";
+                failed = true;
+            }
+        }
+        else if ((arg == "-o" || arg == "--output") && i + 1 < argc)
+        {
+            output_file = argv[++i];
+        }
+        else
+        {
+            cout << "Unknown option: " << arg << endl;
+            failed = true;
+        }
+    }
+    if (failed || min_time <= 0)
+    {
+        cout << R"###(
+DESCRIPTION
+    Benchmarks ops across shapes and element types and the bundled models on each backend.
+
+SYNOPSIS
+        ngraph-bench [-b <backend>]... [--filter <regex>] [--min_time <seconds>]
+                     [--min_iterations <count>] [--models <dir> | --no_models] [--no_ops]
+                     [--list] [--format text|json] [-o <file>]
+
+OPTIONS
+        -b|--backend       Backend to run on, can be repeated (default: all registered)
+        --filter           Only run cases whose name matches the regular expression,
+                           such as "Dot/f32/.*" or "model/mxnet/.*"
+        --min_time         Seconds to measure each case for (default: 0.5)
+        --min_iterations   Fewest timed calls of each case, however long they take
+                           (default: 1)
+        --models           Directory of serialized models (default: test/models)
+        --no_models        Skip the models
+        --no_ops           Skip the op microbenchmarks
+        --list             List the cases instead of running them
+        --format           Output format: text or json (default: text)
+        -o|--output        Write the json output to a file instead of stdout
+
+    Timings only compare on the same machine. Record the json output of a build there and
+    check a later build against it with
+        test/bench/compare.py <baseline>.json <new>.json
+    The bench-baseline and bench-check targets do this for the INTERPRETER backend.
+)###";
+        return 1;
+    }
+
+    if (run_ops)
+    {
+        register_op_benchmarks();
+    }
+    if (run_models)
+    {
+        register_model_benchmarks(models);
+    }
+    regex name_filter(filter);
+    vector<BenchmarkCase> cases;
+    size_t name_width = 9;
+    for (const BenchmarkCase& c : get_benchmark_cases())
+    {
+        if (regex_match(c.name, name_filter))
+        {
+            cases.push_back(c);
+            name_width = max(name_width, c.name.size());
+        }
+    }
+    if (list)
+    {
+        for (const BenchmarkCase& c : cases)
+        {
+            cout << c.name << endl;
+        }
+        return 0;
+    }
+
+    if (backends.empty())
+    {
+        backends = runtime::Backend::get_registered_devices();
+    }
+    size_t backend_width = 0;
+    for (const string& backend : backends)
+    {
+        backend_width = max(backend_width, backend.size());
+    }
+    name_width += backend_width + 1;
+
+    if (format == "text")
+    {
+        cout << setw(name_width + 2) << left << "Benchmark" << right << setw(12) << "mean(ms)"
+             << setw(12) << "p50(ms)" << setw(12) << "stddev(ms)" << setw(12) << "Iterations"
+             << endl;
+    }
+    BenchmarkOptions options;
+    options.duration = min_time;
+    options.min_iterations = min_iterations;
+    vector<CaseResult> results;
+    for (const BenchmarkCase& c : cases)
+    {
+        for (const string& backend : backends)
+        {
+            CaseResult r;
+            r.name = c.name;
+            r.backend = backend;
+            try
+            {
+                r.result = run_benchmark(c.make_function(), backend, options);
+            }
+            catch (const exception& e)
+            {
+                r.error = e.what();
+            }
+            if (format == "text")
+            {
+                print_row(c.name + "/" + backend, name_width, r);
+            }
+            results.push_back(r);
+        }
+    }
+
+    if (format == "json")
+    {
+        ofstream out_file;
+        if (!output_file.empty())
+        {
+            out_file.open(output_file);
+        }
+        write_json(output_file.empty() ? cout : out_file, results, min_time, min_iterations);
+    }
+    return 0;
+}
@@ -0,0 +1,145 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#include "bench.hpp"
+#include "ngraph/ngraph.hpp"
+#include "ngraph/util.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+// Such as Add/f32/64x1024
+static string case_name(const string& op, const element::Type& type, const Shape& shape)
+{
+    string type_name = type.is_real() ? "f" : (type.is_signed() ? "i" : "u");
+    return op + "/" + type_name + to_string(type.bitwidth()) + "/" + join(shape, "x");
+}
+
+template <typename OP>
+static void register_unary(const string& op,
+                           const vector<element::Type>& types,
+                           const vector<Shape>& shapes)
+{
+    for (const element::Type& type : types)
+    {
+        for (const Shape& shape : shapes)
+        {
+            register_benchmark(case_name(op, type, shape), [type, shape]() {
+                auto A = make_shared<op::Parameter>(type, shape);
+                return make_shared<Function>(make_shared<OP>(A), op::ParameterVector{A});
+            });
+        }
+    }
+}
+
+template <typename OP>
+static void register_binary(const string& op,
+                            const vector<element::Type>& types,
+                            const vector<Shape>& shapes)
+{
+    for (const element::Type& type : types)
+    {
+        for (const Shape& shape : shapes)
+        {
+            register_benchmark(case_name(op, type, shape), [type, shape]() {
+                auto A = make_shared<op::Parameter>(type, shape);
+                auto B = make_shared<op::Parameter>(type, shape);
+                return make_shared<Function>(make_shared<OP>(A, B), op::ParameterVector{A, B});
+            });
+        }
+    }
+}
+
+void register_op_benchmarks()
+{
+    vector<element::Type> all_types{element::f32, element::f64, element::i32};
+    vector<element::Type> real_types{element::f32, element::f64};
+    vector<Shape> elementwise_shapes{Shape{1024}, Shape{64, 1024}, Shape{1024, 1024}};
+
+    register_binary<op::Add>("Add", all_types, elementwise_shapes);
+    register_binary<op::Multiply>("Multiply", all_types, elementwise_shapes);
+    register_binary<op::Maximum>("Maximum", real_types, elementwise_shapes);
+    register_unary<op::Negative>("Negative", all_types, elementwise_shapes);
+    register_unary<op::Relu>("Relu", real_types, elementwise_shapes);
+    register_unary<op::Exp>("Exp", real_types, elementwise_shapes);
+    register_unary<op::Tanh>("Tanh", real_types, elementwise_shapes);
+
+    // M x K times K x N, named MxKxN
+    for (const element::Type& type : real_types)
+    {
+        for (const Shape& mkn : {Shape{1, 1024, 1024}, Shape{64, 64, 64}, Shape{256, 256, 256}})
+        {
+            register_benchmark(case_name("Dot", type, mkn), [type, mkn]() {
+                auto A = make_shared<op::Parameter>(type, Shape{mkn[0], mkn[1]});
+                auto B = make_shared<op::Parameter>(type, Shape{mkn[1], mkn[2]});
+                return make_shared<Function>(make_shared<op::Dot>(A, B),
+                                             op::ParameterVector{A, B});
+            });
+        }
+    }
+
+    for (const Shape& shape : {Shape{64, 1024}, Shape{1024, 1024}})
+    {
+        register_benchmark(case_name("Sum", element::f32, shape), [shape]() {
+            auto A = make_shared<op::Parameter>(element::f32, shape);
+            return make_shared<Function>(make_shared<op::Sum>(A, AxisSet{1}),
+                                         op::ParameterVector{A});
+        });
+        register_benchmark(case_name("Softmax", element::f32, shape), [shape]() {
+            auto A = make_shared<op::Parameter>(element::f32, shape);
+            return make_shared<Function>(make_shared<op::Softmax>(A, AxisSet{1}),
+                                         op::ParameterVector{A});
+        });
+        register_benchmark(case_name("Transpose", element::f32, shape), [shape]() {
+            auto A = make_shared<op::Parameter>(element::f32, shape);
+            auto reshape =
+                make_shared<op::Reshape>(A, AxisVector{1, 0}, Shape{shape[1], shape[0]});
+            return make_shared<Function>(reshape, op::ParameterVector{A});
+        });
+    }
+
+    for (const Shape& shape : {Shape{32, 1, 200}, Shape{8, 64, 56, 56}})
+    {
+        register_benchmark(case_name("Concat", element::f32, shape), [shape]() {
+            op::ParameterVector params;
+            NodeVector args;
+            for (size_t i = 0; i < 4; i++)
+            {
+                params.push_back(make_shared<op::Parameter>(element::f32, shape));
+                args.push_back(params.back());
+            }
+            return make_shared<Function>(make_shared<op::Concat>(args, 1), params);
+        });
+    }
+
+    // 3x3 convolutions and 2x2 pooling over NCHW batches
+    for (const Shape& shape : {Shape{1, 64, 56, 56}, Shape{8, 64, 56, 56}, Shape{8, 256, 14, 14}})
+    {
+        register_benchmark(case_name("Convolution", element::f32, shape), [shape]() {
+            auto data = make_shared<op::Parameter>(element::f32, shape);
+            Shape filters_shape{shape[1], shape[1], 3, 3};
+            auto filters = make_shared<op::Parameter>(element::f32, filters_shape);
+            return make_shared<Function>(make_shared<op::Convolution>(data, filters),
+                                         op::ParameterVector{data, filters});
+        });
+        register_benchmark(case_name("MaxPool", element::f32, shape), [shape]() {
+            auto data = make_shared<op::Parameter>(element::f32, shape);
+            auto pool = make_shared<op::MaxPool>(data, Shape{2, 2}, Strides{2, 2});
+            return make_shared<Function>(pool, op::ParameterVector{data});
+        });
+    }
+}
@@ -0,0 +1,89 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <memory>
+
+#include "gtest/gtest.h"
+
+#include "ngraph/cost_model.hpp"
+#include "ngraph/ngraph.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+TEST(cost_model, dot)
+{
+    auto A = make_shared<op::Parameter>(element::f32, Shape{2, 3});
+    auto B = make_shared<op::Parameter>(element::f32, Shape{3, 4});
+    auto dot = make_shared<op::Dot>(A, B);
+
+    Cost cost = estimate_cost(*dot);
+    EXPECT_EQ(cost.flops, 2 * 8 * 3);
+    EXPECT_EQ(cost.bytes_read, (6 + 12) * sizeof(float));
+    EXPECT_EQ(cost.bytes_written, 8 * sizeof(float));
+    EXPECT_EQ(cost.working_set, (6 + 12 + 8) * sizeof(float));
+    EXPECT_DOUBLE_EQ(cost.arithmetic_intensity(), 48.0 / 104);
+}
+
+TEST(cost_model, convolution)
+{
+    auto data = make_shared<op::Parameter>(element::f32, Shape{1, 3, 8, 8});
+    auto filters = make_shared<op::Parameter>(element::f32, Shape{16, 3, 3, 3});
+    auto conv = make_shared<op::Convolution>(data, filters);
+
+    // 16x6x6 outputs, each a sum over 3x3x3 products
+    EXPECT_EQ(estimate_cost(*conv).flops, 2 * 16 * 6 * 6 * 27);
+}
+
+TEST(cost_model, elementwise_and_data_movement)
+{
+    auto A = make_shared<op::Parameter>(element::f32, Shape{10, 10});
+    auto square = make_shared<op::Multiply>(A, A);
+    auto slice = make_shared<op::Slice>(A, Coordinate{0, 0}, Coordinate{2, 10});
+    auto reshape = make_shared<op::Reshape>(A, AxisVector{1, 0}, Shape{10, 10});
+
+    Cost square_cost = estimate_cost(*square);
+    EXPECT_EQ(square_cost.flops, 100);
+    EXPECT_EQ(square_cost.bytes_read, 800);
+    // The argument is read twice but held once
+    EXPECT_EQ(square_cost.working_set, 800);
+
+    Cost slice_cost = estimate_cost(*slice);
+    EXPECT_EQ(slice_cost.flops, 0);
+    EXPECT_EQ(slice_cost.bytes_read, 80);
+    EXPECT_EQ(slice_cost.bytes_written, 80);
+
+    EXPECT_EQ(estimate_cost(*reshape).flops, 0);
+    EXPECT_EQ(estimate_cost(*A).bytes_written, 0);
+}
+
+TEST(cost_model, function)
+{
+    Shape shape{100};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Add>(A, A);
+    auto C = make_shared<op::Negative>(B);
+    auto D = make_shared<op::Negative>(C);
+    auto f = make_shared<Function>(D, op::ParameterVector{A});
+
+    Cost cost = estimate_cost(*f);
+    EXPECT_EQ(cost.flops, 300);
+    // Add, both Negatives and the Result each read and write the shape once more
+    EXPECT_EQ(cost.bytes_read, 5 * 400);
+    EXPECT_EQ(cost.bytes_written, 4 * 400);
+    // The parameter, an op's argument and its output are live at the same time
+    EXPECT_EQ(cost.working_set, 3 * 400);
+}
@@ -105,3 +105,27 @@ TEST(cpio, write)
         }
     }
 }
+
+TEST(cpio, write_aligned)
+{
+    const string test_file = "test2.cpio";
+    string s1 = "this is a test";
+    string s2 = "the quick brown fox jumps over the lazy dog";
+    {
+        cpio::Writer writer(test_file);
+        writer.write("file1.txt", s1.data(), static_cast<uint32_t>(s1.size()));
+        writer.write("file.txt", s2.data(), static_cast<uint32_t>(s2.size()), 64);
+    }
+    {
+        cpio::Reader reader(test_file);
+        auto file_info = reader.get_file_info();
+        ASSERT_EQ(2, file_info.size());
+        EXPECT_STREQ(file_info[1].get_name().c_str(), "file.txt");
+        EXPECT_EQ(file_info[1].get_offset() % 64, 0);
+
+        vector<char> data(file_info[1].get_size());
+        reader.read(file_info[1].get_name(), data.data(), data.size());
+        EXPECT_EQ(string(data.data(), data.size()), s2);
+    }
+    file_util::remove_file(test_file);
+}
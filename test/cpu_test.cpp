@@ -16,9 +16,11 @@
 
 #include <algorithm>
 #include <cstdio>
+#include <dlfcn.h>
 #include <iostream>
 #include <list>
 #include <memory>
+#include <sched.h>
 
 #include "gtest/gtest.h"
 #include "ngraph/autodiff/adjoints.hpp"
@@ -31,6 +33,11 @@
 #include "ngraph/op/parameter.hpp"
 #include "ngraph/pass/manager.hpp"
 #include "ngraph/pass/visualize_tree.hpp"
+#include "ngraph/runtime/cpu/cpu_backend.hpp"
+#include "ngraph/runtime/cpu/cpu_executor.hpp"
+#include "ngraph/runtime/cpu/cpu_external_function.hpp"
+#include "ngraph/runtime/cpu/cpu_isa.hpp"
+#include "ngraph/runtime/cpu/cpu_kernel_registry.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_fusion.hpp"
 #include "ngraph/serializer.hpp"
 #include "ngraph/util.hpp"
@@ -136,8 +143,352 @@ TEST(cpu_test, abc_tbb)
         unsetenv("NGRAPH_CPU_USE_TBB");
     }
 }
+
+TEST(cpu_test, tbb_persistent_graph)
+{
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>((A + B) * (A - B), op::ParameterVector{A, B});
+
+    auto backend = runtime::Backend::create("CPU:tbb=1,dex=0,inter_op=2");
+    auto a = backend->create_tensor(element::f32, shape);
+    auto b = backend->create_tensor(element::f32, shape);
+    copy_data(a, vector<float>{1, 2, 3, 4});
+    copy_data(b, vector<float>{4, 3, 2, 1});
+
+    // The graph built by the first call is reused with different argument buffers
+    for (size_t i = 0; i < 3; i++)
+    {
+        auto result = backend->create_tensor(element::f32, shape);
+        backend->call(f, {result}, {i % 2 ? b : a, i % 2 ? a : b});
+        vector<float> expected{-15, -5, 5, 15};
+        if (i % 2)
+        {
+            expected = {15, 5, -5, -15};
+        }
+        EXPECT_EQ(expected, read_vector<float>(result));
+    }
+}
 #endif // NGRAPH_TBB_ENABLE
 
+TEST(cpu_test, backend_config)
+{
+    runtime::cpu::CPUBackendConfig config;
+    config.parse("dex=1,tracing=off,inter_op_threshold=128,threads=2,cores=0-1,3");
+    EXPECT_TRUE(config.direct_execution);
+    EXPECT_FALSE(config.tracing);
+    EXPECT_EQ(config.inter_op_threshold, 128);
+    EXPECT_EQ(config.executor.num_threads, 2);
+    EXPECT_EQ(config.executor.cores, (vector<int>{0, 1, 3}));
+    EXPECT_THROW(config.parse("dex=maybe"), ngraph_error);
+    EXPECT_THROW(config.set("unknown", "1"), ngraph_error);
+    config.set("trace_sampling", "100");
+    EXPECT_EQ(config.trace_sampling, 100);
+    EXPECT_THROW(config.set("trace_sampling", "0"), ngraph_error);
+
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>(A * B, op::ParameterVector{A, B});
+
+    // Options set through the Backend API apply to functions compiled afterwards
+    auto backend = runtime::Backend::create("CPU");
+    backend->set_config({{"dex", "1"}});
+    auto cpu_backend = dynamic_pointer_cast<runtime::cpu::CPU_Backend>(backend);
+    EXPECT_TRUE(cpu_backend->get_config().direct_execution);
+
+    auto a = backend->create_tensor(element::f32, shape);
+    auto b = backend->create_tensor(element::f32, shape);
+    auto result = backend->create_tensor(element::f32, shape);
+    copy_data(a, vector<float>{1, 2, 3, 4});
+    copy_data(b, vector<float>{5, 6, 7, 8});
+    backend->call(f, {result}, {a, b});
+    EXPECT_EQ((vector<float>{5, 12, 21, 32}), read_vector<float>(result));
+
+    EXPECT_THROW(backend->set_config({{"dex", "0"}}), runtime_error);
+}
+
+TEST(cpu_test, dex_isa_variants)
+{
+    // Run the DEX elementwise kernels with every ISA variant the host supports
+    bool use_dex = (getenv("NGRAPH_DEX") != nullptr);
+    if (!use_dex)
+    {
+        setenv("NGRAPH_DEX", "1", 1);
+    }
+
+    Shape shape{2, 3};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto C = make_shared<op::Parameter>(element::f32, shape);
+
+    size_t host_isa = static_cast<size_t>(runtime::cpu::get_host_isa());
+    for (size_t i = 0; i <= host_isa; i++)
+    {
+        auto isa = static_cast<runtime::cpu::ISA>(i);
+        auto& registry = runtime::cpu::KernelRegistry::get();
+        runtime::cpu::ISA selected = runtime::cpu::ISA::generic;
+        auto add_kernel = registry.find_binary("add", element::f32, isa, &selected);
+        ASSERT_NE(add_kernel, nullptr);
+        if (registry.has_variant(isa))
+        {
+            EXPECT_EQ(selected, isa);
+        }
+
+        // Each level other than generic comes from a library of its own
+        Dl_info info;
+        ASSERT_NE(dladdr(reinterpret_cast<void*>(add_kernel), &info), 0);
+        string library = file_util::get_file_name(info.dli_fname);
+        string expected_library = "cpu_backend";
+        if (selected != runtime::cpu::ISA::generic)
+        {
+            expected_library = string("cpu_kernels_") + runtime::cpu::isa_name(selected) + ".";
+        }
+        EXPECT_NE(library.find(expected_library), string::npos)
+            << "ISA variant " << runtime::cpu::isa_name(selected) << " found in " << library;
+
+        setenv("NGRAPH_CPU_ISA", runtime::cpu::isa_name(isa), 1);
+
+        auto add = make_shared<op::Abs>(A) + B;
+        auto relu = make_shared<op::Relu>(add);
+        auto f = make_shared<Function>(relu * C, op::ParameterVector{A, B, C});
+        auto backend = runtime::Backend::create("CPU");
+
+        shared_ptr<runtime::TensorView> a = backend->create_tensor(element::f32, shape);
+        shared_ptr<runtime::TensorView> b = backend->create_tensor(element::f32, shape);
+        shared_ptr<runtime::TensorView> c = backend->create_tensor(element::f32, shape);
+        shared_ptr<runtime::TensorView> result = backend->create_tensor(element::f32, shape);
+
+        copy_data(a, vector<float>{-1, 2, -3, 4, -5, 6});
+        copy_data(b, vector<float>{1, -4, 1, -8, 1, -12});
+        copy_data(c, vector<float>{2, 2, 2, 2, 2, 2});
+
+        auto external_function = make_shared<runtime::cpu::CPU_ExternalFunction>(f, false);
+        external_function->make_call_frame()->call({result}, {a, b, c});
+        EXPECT_EQ(external_function->get_isa(), isa);
+        EXPECT_EQ(external_function->get_kernel_isa(add->get_name()), selected);
+        EXPECT_EQ((vector<float>{4, 0, 8, 0, 12, 0}), read_vector<float>(result))
+            << "ISA variant " << runtime::cpu::isa_name(isa);
+    }
+
+    unsetenv("NGRAPH_CPU_ISA");
+    if (!use_dex)
+    {
+        unsetenv("NGRAPH_DEX");
+    }
+}
+
+TEST(cpu_test, executor_config)
+{
+    auto config =
+        runtime::cpu::executor::ExecutorConfig::parse("threads=4,inter_op=2,cores=0-2,5,numa=0");
+    EXPECT_EQ(config.num_threads, 4);
+    EXPECT_EQ(config.inter_op_parallelism, 2);
+    EXPECT_EQ(config.cores, (vector<int>{0, 1, 2, 5}));
+    EXPECT_EQ(config.numa_node, 0);
+
+    EXPECT_TRUE(runtime::cpu::executor::ExecutorConfig::parse("").is_default());
+    EXPECT_THROW(runtime::cpu::executor::ExecutorConfig::parse("thread=4"), ngraph_error);
+    EXPECT_THROW(runtime::cpu::executor::ExecutorConfig::parse("threads=x"), ngraph_error);
+}
+
+TEST(cpu_test, executor_pins_caller)
+{
+    cpu_set_t before;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(before), &before), 0);
+    int core = 0;
+    while (!CPU_ISSET(core, &before))
+    {
+        core++;
+    }
+    runtime::cpu::executor::ExecutorConfig config;
+    config.num_threads = 1;
+    config.cores = {core};
+    runtime::cpu::executor::CPUExecutor executor(config);
+
+    // The caller is restricted for the call only
+    cpu_set_t during;
+    executor.execute([&]() { sched_getaffinity(0, sizeof(during), &during); });
+    EXPECT_EQ(CPU_COUNT(&during), 1);
+    EXPECT_TRUE(CPU_ISSET(core, &during));
+    cpu_set_t after;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(after), &after), 0);
+    EXPECT_TRUE(CPU_EQUAL(&before, &after));
+
+    // Also when the call throws
+    EXPECT_THROW(executor.execute([]() { throw ngraph_error("failed call"); }), ngraph_error);
+    ASSERT_EQ(sched_getaffinity(0, sizeof(after), &after), 0);
+    EXPECT_TRUE(CPU_EQUAL(&before, &after));
+}
+
+TEST(cpu_test, backend_executor)
+{
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>(A + B, op::ParameterVector{A, B});
+
+    auto backend = runtime::Backend::create("CPU:threads=2,inter_op=1");
+    auto cpu_backend = dynamic_pointer_cast<runtime::cpu::CPU_Backend>(backend);
+    ASSERT_NE(cpu_backend, nullptr);
+    EXPECT_EQ(cpu_backend->get_cpu_executor()->get_num_threads(), 2);
+    EXPECT_NE(cpu_backend->get_cpu_executor(),
+              runtime::cpu::executor::CPUExecutor::get_default());
+
+    // Backends without attributes share the default executor
+    auto default_backend =
+        dynamic_pointer_cast<runtime::cpu::CPU_Backend>(runtime::Backend::create("CPU"));
+    EXPECT_EQ(default_backend->get_cpu_executor(),
+              runtime::cpu::executor::CPUExecutor::get_default());
+
+    shared_ptr<runtime::TensorView> a = backend->create_tensor(element::f32, shape);
+    shared_ptr<runtime::TensorView> b = backend->create_tensor(element::f32, shape);
+    shared_ptr<runtime::TensorView> result = backend->create_tensor(element::f32, shape);
+    copy_data(a, vector<float>{1, 2, 3, 4});
+    copy_data(b, vector<float>{5, 6, 7, 8});
+
+    backend->call(f, {result}, {a, b});
+    EXPECT_EQ((vector<float>{6, 8, 10, 12}), read_vector<float>(result));
+}
+
+TEST(cpu_test, backend_numa_node)
+{
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = op::Constant::create(element::f32, shape, {1, 2, 3, 4});
+    auto f = make_shared<Function>(A * B, op::ParameterVector{A});
+
+    // Constants and the intermediate pool are placed on node 0
+    auto backend = runtime::Backend::create("CPU:numa=0");
+    auto cpu_backend = dynamic_pointer_cast<runtime::cpu::CPU_Backend>(backend);
+    EXPECT_EQ(cpu_backend->get_cpu_executor()->get_numa_node(), 0);
+    EXPECT_EQ(cpu_backend->get_cpu_executor()->get_cores(),
+              runtime::cpu::executor::get_numa_node_cores(0));
+
+    shared_ptr<runtime::TensorView> a = backend->create_tensor(element::f32, shape);
+    shared_ptr<runtime::TensorView> result = backend->create_tensor(element::f32, shape);
+    copy_data(a, vector<float>{2, 2, 2, 2});
+
+    backend->call(f, {result}, {a});
+    EXPECT_EQ((vector<float>{2, 4, 6, 8}), read_vector<float>(result));
+}
+
+TEST(cpu_test, dex_inter_op_parallel)
+{
+    bool use_dex = (getenv("NGRAPH_DEX") != nullptr);
+    if (!use_dex)
+    {
+        setenv("NGRAPH_DEX", "1", 1);
+    }
+    // Schedule every op as a task
+    setenv("NGRAPH_DEX_INTER_OP_THRESHOLD", "0", 1);
+
+    Shape shape{16, 16};
+    auto make_function = [&]() {
+        auto A = make_shared<op::Parameter>(element::f32, shape);
+        auto B = make_shared<op::Parameter>(element::f32, shape);
+        auto branch1 = make_shared<op::Relu>(A + B);
+        auto branch2 = make_shared<op::Abs>(A) * B;
+        auto branch3 = make_shared<op::Ceiling>(A) + A;
+        return make_shared<Function>((branch1 + branch2) * branch3, op::ParameterVector{A, B});
+    };
+
+    test::Uniform<float> rng(-10.0f, 10.0f);
+    vector<vector<float>> args;
+    for (size_t i = 0; i < 2; i++)
+    {
+        vector<float> tensor_val(shape_size(shape));
+        rng.initialize(tensor_val);
+        args.push_back(tensor_val);
+    }
+
+    auto sequential_results = execute(make_function(), args, "CPU");
+    auto f = make_function();
+    auto backend = runtime::Backend::create("CPU:inter_op=4");
+    auto cpu_backend = dynamic_pointer_cast<runtime::cpu::CPU_Backend>(backend);
+    ASSERT_NE(cpu_backend, nullptr);
+    cpu_backend->compile(f);
+    auto external_function = cpu_backend->get_external_function(f);
+    ASSERT_NE(external_function, nullptr);
+    ASSERT_TRUE(external_function->is_inter_op_scheduled());
+
+    auto a = backend->create_tensor(element::f32, shape);
+    auto b = backend->create_tensor(element::f32, shape);
+    auto result = backend->create_tensor(element::f32, shape);
+    for (size_t i = 0; i < 10; i++)
+    {
+        copy_data(a, args[0]);
+        copy_data(b, args[1]);
+        backend->call(f, {result}, {a, b});
+        EXPECT_TRUE(test::all_close(sequential_results.at(0), read_vector<float>(result)));
+    }
+
+    unsetenv("NGRAPH_DEX_INTER_OP_THRESHOLD");
+    if (!use_dex)
+    {
+        unsetenv("NGRAPH_DEX");
+    }
+}
+
+TEST(cpu_test, dex_performance_counters)
+{
+    Shape shape{16, 16};
+    test::Uniform<float> rng(-10.0f, 10.0f);
+    vector<vector<float>> args;
+    for (size_t i = 0; i < 2; i++)
+    {
+        vector<float> tensor_val(shape_size(shape));
+        rng.initialize(tensor_val);
+        args.push_back(tensor_val);
+    }
+
+    // Op types and call counts of the counters, in order; node names differ between
+    // instances of the function. Functions with a FunctionCall are out of scope: codegen
+    // also times the ops of called functions, but DEX has no builder for FunctionCall.
+    const size_t calls = 3;
+    auto get_counters = [&](const string& backend_name) {
+        auto A = make_shared<op::Parameter>(element::f32, shape);
+        auto B = make_shared<op::Parameter>(element::f32, shape);
+        auto branch1 = make_shared<op::Relu>(A + B);
+        auto branch2 = make_shared<op::Abs>(A) * B;
+        auto branch3 = make_shared<op::Ceiling>(A) + A;
+        auto f =
+            make_shared<Function>((branch1 + branch2) * branch3, op::ParameterVector{A, B});
+
+        auto backend = runtime::Backend::create(backend_name);
+        backend->enable_performance_data(f, true);
+        auto a = backend->create_tensor(element::f32, shape);
+        auto b = backend->create_tensor(element::f32, shape);
+        auto result = backend->create_tensor(element::f32, shape);
+        for (size_t i = 0; i < calls; i++)
+        {
+            // Fresh inputs, so that DEX runs every op
+            copy_data(a, args[0]);
+            copy_data(b, args[1]);
+            backend->call(f, {result}, {a, b});
+        }
+
+        vector<pair<string, size_t>> counters;
+        for (const runtime::PerformanceCounter& p : backend->get_performance_data(f))
+        {
+            string name = p.name();
+            counters.emplace_back(name.substr(0, name.rfind('_')), p.call_count());
+        }
+        return counters;
+    };
+
+    auto codegen = get_counters("CPU:dex=0");
+    ASSERT_FALSE(codegen.empty());
+    for (const pair<string, size_t>& counter : codegen)
+    {
+        EXPECT_EQ(counter.second, calls) << counter.first;
+    }
+    EXPECT_EQ(get_counters("CPU:dex=1"), codegen);
+    // Every op scheduled as a task of the inter-op flow graph
+    EXPECT_EQ(get_counters("CPU:dex=1,inter_op=4,inter_op_threshold=0"), codegen);
+}
+
 TEST(cpu_test, mkldnn_layouts)
 {
     Shape shape_a{1, 16, 2, 2};
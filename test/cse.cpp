@@ -271,3 +271,77 @@ TEST(CSE, reduction_ops)
     execute_cse_reduction_test<op::Sum>();
     execute_cse_reduction_test<op::Product>();
 }
+
+TEST(CSE, commutative_ops)
+{
+    Shape shape{2};
+    auto A = std::make_shared<op::Parameter>(element::f32, shape);
+    auto B = std::make_shared<op::Parameter>(element::f32, shape);
+    auto min1 = std::make_shared<op::Minimum>(A, B);
+    auto min2 = std::make_shared<op::Minimum>(B, A);
+    auto eq1 = std::make_shared<op::Equal>(A, B);
+    auto eq2 = std::make_shared<op::Equal>(B, A);
+    auto sub1 = std::make_shared<op::Subtract>(A, B);
+    auto sub2 = std::make_shared<op::Subtract>(B, A);
+    auto f = std::make_shared<Function>(NodeVector{min1, min2, eq1, eq2, sub1, sub2},
+                                        op::ParameterVector{A, B});
+
+    pass::CommonSubexpressionElimination cse;
+    ASSERT_TRUE(cse.run_on_function(f));
+    ASSERT_EQ(f->get_results().at(0)->get_argument(0), f->get_results().at(1)->get_argument(0));
+    ASSERT_EQ(f->get_results().at(2)->get_argument(0), f->get_results().at(3)->get_argument(0));
+    ASSERT_NE(f->get_results().at(4)->get_argument(0), f->get_results().at(5)->get_argument(0));
+    EXPECT_EQ(cse.get_eliminated_node_count(), 2);
+    EXPECT_EQ(cse.get_eliminated_bytes(), 2 * sizeof(float) + 2 * sizeof(char));
+}
+
+TEST(CSE, attribute_ops)
+{
+    auto A = std::make_shared<op::Parameter>(element::f32, Shape{2, 3});
+    auto B = std::make_shared<op::Parameter>(element::f32, Shape{3, 4});
+    auto dot1 = std::make_shared<op::Dot>(A, B);
+    auto dot2 = std::make_shared<op::Dot>(A, B);
+    auto slice1 = std::make_shared<op::Slice>(dot1, Coordinate{0, 0}, Coordinate{2, 2});
+    auto slice2 = std::make_shared<op::Slice>(dot2, Coordinate{0, 0}, Coordinate{2, 2});
+    auto slice3 = std::make_shared<op::Slice>(dot2, Coordinate{0, 2}, Coordinate{2, 4});
+    auto concat1 = std::make_shared<op::Concat>(NodeVector{slice1, slice3}, 1);
+    auto concat2 = std::make_shared<op::Concat>(NodeVector{slice2, slice3}, 1);
+    auto concat3 = std::make_shared<op::Concat>(NodeVector{slice3, slice2}, 1);
+    auto f = std::make_shared<Function>(NodeVector{concat1, concat2, concat3},
+                                        op::ParameterVector{A, B});
+
+    pass::CommonSubexpressionElimination cse;
+    cse.run_on_function(f);
+    ASSERT_EQ(f->get_results().at(0)->get_argument(0), f->get_results().at(1)->get_argument(0));
+    ASSERT_NE(f->get_results().at(0)->get_argument(0), f->get_results().at(2)->get_argument(0));
+    EXPECT_EQ(count_ops_of_type<op::Dot>(f), 1);
+    EXPECT_EQ(count_ops_of_type<op::Slice>(f), 2);
+    EXPECT_EQ(cse.get_eliminated_node_count(), 3);
+    EXPECT_EQ(cse.get_eliminated_bytes(), (8 + 4 + 8) * sizeof(float));
+}
+
+TEST(CSE, constants)
+{
+    Shape shape{2, 2};
+    auto A = std::make_shared<op::Parameter>(element::f32, shape);
+    auto one1 = op::Constant::create(element::f32, Shape{}, {1});
+    auto one2 = op::Constant::create(element::f32, Shape{}, {1});
+    auto two = op::Constant::create(element::f32, Shape{}, {2});
+    auto one_int = op::Constant::create(element::i32, Shape{}, {1});
+    auto b1 = std::make_shared<op::Broadcast>(one1, shape, AxisSet{0, 1});
+    auto b2 = std::make_shared<op::Broadcast>(one2, shape, AxisSet{0, 1});
+    auto b3 = std::make_shared<op::Broadcast>(two, shape, AxisSet{0, 1});
+    auto add1 = std::make_shared<op::Add>(A, b1);
+    auto add2 = std::make_shared<op::Add>(b2, A);
+    auto add3 = std::make_shared<op::Add>(A, b3);
+    auto f = std::make_shared<Function>(NodeVector{add1, add2, add3, one_int},
+                                        op::ParameterVector{A});
+
+    pass::CommonSubexpressionElimination cse;
+    cse.run_on_function(f);
+    ASSERT_EQ(f->get_results().at(0)->get_argument(0), f->get_results().at(1)->get_argument(0));
+    ASSERT_NE(f->get_results().at(0)->get_argument(0), f->get_results().at(2)->get_argument(0));
+    ASSERT_EQ(f->get_results().at(3)->get_argument(0), one_int);
+    EXPECT_EQ(count_ops_of_type<op::Constant>(f), 3);
+    EXPECT_EQ(count_ops_of_type<op::Broadcast>(f), 2);
+}
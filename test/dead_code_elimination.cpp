@@ -0,0 +1,168 @@
+/*******************************************************************************
+* Copyright 2017-2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <memory>
+
+#include "gtest/gtest.h"
+#include "ngraph/autodiff/adjoints.hpp"
+#include "ngraph/file_util.hpp"
+#include "ngraph/graph_util.hpp"
+#include "ngraph/ngraph.hpp"
+#include "ngraph/pass/dead_code_elimination.hpp"
+#include "ngraph/pass/manager.hpp"
+#include "ngraph/serializer.hpp"
+#include "ngraph/util.hpp"
+#include "util/test_tools.hpp"
+
+using namespace ngraph;
+using namespace std;
+
+TEST(dead_code_elimination, dead_users)
+{
+    Shape shape{2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto add = make_shared<op::Add>(A, B);
+    auto dead = make_shared<op::Abs>(add);
+    auto f = make_shared<Function>(make_shared<op::Multiply>(add, A), op::ParameterVector{A, B});
+
+    // Nothing to remove; dead is not part of f and stays connected
+    pass::DeadCodeElimination dce;
+    vector<shared_ptr<Function>> functions{f};
+    EXPECT_FALSE(dce.run_on_module(functions));
+    EXPECT_EQ(add->get_users().size(), 2);
+    EXPECT_EQ(dead->get_argument(0), add);
+}
+
+TEST(dead_code_elimination, dead_adjoints_stay_usable)
+{
+    Shape shape{2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto C = make_shared<op::Parameter>(element::f32, shape);
+    auto Y = make_shared<op::Multiply>(A, B);
+    autodiff::Adjoints adjoints(NodeVector{Y}, NodeVector{C});
+    auto dA = adjoints.backprop_node(A);
+    auto dB = adjoints.backprop_node(B);
+
+    // dB is not computed by f
+    auto f = make_shared<Function>(NodeVector{dA}, op::ParameterVector{A, B, C});
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::DeadCodeElimination>();
+    pass_manager.run_passes(f);
+
+    // Both ends of the edges of dB are intact, so a function can still be built from it
+    for (const shared_ptr<Node>& arg : dB->get_arguments())
+    {
+        NodeVector users = arg->get_users();
+        EXPECT_EQ(count(users.begin(), users.end(), dB), 1);
+    }
+    auto g = make_shared<Function>(NodeVector{dB}, op::ParameterVector{A, B, C});
+    vector<vector<float>> args{{1, 2}, {3, 4}, {5, 6}};
+    EXPECT_EQ((vector<float>{5, 12}), execute(g, args, "INTERPRETER").at(0));
+    EXPECT_EQ((vector<float>{15, 24}), execute(f, args, "INTERPRETER").at(0));
+}
+
+TEST(dead_code_elimination, function_call_outputs)
+{
+    Shape shape{2};
+    auto X = make_shared<op::Parameter>(element::f32, shape);
+    auto Y = make_shared<op::Parameter>(element::f32, shape);
+    auto g = make_shared<Function>(NodeVector{make_shared<op::Add>(X, Y), X * Y},
+                                   op::ParameterVector{X, Y});
+
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto call = make_shared<op::FunctionCall>(g, NodeVector{A, B});
+    auto product = make_shared<op::GetOutputElement>(call, 1);
+    auto f = make_shared<Function>(product - A, op::ParameterVector{A, B});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::DeadCodeElimination>();
+    pass_manager.run_passes(f);
+
+    auto new_call = f->get_results().at(0)->get_argument(0)->get_argument(0);
+    ASSERT_TRUE(dynamic_pointer_cast<op::FunctionCall>(new_call));
+    ASSERT_NE(new_call, call);
+    EXPECT_EQ(new_call->get_output_size(), 1);
+    EXPECT_EQ(new_call->get_functions().at(0)->get_results().size(), 1);
+    EXPECT_EQ(count_ops_of_type<op::Add>(new_call->get_functions().at(0)), 0);
+    EXPECT_EQ(g->get_results().size(), 2);
+    // The module calls the pruned copy instead of g
+    EXPECT_EQ(pass_manager.get_state().get_functions(),
+              (vector<shared_ptr<Function>>{f, new_call->get_functions().at(0)}));
+
+    vector<vector<float>> args{{1, 2}, {3, 4}};
+    EXPECT_EQ((vector<float>{2, 6}), execute(f, args, "INTERPRETER").at(0));
+}
+
+TEST(dead_code_elimination, other_graph_users)
+{
+    Shape shape{2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto add = make_shared<op::Add>(A, B);
+    auto f = make_shared<Function>(make_shared<op::Multiply>(add, A), op::ParameterVector{A, B});
+    // g shares add with f, and must keep working after f is optimized
+    auto g = make_shared<Function>(make_shared<op::Abs>(make_shared<op::Negative>(add)),
+                                   op::ParameterVector{A, B});
+    auto dead = make_shared<op::Abs>(add);
+    ASSERT_EQ(add->get_users().size(), 3);
+
+    pass::DeadCodeElimination dce;
+    vector<shared_ptr<Function>> functions{f};
+    dce.run_on_module(functions);
+    EXPECT_EQ(add->get_users().size(), 3);
+
+    vector<vector<float>> args{{1, -2}, {3, -4}};
+    EXPECT_EQ((vector<float>{4, 6}), execute(g, args, "INTERPRETER").at(0));
+}
+
+TEST(benchmark, dead_code_elimination)
+{
+    // Training graphs built with autodiff while the adjoints, which also hold the adjoints of
+    // constants and of parameters nobody asked for, are still alive
+    for (const string model : {"mxnet/LSTM_forward.json",
+                               "mxnet/Seq2Seq_forward.json",
+                               "mxnet/Sockeye_Seq2Seq_forward.json"})
+    {
+        const string json_path = file_util::path_join(SERIALIZED_ZOO, model);
+        shared_ptr<Function> f = deserialize(file_util::read_file_to_string(json_path));
+        auto Y = f->get_results().at(0)->get_argument(0);
+        auto C = make_shared<op::Parameter>(Y->get_element_type(), Y->get_shape());
+        autodiff::Adjoints adjoints(NodeVector{Y}, NodeVector{C});
+        NodeVector outputs{Y};
+        for (auto X : f->get_parameters())
+        {
+            outputs.push_back(adjoints.backprop_node(X));
+        }
+        op::ParameterVector parameters = f->get_parameters();
+        parameters.push_back(C);
+        auto training = make_shared<Function>(outputs, parameters);
+
+        pass::DeadCodeElimination dce;
+        vector<shared_ptr<Function>> functions{training};
+        stopwatch timer;
+        timer.start();
+        dce.run_on_module(functions);
+        timer.stop();
+        cout << model << ": " << training->get_ordered_ops().size() << " ops, rewrote "
+             << dce.get_rewritten_node_count() << " nodes and removed "
+             << dce.get_removed_function_count() << " functions in "
+             << timer.get_milliseconds() << "ms\n";
+    }
+}
@@ -0,0 +1,159 @@
+/*******************************************************************************
+* Copyright 2017-2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "ngraph/file_util.hpp"
+#include "ngraph/model_container.hpp"
+
+using namespace ngraph;
+using namespace std;
+
+TEST(model_container, write_read)
+{
+    const string test_file = "test.ngmc";
+    string s1 = "this is a test";
+    string s2 = "the quick brown fox jumps over the lazy dog";
+    {
+        model_container::Writer writer(test_file, true);
+        writer.write("file1.txt", s1.data(), s1.size());
+        writer.write("file.txt", s2.data(), s2.size());
+    }
+    {
+        EXPECT_TRUE(model_container::is_model_container(test_file));
+        model_container::Reader reader(test_file);
+        auto blob_info = reader.get_blob_info();
+        ASSERT_EQ(2, blob_info.size());
+        EXPECT_EQ(blob_info[0].get_name(), "file1.txt");
+        EXPECT_EQ(blob_info[1].get_name(), "file.txt");
+        EXPECT_EQ(blob_info[0].get_size(), 14);
+        EXPECT_EQ(blob_info[1].get_size(), 43);
+        for (auto& info : blob_info)
+        {
+            EXPECT_EQ(info.get_offset() % model_container::alignment, 0);
+            EXPECT_TRUE(info.has_checksum());
+        }
+
+        string content(s2.size(), 0);
+        reader.read("file.txt", &content[0], content.size());
+        EXPECT_EQ(content, s2);
+        EXPECT_EQ(reader.find("file2.txt"), nullptr);
+    }
+    file_util::remove_file(test_file);
+}
+
+TEST(model_container, find)
+{
+    stringstream ss;
+    {
+        model_container::Writer writer(ss);
+        for (uint64_t i = 0; i < 1000; i++)
+        {
+            writer.write("blob_" + to_string(i), &i, sizeof(i));
+        }
+    }
+    model_container::Reader reader(ss);
+    ASSERT_EQ(reader.get_blob_info().size(), 1000);
+    for (uint64_t i = 0; i < 1000; i++)
+    {
+        const model_container::BlobInfo* info = reader.find("blob_" + to_string(i));
+        ASSERT_NE(info, nullptr);
+        EXPECT_FALSE(info->has_checksum());
+        uint64_t value;
+        reader.read(*info, &value);
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_EQ(reader.find("blob_1000"), nullptr);
+}
+
+TEST(model_container, checksum)
+{
+    stringstream ss;
+    vector<float> data{1, 2, 3, 4};
+    {
+        model_container::Writer writer(ss, true);
+        writer.write("data", data.data(), data.size() * sizeof(float));
+    }
+    string contents = ss.str();
+    stringstream corrupted;
+    {
+        model_container::Reader reader(ss);
+        const model_container::BlobInfo* info = reader.find("data");
+        ASSERT_NE(info, nullptr);
+        EXPECT_TRUE(model_container::verify(*info, data.data()));
+        contents[info->get_offset()] ^= 1;
+        corrupted.str(contents);
+    }
+    model_container::Reader reader(corrupted);
+    vector<float> result(data.size());
+    EXPECT_THROW(reader.read("data", result.data(), result.size() * sizeof(float)),
+                 runtime_error);
+}
+
+TEST(model_container, invalid)
+{
+    stringstream ss("not a model container");
+    EXPECT_FALSE(model_container::is_model_container(ss));
+    EXPECT_THROW(model_container::Reader reader(ss), runtime_error);
+}
+
+static uint64_t read_u64(const string& s, size_t offset)
+{
+    uint64_t rc = 0;
+    for (size_t i = 0; i < 8; i++)
+    {
+        rc |= static_cast<uint64_t>(static_cast<uint8_t>(s[offset + i])) << (8 * i);
+    }
+    return rc;
+}
+
+TEST(model_container, full_table)
+{
+    stringstream ss;
+    {
+        model_container::Writer writer(ss);
+        uint32_t value = 1;
+        writer.write("data", &value, sizeof(value));
+    }
+    // The footer, at the end of the file, starts with the table of contents offset, its
+    // size, the blob count and the bucket count. The 48 byte entries are followed by the
+    // buckets, which hold blob index + 1 or 0 for an empty bucket.
+    string contents = ss.str();
+    size_t footer = contents.size() - 64;
+    uint64_t toc_offset = read_u64(contents, footer);
+    ASSERT_EQ(read_u64(contents, footer + 16), 1);
+    ASSERT_EQ(read_u64(contents, footer + 24), 2);
+    size_t buckets = toc_offset + 48;
+
+    // Fill every bucket; lookups of missing names must still end
+    string full = contents;
+    full[buckets] = 1;
+    full[buckets + 4] = 1;
+    stringstream full_stream(full);
+    model_container::Reader reader(full_stream);
+    EXPECT_NE(reader.find("data"), nullptr);
+    EXPECT_EQ(reader.find("missing"), nullptr);
+    EXPECT_EQ(reader.find("another missing name"), nullptr);
+
+    // As many buckets as blobs leaves no room for an empty bucket
+    string no_empty_bucket = contents;
+    no_empty_bucket[footer + 24] = 1;
+    stringstream no_empty_bucket_stream(no_empty_bucket);
+    EXPECT_THROW(model_container::Reader no_empty_bucket_reader(no_empty_bucket_stream),
+                 runtime_error);
+}
@@ -23,6 +23,7 @@
 
 #include "ngraph/graph_util.hpp"
 #include "ngraph/ngraph.hpp"
+#include "ngraph/pass/cse.hpp"
 #include "ngraph/pass/manager.hpp"
 #include "util/test_tools.hpp"
 
@@ -59,3 +60,25 @@ TEST(pass_manager, module_add_function)
                                        make_shared<op::FunctionCall>(f, NodeVector{X, Y, Z}),
                                    op::ParameterVector{X, Y, Z});
 }
+
+TEST(pass_manager, pass_statistics)
+{
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>((A + B) * (A + B), op::ParameterVector{A, B});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::CommonSubexpressionElimination>();
+    pass_manager.register_pass<pass::CommonSubexpressionElimination>();
+    pass_manager.set_pass_timing(true);
+    pass_manager.run_passes(f);
+
+    auto& stats = pass_manager.get_pass_statistics();
+    ASSERT_EQ(stats.size(), 2);
+    EXPECT_EQ(stats.at(0).name, "ngraph::pass::CommonSubexpressionElimination");
+    EXPECT_EQ(stats.at(0).ops_before, 6);
+    EXPECT_EQ(stats.at(0).ops_after, 5);
+    EXPECT_EQ(stats.at(1).ops_before, 5);
+    EXPECT_EQ(stats.at(1).ops_after, 5);
+}
@@ -391,6 +391,51 @@ TEST(pattern, graph_rewrite)
     }
 }
 
+// abs(-x) -> abs(x)
+class AbsNegativeRewrite : public ngraph::pass::GraphRewrite
+{
+public:
+    AbsNegativeRewrite()
+        : GraphRewrite()
+    {
+        auto label = std::make_shared<pattern::op::Label>(element::i32, Shape{});
+        auto is_abs = [](std::shared_ptr<Node> n) {
+            return std::dynamic_pointer_cast<op::Abs>(n) != nullptr;
+        };
+        auto abs = std::make_shared<pattern::op::Any>(
+            element::i32, Shape{}, is_abs, NodeVector{std::make_shared<op::Negative>(label)});
+
+        auto callback = [label](pattern::Matcher& m) {
+            auto pattern_map = m.get_pattern_map();
+            ngraph::replace_node(m.get_match_root(),
+                                 std::make_shared<op::Abs>(pattern_map[label]));
+            return true;
+        };
+        this->add_matcher(make_shared<pattern::Matcher>(abs, callback));
+    }
+};
+
+TEST(pattern, graph_rewrite_single_sweep)
+{
+    Shape shape{};
+    auto a = make_shared<op::Parameter>(element::i32, shape);
+    auto neg_a = make_shared<op::Negative>(a);
+    auto graph = make_shared<op::Negative>(make_shared<op::Negative>(neg_a));
+    auto f = make_shared<Function>(make_shared<op::Abs>(graph), op::ParameterVector{a});
+
+    // Every rewrite creates an abs that matches again, which only the next run sees
+    for (size_t negatives : {2, 1, 0})
+    {
+        pass::Manager pass_manager;
+        pass_manager.register_pass<AbsNegativeRewrite>();
+        pass_manager.run_passes(f);
+        EXPECT_EQ(count_ops_of_type<op::Negative>(f), negatives);
+    }
+    auto abs = f->get_results().at(0)->get_argument(0);
+    ASSERT_TRUE(std::dynamic_pointer_cast<op::Abs>(abs));
+    ASSERT_EQ(abs->get_argument(0), a);
+}
+
 std::ostream& operator<<(std::ostream& os, const ngraph::NodeVector& nv)
 {
     std::vector<std::string> names;
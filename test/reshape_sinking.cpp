@@ -0,0 +1,149 @@
+/*******************************************************************************
+* Copyright 2017-2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <memory>
+#include <numeric>
+
+#include "gtest/gtest.h"
+#include "ngraph/graph_util.hpp"
+#include "ngraph/ngraph.hpp"
+#include "ngraph/pass/manager.hpp"
+#include "ngraph/pass/reshape_sinking.hpp"
+#include "util/all_close_f.hpp"
+#include "util/test_tools.hpp"
+
+using namespace ngraph;
+using namespace std;
+
+// Bytes copied by transposing Reshapes
+static size_t get_transpose_bytes(shared_ptr<Function> f)
+{
+    size_t bytes = 0;
+    for (auto node : f->get_ordered_ops())
+    {
+        auto reshape = dynamic_pointer_cast<op::Reshape>(node);
+        if (reshape && reshape->get_is_transpose())
+        {
+            bytes += shape_size(reshape->get_shape()) * reshape->get_element_type().size();
+        }
+    }
+    return bytes;
+}
+
+// Runs the pass on f and checks the results against the original graph
+static void run_and_compare(shared_ptr<Function> f)
+{
+    auto original = clone_function(*f);
+    vector<vector<float>> args;
+    for (auto parameter : f->get_parameters())
+    {
+        vector<float> data(shape_size(parameter->get_shape()));
+        iota(data.begin(), data.end(), args.size() + 1.0f);
+        args.push_back(data);
+    }
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::ReshapeSinking>();
+    pass_manager.run_passes(f);
+
+    EXPECT_EQ(execute(original, args, "INTERPRETER"), execute(f, args, "INTERPRETER"));
+}
+
+TEST(reshape_sinking, cancel_through_elementwise)
+{
+    Shape shape{2, 3, 4};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto ta = make_shared<op::Reshape>(A, AxisVector{2, 0, 1}, Shape{4, 2, 3});
+    auto tb = make_shared<op::Reshape>(B, AxisVector{2, 0, 1}, Shape{4, 2, 3});
+    auto sum = make_shared<op::Abs>(ta) + tb;
+    auto back = make_shared<op::Reshape>(sum, AxisVector{1, 2, 0}, shape);
+    auto f = make_shared<Function>(back, op::ParameterVector{A, B});
+
+    EXPECT_EQ(get_transpose_bytes(f), 3 * 24 * sizeof(float));
+    run_and_compare(f);
+    EXPECT_EQ(get_transpose_bytes(f), 0);
+    EXPECT_EQ(count_ops_of_type<op::Reshape>(f), 0);
+}
+
+TEST(reshape_sinking, broadcast_argument)
+{
+    Shape shape{2, 3, 4};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto bias = make_shared<op::Parameter>(element::f32, Shape{3});
+    auto ta = make_shared<op::Reshape>(A, AxisVector{0, 2, 1}, Shape{2, 4, 3});
+    auto add = ta + make_shared<op::Broadcast>(bias, Shape{2, 4, 3}, AxisSet{0, 1});
+    auto back = make_shared<op::Reshape>(add, AxisVector{0, 2, 1}, shape);
+    auto f = make_shared<Function>(back, op::ParameterVector{A, bias});
+
+    run_and_compare(f);
+    EXPECT_EQ(get_transpose_bytes(f), 0);
+}
+
+TEST(reshape_sinking, reduction)
+{
+    auto A = make_shared<op::Parameter>(element::f32, Shape{2, 3, 4});
+    auto ta = make_shared<op::Reshape>(A, AxisVector{2, 1, 0}, Shape{4, 3, 2});
+    auto sum = make_shared<op::Sum>(make_shared<op::Negative>(ta), AxisSet{1});
+    auto f = make_shared<Function>(sum, op::ParameterVector{A});
+
+    EXPECT_EQ(get_transpose_bytes(f), 24 * sizeof(float));
+    run_and_compare(f);
+    // The transpose is applied to the reduced tensor
+    EXPECT_EQ(get_transpose_bytes(f), 8 * sizeof(float));
+}
+
+TEST(reshape_sinking, shared_transpose)
+{
+    Shape shape{2, 3};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto ta = make_shared<op::Reshape>(A, AxisVector{1, 0}, Shape{3, 2});
+    auto abs = make_shared<op::Abs>(ta);
+    auto neg = make_shared<op::Negative>(ta);
+    auto f = make_shared<Function>(NodeVector{abs, neg}, op::ParameterVector{A});
+
+    run_and_compare(f);
+    EXPECT_EQ(get_transpose_bytes(f), 6 * sizeof(float));
+}
+
+TEST(reshape_sinking, softmax_axes)
+{
+    Shape shape{2, 3, 4};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto ta = make_shared<op::Reshape>(A, AxisVector{2, 0, 1}, Shape{4, 2, 3});
+    auto softmax = make_shared<op::Softmax>(ta, AxisSet{0});
+    auto f = make_shared<Function>(softmax, op::ParameterVector{A});
+    auto original = clone_function(*f);
+
+    vector<float> data(shape_size(shape));
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = (i % 7) * 0.25f;
+    }
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::ReshapeSinking>();
+    pass_manager.run_passes(f);
+
+    // The softmax now runs on A, over the axis the transpose moved to the front
+    auto reshape = f->get_results().at(0)->get_argument(0);
+    auto sunk = dynamic_pointer_cast<op::Softmax>(reshape->get_argument(0));
+    ASSERT_TRUE(sunk);
+    EXPECT_EQ(sunk->get_argument(0), A);
+    EXPECT_EQ(sunk->get_axes(), AxisSet{2});
+    vector<vector<float>> args{data};
+    EXPECT_TRUE(test::all_close_f(execute(original, args, "INTERPRETER").at(0),
+                                  execute(f, args, "INTERPRETER").at(0)));
+}
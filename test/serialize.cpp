@@ -20,6 +20,7 @@
 #include "gtest/gtest.h"
 
 #include "ngraph/file_util.hpp"
+#include "ngraph/model_container.hpp"
 #include "ngraph/ngraph.hpp"
 #include "ngraph/serializer.hpp"
 #include "ngraph/util.hpp"
@@ -120,6 +121,29 @@ TEST(serialize, existing_models)
     }
 }
 
+TEST(serialize, streaming_format)
+{
+    // The incrementally written json matches a dump of the whole document
+    const string json_path = file_util::path_join(SERIALIZED_ZOO, "mxnet/LSTM_forward.json");
+    shared_ptr<Function> f = ngraph::deserialize(file_util::read_file_to_string(json_path));
+
+    string compact = serialize(f);
+    EXPECT_EQ(json::parse(compact).dump(), compact);
+    string formatted = serialize(f, 4);
+    EXPECT_EQ(json::parse(formatted).dump(4), formatted);
+
+    istringstream in(formatted);
+    shared_ptr<Function> g = deserialize(in);
+    ASSERT_NE(g, nullptr);
+    EXPECT_EQ(g->get_ops().size(), f->get_ops().size());
+}
+
+TEST(serialize, streaming_errors)
+{
+    EXPECT_THROW(deserialize("[{\"name\": \"f\", \"ops\": ["), ngraph_error);
+    EXPECT_THROW(deserialize("[{\"name\" \"f\"}]"), ngraph_error);
+}
+
 TEST(serialize, default_value)
 {
     json j = {{"test1", 1}, {"test2", 2}};
@@ -158,6 +182,179 @@ TEST(serialize, constant)
     EXPECT_TRUE(found);
 }
 
+TEST(serialize, constant_checksums)
+{
+    auto A = op::Constant::create(element::f32, Shape{4}, {1, 2, 3, 4});
+    auto f = make_shared<Function>(A, op::ParameterVector{});
+
+    for (bool checksums : {false, true})
+    {
+        stringstream ss;
+        serialize(ss, f, 0, checksums);
+        string contents = ss.str();
+        model_container::Reader reader(ss);
+        const model_container::BlobInfo* info = reader.find(A->get_name());
+        ASSERT_NE(info, nullptr);
+        EXPECT_EQ(info->has_checksum(), checksums);
+
+        // Blobs are verified on load only if they have a checksum
+        contents[info->get_offset()] ^= 1;
+        stringstream corrupted(contents);
+        if (checksums)
+        {
+            EXPECT_THROW(deserialize(corrupted), runtime_error);
+        }
+        else
+        {
+            EXPECT_NE(deserialize(corrupted), nullptr);
+        }
+    }
+}
+
+TEST(serialize, deserialize_mmap)
+{
+    const string tmp_file = "serialize_mmap.cpio";
+    auto A = op::Constant::create(element::f32, Shape{2, 2}, {1, 2, 3, 4});
+    auto B = op::Constant::create(element::f64, Shape{3}, {5, 6, 7});
+    auto C = op::Constant::create(element::i8, Shape{3}, {8, 9, 10});
+    auto X = make_shared<op::Parameter>(element::f32, Shape{2, 2});
+    auto f = make_shared<Function>(NodeVector{A + X, B, C}, op::ParameterVector{X});
+    serialize(tmp_file, f);
+
+    shared_ptr<op::Constant> copy;
+    {
+        auto g = deserialize_mmap(tmp_file);
+        ASSERT_NE(g, nullptr);
+        size_t count = 0;
+        for (shared_ptr<Node> node : g->get_ops())
+        {
+            if (auto c = dynamic_pointer_cast<op::Constant>(node))
+            {
+                count++;
+                EXPECT_FALSE(c->owns_data());
+                EXPECT_EQ(reinterpret_cast<uintptr_t>(c->get_data_ptr()) % 64, 0);
+                if (c->get_element_type() == element::f32)
+                {
+                    EXPECT_EQ((vector<float>{1, 2, 3, 4}), c->get_vector<float>());
+                    copy = dynamic_pointer_cast<op::Constant>(c->copy_with_new_args({}));
+                }
+                else if (c->get_element_type() == element::f64)
+                {
+                    EXPECT_EQ((vector<double>{5, 6, 7}), c->get_vector<double>());
+                }
+                else
+                {
+                    EXPECT_EQ((vector<int8_t>{8, 9, 10}), c->get_vector<int8_t>());
+                }
+            }
+        }
+        EXPECT_EQ(count, 3);
+    }
+    file_util::remove_file(tmp_file);
+
+    // The copy shares the mapping, which outlives the deserialized function
+    ASSERT_NE(copy, nullptr);
+    EXPECT_FALSE(copy->owns_data());
+    EXPECT_EQ((vector<float>{1, 2, 3, 4}), copy->get_vector<float>());
+}
+
+TEST(serialize, constant_encoding)
+{
+    auto A = op::Constant::create(element::f32, Shape{3}, {0.1f, 1.23456789f, -3e-20f});
+    auto B = op::Constant::create(element::i64, Shape{2}, vector<int64_t>{int64_t{1} << 60, -7});
+    auto C = op::Constant::create(element::boolean, Shape{1}, {1});
+    auto f = make_shared<Function>(NodeVector{A, B, C}, op::ParameterVector{});
+
+    // Literal strings unless base64 is asked for, so older readers can load the json
+    string strings = serialize(f);
+    EXPECT_NE(strings.find("\"value\""), string::npos);
+    EXPECT_EQ(strings.find("value_base64"), string::npos);
+    string js = serialize(f, 0, true);
+    EXPECT_NE(js.find("value_base64"), string::npos);
+    EXPECT_EQ(js.find("\"value\""), string::npos);
+
+    // base64 is exact where the literal strings round to six digits
+    auto g = deserialize(js);
+    size_t count = 0;
+    for (shared_ptr<Node> node : g->get_ordered_ops())
+    {
+        if (auto c = dynamic_pointer_cast<op::Constant>(node))
+        {
+            count++;
+            EXPECT_TRUE(c->is_decoded());
+            if (c->get_element_type() == element::f32)
+            {
+                EXPECT_EQ(c->get_vector<float>(), A->get_vector<float>());
+            }
+            else if (c->get_element_type() == element::i64)
+            {
+                EXPECT_EQ(c->get_vector<int64_t>(), B->get_vector<int64_t>());
+            }
+            else
+            {
+                EXPECT_EQ(c->get_vector<char>(), C->get_vector<char>());
+            }
+        }
+    }
+    EXPECT_EQ(count, 3);
+}
+
+TEST(serialize, lazy_constants)
+{
+    auto A = op::Constant::create(element::f32, Shape{2, 2}, {1, 2, 3, 4});
+    auto X = make_shared<op::Parameter>(element::f32, Shape{2, 2});
+    auto f = make_shared<Function>(A + X, op::ParameterVector{X});
+    string js = serialize(f);
+
+    auto g = deserialize(js, true);
+
+    shared_ptr<op::Constant> c;
+    for (shared_ptr<Node> node : g->get_ops())
+    {
+        if (auto constant = dynamic_pointer_cast<op::Constant>(node))
+        {
+            c = constant;
+        }
+    }
+    ASSERT_NE(c, nullptr);
+    EXPECT_FALSE(c->is_decoded());
+    auto copy = dynamic_pointer_cast<op::Constant>(c->copy_with_new_args({}));
+    EXPECT_FALSE(copy->is_decoded());
+    EXPECT_FALSE(c->is_decoded());
+
+    EXPECT_EQ((vector<float>{1, 2, 3, 4}), copy->get_vector<float>());
+    EXPECT_TRUE(copy->is_decoded());
+    EXPECT_TRUE(c->is_decoded());
+}
+
+TEST(serialize, hash_function)
+{
+    auto make_f = [](const Shape& shape, const AxisSet& axes, float value, bool swap) {
+        auto A = make_shared<op::Parameter>(element::f32, shape);
+        auto B = make_shared<op::Parameter>(element::f32, shape);
+        auto C = op::Constant::create(element::f32, shape, vector<float>{value});
+        auto D = swap ? B - A : A - B;
+        return make_shared<Function>(make_shared<op::Sum>(D * C, axes),
+                                     op::ParameterVector{A, B});
+    };
+    auto f = make_f(Shape{2, 3}, AxisSet{0}, 1, false);
+
+    // Built separately, with different node names
+    EXPECT_EQ(hash_function(f), hash_function(make_f(Shape{2, 3}, AxisSet{0}, 1, false)));
+    EXPECT_EQ(hash_function(f, true),
+              hash_function(make_f(Shape{2, 3}, AxisSet{0}, 1, false), true));
+    EXPECT_EQ(hash_function(f, true), hash_function(deserialize(serialize(f)), true));
+
+    EXPECT_NE(hash_function(f), hash_function(make_f(Shape{3, 2}, AxisSet{0}, 1, false)));
+    EXPECT_NE(hash_function(f), hash_function(make_f(Shape{2, 3}, AxisSet{1}, 1, false)));
+    EXPECT_NE(hash_function(f), hash_function(make_f(Shape{2, 3}, AxisSet{0}, 1, true)));
+
+    // Constant data only counts when asked for
+    auto g = make_f(Shape{2, 3}, AxisSet{0}, 2, false);
+    EXPECT_EQ(hash_function(f), hash_function(g));
+    EXPECT_NE(hash_function(f, true), hash_function(g, true));
+}
+
 TEST(benchmark, serialize)
 {
     stopwatch timer;
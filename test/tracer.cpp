@@ -0,0 +1,164 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <atomic>
+#include <sstream>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "ngraph/runtime/tracer.hpp"
+#include "nlohmann/json.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+// Events of the given function in a written trace
+static vector<nlohmann::json> get_events(runtime::Tracer& tracer, uint32_t function_id)
+{
+    stringstream ss;
+    tracer.write(ss);
+    nlohmann::json trace = nlohmann::json::parse(ss.str());
+    vector<nlohmann::json> rc;
+    for (const nlohmann::json& event : trace.at("traceEvents"))
+    {
+        if (event.at("ph") == "X" && event.at("pid") == function_id)
+        {
+            rc.push_back(event);
+        }
+    }
+    return rc;
+}
+
+TEST(tracer, write_chrome_trace)
+{
+    runtime::Tracer& tracer = runtime::Tracer::get();
+    uint32_t function_id = tracer.add_function(
+        "traced_function", {{"Add", {{"Input1", "a"}, {"Input2", "b"}}}, {"Negative", {}}});
+
+    uint64_t call_id = tracer.next_call_id();
+    int64_t start = runtime::Tracer::now();
+    tracer.record(function_id, 0, call_id, start);
+    thread worker([&]() { tracer.record(function_id, 1, call_id, runtime::Tracer::now()); });
+    worker.join();
+
+    vector<nlohmann::json> events = get_events(tracer, function_id);
+    ASSERT_EQ(events.size(), 2);
+    for (const nlohmann::json& event : events)
+    {
+        EXPECT_EQ(event.at("args").at("call"), call_id);
+        EXPECT_GE(event.at("dur").get<double>(), 0);
+    }
+    EXPECT_EQ(events[0].at("name"), "Add");
+    EXPECT_EQ(events[0].at("args").at("Input2"), "b");
+    EXPECT_DOUBLE_EQ(events[0].at("ts").get<double>(), start / 1000.0);
+    EXPECT_EQ(events[1].at("name"), "Negative");
+    EXPECT_NE(events[0].at("tid"), events[1].at("tid"));
+
+    // Written events are removed
+    EXPECT_TRUE(get_events(tracer, function_id).empty());
+}
+
+TEST(tracer, ring_buffer_keeps_latest)
+{
+    runtime::Tracer& tracer = runtime::Tracer::get();
+    uint32_t function_id = tracer.add_function("ring_buffer", {{"Op", {}}});
+    size_t buffer_size = tracer.get_buffer_size();
+    tracer.set_buffer_size(3);
+    EXPECT_EQ(tracer.get_buffer_size(), 4);
+
+    // The buffer size applies to threads that have not recorded yet
+    thread worker([&]() {
+        for (size_t i = 0; i < 10; i++)
+        {
+            tracer.record(function_id, 0, tracer.next_call_id(), runtime::Tracer::now());
+        }
+    });
+    worker.join();
+    tracer.set_buffer_size(buffer_size);
+
+    vector<nlohmann::json> events = get_events(tracer, function_id);
+    ASSERT_EQ(events.size(), 4);
+    for (size_t i = 1; i < events.size(); i++)
+    {
+        EXPECT_EQ(events[i].at("args").at("call").get<uint64_t>(),
+                  events[i - 1].at("args").at("call").get<uint64_t>() + 1);
+    }
+}
+
+TEST(tracer, exited_threads_keep_latest)
+{
+    runtime::Tracer& tracer = runtime::Tracer::get();
+    uint32_t function_id = tracer.add_function("exited_threads", {{"Op", {}}});
+    size_t buffer_size = tracer.get_buffer_size();
+    tracer.set_buffer_size(4);
+
+    // The buffers of exited threads are freed and at most 4 of their events kept
+    for (size_t t = 0; t < 3; t++)
+    {
+        thread worker([&]() {
+            for (size_t i = 0; i < 3; i++)
+            {
+                tracer.record(function_id, 0, tracer.next_call_id(), runtime::Tracer::now());
+            }
+        });
+        worker.join();
+    }
+    tracer.set_buffer_size(buffer_size);
+
+    vector<nlohmann::json> events = get_events(tracer, function_id);
+    ASSERT_EQ(events.size(), 4);
+    for (size_t i = 1; i < events.size(); i++)
+    {
+        EXPECT_EQ(events[i].at("args").at("call").get<uint64_t>(),
+                  events[i - 1].at("args").at("call").get<uint64_t>() + 1);
+    }
+    EXPECT_NE(events.front().at("tid"), events.back().at("tid"));
+}
+
+TEST(tracer, write_while_recording)
+{
+    runtime::Tracer& tracer = runtime::Tracer::get();
+    uint32_t function_id = tracer.add_function("write_while_recording", {{"Op", {}}});
+    size_t buffer_size = tracer.get_buffer_size();
+    tracer.set_buffer_size(16);
+
+    // Events read while their slots are reused are dropped rather than torn
+    atomic<bool> done(false);
+    thread worker([&]() {
+        while (!done)
+        {
+            uint64_t call_id = tracer.next_call_id();
+            tracer.record(function_id, 0, call_id, static_cast<int64_t>(call_id));
+        }
+    });
+    size_t events = 0;
+    for (size_t i = 0; i < 100000 && events < 1000; i++)
+    {
+        this_thread::yield();
+        for (const nlohmann::json& event : get_events(tracer, function_id))
+        {
+            EXPECT_DOUBLE_EQ(event.at("ts").get<double>(),
+                             event.at("args").at("call").get<uint64_t>() / 1000.0);
+            events++;
+        }
+    }
+    done = true;
+    worker.join();
+    tracer.set_buffer_size(buffer_size);
+    get_events(tracer, function_id);
+    EXPECT_GT(events, 0);
+}
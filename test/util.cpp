@@ -14,6 +14,7 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <cstring>
 #include <fstream>
 #include <sstream>
 #include <string>
@@ -25,6 +26,9 @@
 #include "ngraph/function.hpp"
 #include "ngraph/graph_util.hpp"
 #include "ngraph/ngraph.hpp"
+#include "ngraph/runtime/aligned_buffer.hpp"
+#include "ngraph/runtime/performance_counter.hpp"
+#include "ngraph/runtime/thread_affinity.hpp"
 #include "ngraph/serializer.hpp"
 #include "util/all_close.hpp"
 #include "util/ndarray.hpp"
@@ -308,6 +312,26 @@ TEST(util, round_up)
     EXPECT_EQ(8, round_up(5, 4));
 }
 
+TEST(util, aligned_buffer_numa)
+{
+    // Node 0 exists on every Linux host; binding may still be refused in containers, in
+    // which case the buffer falls back to unbound memory
+    for (int numa_node : {-1, 0})
+    {
+        runtime::AlignedBuffer buffer(1000, 64, numa_node);
+        EXPECT_EQ(buffer.size(), 1000);
+        EXPECT_EQ(size_t(buffer.get_ptr()) % 64, 0);
+        EXPECT_TRUE(buffer.get_numa_node() == numa_node || buffer.get_numa_node() == -1);
+        memset(buffer.get_ptr(), 1, buffer.size());
+        EXPECT_EQ(static_cast<char*>(buffer.get_ptr())[999], 1);
+    }
+
+    // No host has this node, so the memory is mapped but not bound
+    runtime::AlignedBuffer unbound(1000, 64, 1023);
+    EXPECT_EQ(unbound.get_numa_node(), -1);
+    memset(unbound.get_ptr(), 1, unbound.size());
+}
+
 TEST(util, parse_string)
 {
     EXPECT_FLOAT_EQ(2, parse_string<float>("2"));
@@ -365,3 +389,98 @@ TEST(graph_util, get_subgraph_outputs_trivial_tests)
     outputs = ngraph::get_subgraph_outputs(NodeVector{B, abs_b, abs_b_neg}, NodeVector{});
     ASSERT_EQ(outputs, (NodeVector{B, abs_b_neg}));
 }
+
+TEST(graph_util, replace_node_records_replaced_nodes)
+{
+    auto A = make_shared<op::Parameter>(element::f32, Shape{2, 3});
+    auto B = make_shared<op::Parameter>(element::f32, Shape{3, 4});
+    auto C = make_shared<op::Parameter>(element::f32, Shape{2, 4});
+    auto dot = make_shared<op::Dot>(A, B);
+    auto add = make_shared<op::Add>(dot, C);
+    auto neg = make_shared<op::Negative>(add);
+
+    // Nothing is recorded unless asked for
+    auto sum = make_shared<op::Add>(C, C);
+    auto sum_user = make_shared<op::Negative>(sum);
+    auto unrecorded = make_shared<op::Subtract>(C, C);
+    replace_node(sum, unrecorded);
+    EXPECT_TRUE(unrecorded->get_replaced_nodes().empty());
+
+    ReplacedNodeRecording recording;
+    // The dot is dead once the add is replaced, so a new node takes over both
+    auto fused = make_shared<op::Maximum>(C, C);
+    replace_node(add, fused);
+    ASSERT_EQ(fused->get_replaced_nodes().size(), 2);
+    EXPECT_EQ(fused->get_replaced_nodes().count(add->get_name()), 1);
+    EXPECT_EQ(fused->get_replaced_nodes().at(dot->get_name()).flops, 2 * 2 * 3 * 4);
+
+    // Replacing a replacement passes on the original ops
+    auto refused = make_shared<op::Minimum>(C, C);
+    replace_node(fused, refused);
+    ASSERT_EQ(refused->get_replaced_nodes().size(), 2);
+    EXPECT_EQ(refused->get_replaced_nodes().count(add->get_name()), 1);
+    EXPECT_EQ(refused->get_replaced_nodes().count(dot->get_name()), 1);
+
+    // An existing node takes over nothing
+    replace_node(refused, C);
+    EXPECT_TRUE(C->get_replaced_nodes().empty());
+    EXPECT_TRUE(neg->get_arguments().at(0) == C);
+}
+
+TEST(util, attribute_to_replaced_nodes)
+{
+    Cost large;
+    large.flops = 24;
+    Cost small;
+    small.bytes_read = 4;
+    small.bytes_written = 4;
+    runtime::PerformanceCounter fused("Fused_1", 100, 2);
+    fused.set_replaced_nodes({{"Dot_1", large}, {"Add_2", small}});
+    runtime::PerformanceCounter plain("Negative_3", 10, 2);
+
+    auto counters = runtime::attribute_to_replaced_nodes({fused, plain});
+    ASSERT_EQ(counters.size(), 3);
+    // Names are ordered and work is weighted as FLOPs plus bytes
+    EXPECT_EQ(counters[0].name(), "Add_2");
+    EXPECT_EQ(counters[0].total_microseconds(), 25);
+    EXPECT_EQ(counters[0].bytes_read(), 4);
+    EXPECT_EQ(counters[1].name(), "Dot_1");
+    EXPECT_EQ(counters[1].total_microseconds(), 75);
+    EXPECT_EQ(counters[1].flops(), 24);
+    EXPECT_EQ(counters[1].call_count(), 2);
+    EXPECT_EQ(counters[2].name(), "Negative_3");
+    EXPECT_EQ(counters[2].total_microseconds(), 10);
+}
+
+TEST(util, parse_cpu_list)
+{
+    EXPECT_EQ(runtime::parse_cpu_list("0-3,8,10-11"), (vector<int>{0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(runtime::parse_cpu_list("5,"), vector<int>{5});
+    EXPECT_TRUE(runtime::parse_cpu_list("").empty());
+    EXPECT_THROW(runtime::parse_cpu_list("0-x"), ngraph_error);
+}
+
+TEST(util, scoped_affinity)
+{
+    cpu_set_t before;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(before), &before), 0);
+    int core = 0;
+    while (!CPU_ISSET(core, &before))
+    {
+        core++;
+    }
+    {
+        runtime::ScopedAffinity affinity({core});
+        EXPECT_TRUE(affinity.is_applied());
+        cpu_set_t during;
+        ASSERT_EQ(sched_getaffinity(0, sizeof(during), &during), 0);
+        EXPECT_EQ(CPU_COUNT(&during), 1);
+        EXPECT_TRUE(CPU_ISSET(core, &during));
+    }
+    cpu_set_t after;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(after), &after), 0);
+    EXPECT_TRUE(CPU_EQUAL(&before, &after));
+
+    runtime::ScopedAffinity invalid({-1});
+    EXPECT_FALSE(invalid.is_applied());
+}